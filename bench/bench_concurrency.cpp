@@ -0,0 +1,366 @@
+/**
+ * @file bench_concurrency.cpp
+ * @brief Benchmarks of the concurrent task store and the mutation queue against a single locked TaskManager.
+ *
+ * Every iteration starts its own worker threads and times them with the wall
+ * clock, from the first operation to the last thread joining. After each
+ * iteration the store is checked for lost or duplicated updates, and the
+ * benchmark is failed if the count of tasks does not add up.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "bench_data.hpp"
+#include "concurrent_task_manager.hpp"
+#include "task_mutation_queue.hpp"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Thread counts the concurrent benchmarks run with.
+ */
+static constexpr int BENCH_THREAD_COUNTS[] = {1, 2, 4, 8, 16, 32, 64};
+
+/**
+ * @brief Number of tasks in the store before a mixed workload starts.
+ */
+static constexpr std::size_t BENCH_PREFILL_TASKS = 10000;
+
+/**
+ * @brief Number of operations per iteration, shared among the threads.
+ */
+static constexpr std::size_t BENCH_CONCURRENT_OPS = 1 << 17;
+
+/**
+ * @class LockedTaskManager
+ * @brief TaskManager behind one mutex, the baseline of the concurrent benchmarks.
+ */
+class LockedTaskManager
+{
+private:
+    TaskManager Manager;        /**< Guarded task manager. */
+    mutable std::mutex Lock;    /**< Guards Manager. */
+
+public:
+    /**
+     * @brief Adds a task.
+     *
+     * @param title Title of the task.
+     * @param desc Description of the task.
+     * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+     * @param Priority Priority level of the task.
+     * @return ID of the new task.
+     */
+    int addTask(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority)
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return Manager.addTask(title, desc, DueDay, Priority);
+    }
+
+    /**
+     * @brief Removes a task.
+     *
+     * @param id ID of the task.
+     * @return true if the task was removed.
+     */
+    bool removeTask(int id)
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return Manager.removeTask(id);
+    }
+
+    /**
+     * @brief Changes the status of a task.
+     *
+     * @param id ID of the task.
+     * @param state New status.
+     * @return true if the task exists.
+     */
+    bool setStatus(int id, TaskState state)
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return Manager.setStatus(id, state);
+    }
+
+    /**
+     * @brief Copies a task.
+     *
+     * @param id ID of the task.
+     * @param Out Receives the task.
+     * @return true if the task exists.
+     */
+    bool bGetTask(int id, Task &Out) const
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        const Task *task = Manager.findTask(id);
+        if (task == nullptr)
+        {
+            return false;
+        }
+        Out = *task;
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of tasks.
+     *
+     * @return Number of tasks.
+     */
+    std::size_t size(void) const
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return Manager.size();
+    }
+
+    /**
+     * @brief Counts the tasks matching a filter.
+     *
+     * @param Filter Conditions to meet.
+     * @return Number of matching tasks.
+     */
+    std::size_t u64Count(const TaskFilter &Filter) const
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        return Manager.Query(Filter).size();
+    }
+};
+
+/**
+ * @brief Counts the tasks of a concurrent store matching a filter.
+ *
+ * @param manager Store to query.
+ * @param Filter Conditions to meet.
+ * @return Number of matching tasks.
+ */
+static std::size_t u64Count(const ConcurrentTaskManager &manager, const TaskFilter &Filter)
+{
+    return manager.Query(Filter).size();
+}
+
+/**
+ * @brief Counts the tasks of a locked task manager matching a filter.
+ *
+ * @param manager Task manager to query.
+ * @param Filter Conditions to meet.
+ * @return Number of matching tasks.
+ */
+static std::size_t u64Count(const LockedTaskManager &manager, const TaskFilter &Filter)
+{
+    return manager.u64Count(Filter);
+}
+
+/**
+ * @brief Runs the mixed workload of one thread.
+ *
+ * Half of the operations add a task, three in ten read a random task, one in
+ * ten changes the status of a random task and one in ten removes a task the
+ * thread added itself, so removals never race with each other.
+ *
+ * @param manager Store under test.
+ * @param Seed Seed of the thread's generator.
+ * @param Operations Number of operations to run.
+ * @param Adds Incremented by the number of tasks added.
+ * @param Removes Incremented by the number of tasks removed.
+ */
+template <typename Store>
+static void vidRunMixedOps(Store &manager, std::uint64_t Seed, std::size_t Operations, std::atomic<std::size_t> &Adds,
+                           std::atomic<std::size_t> &Removes)
+{
+    TaskGenerator Generator(Seed);
+    SyntheticTask Input;
+    Generator.vidNext(Input);
+    std::vector<int> Own;
+    Task Copy;
+    std::size_t Added = 0;
+    std::size_t Removed = 0;
+    for (std::size_t Index = 0; Index < Operations; ++Index)
+    {
+        std::size_t Choice = Generator.u64Below(10);
+        int id = static_cast<int>(Generator.u64Below(BENCH_PREFILL_TASKS)) + 1;
+        if (Choice < 5)
+        {
+            Own.push_back(manager.addTask(Input.Title, Input.Description, Input.DueDay, Input.Priority));
+            ++Added;
+        }
+        else if (Choice < 8)
+        {
+            benchmark::DoNotOptimize(manager.bGetTask(id, Copy));
+        }
+        else if (Choice < 9)
+        {
+            manager.setStatus(id, (Index % 2 == 0) ? TaskState::Done : TaskState::Pending);
+        }
+        else if (Own.empty() == false)
+        {
+            if (manager.removeTask(Own.back()) == true)
+            {
+                ++Removed;
+            }
+            Own.pop_back();
+        }
+    }
+    Adds += Added;
+    Removes += Removed;
+}
+
+/**
+ * @brief Runs the mixed workload on a store from several threads.
+ *
+ * @param state Benchmark state; range 0 is the thread count.
+ */
+template <typename Store>
+static void BM_MixedOps(benchmark::State &state)
+{
+    std::size_t Threads = static_cast<std::size_t>(state.range(0));
+    std::size_t PerThread = BENCH_CONCURRENT_OPS / Threads;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = std::make_unique<Store>();
+        TaskGenerator Generator;
+        SyntheticTask Input;
+        for (std::size_t Index = 0; Index < BENCH_PREFILL_TASKS; ++Index)
+        {
+            Generator.vidNext(Input);
+            manager->addTask(Input.Title, Input.Description, Input.DueDay, Input.Priority);
+        }
+        std::atomic<std::size_t> Adds{0};
+        std::atomic<std::size_t> Removes{0};
+        std::vector<std::thread> Workers;
+        Workers.reserve(Threads);
+        state.ResumeTiming();
+        for (std::size_t Index = 0; Index < Threads; ++Index)
+        {
+            Workers.emplace_back([&, Index]() { vidRunMixedOps(*manager, Index + 10, PerThread, Adds, Removes); });
+        }
+        for (std::thread &Worker : Workers)
+        {
+            Worker.join();
+        }
+        state.PauseTiming();
+        std::size_t Expected = BENCH_PREFILL_TASKS + Adds.load() - Removes.load();
+        if (manager->size() != Expected || u64Count(*manager, TaskFilter()) != Expected)
+        {
+            state.SkipWithError("Task Count Does Not Add Up After Concurrent Updates");
+        }
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(PerThread * Threads));
+}
+
+/**
+ * @brief Adds tasks to a locked task manager from several threads.
+ *
+ * @param state Benchmark state; range 0 is the thread count.
+ */
+static void BM_MutexAddTask(benchmark::State &state)
+{
+    std::size_t Threads = static_cast<std::size_t>(state.range(0));
+    std::size_t PerThread = BENCH_CONCURRENT_OPS / Threads;
+    SyntheticTask Input;
+    TaskGenerator().vidNext(Input);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = std::make_unique<LockedTaskManager>();
+        std::vector<std::thread> Workers;
+        Workers.reserve(Threads);
+        state.ResumeTiming();
+        for (std::size_t Index = 0; Index < Threads; ++Index)
+        {
+            Workers.emplace_back(
+                [&]()
+                {
+                    for (std::size_t Count = 0; Count < PerThread; ++Count)
+                    {
+                        manager->addTask(Input.Title, Input.Description, Input.DueDay, Input.Priority);
+                    }
+                });
+        }
+        for (std::thread &Worker : Workers)
+        {
+            Worker.join();
+        }
+        state.PauseTiming();
+        if (manager->size() != PerThread * Threads)
+        {
+            state.SkipWithError("Task Count Does Not Add Up After Concurrent Adds");
+        }
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(PerThread * Threads));
+}
+
+/**
+ * @brief Adds tasks through the mutation queue from several threads.
+ *
+ * The time includes draining the queue, so it covers every task being
+ * applied, not only queued.
+ *
+ * @param state Benchmark state; range 0 is the thread count.
+ */
+static void BM_QueueAddTask(benchmark::State &state)
+{
+    std::size_t Threads = static_cast<std::size_t>(state.range(0));
+    std::size_t PerThread = BENCH_CONCURRENT_OPS / Threads;
+    SyntheticTask Input;
+    TaskGenerator().vidNext(Input);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = std::make_unique<TaskManager>();
+        auto Queue = std::make_unique<TaskMutationQueue>(*manager);
+        std::vector<std::thread> Workers;
+        Workers.reserve(Threads);
+        state.ResumeTiming();
+        for (std::size_t Index = 0; Index < Threads; ++Index)
+        {
+            Workers.emplace_back(
+                [&]()
+                {
+                    for (std::size_t Count = 0; Count < PerThread; ++Count)
+                    {
+                        Queue->bSubmitAdd(Input.Title, Input.Description, Input.DueDay, Input.Priority);
+                    }
+                });
+        }
+        for (std::thread &Worker : Workers)
+        {
+            Worker.join();
+        }
+        Queue->vidStop();
+        state.PauseTiming();
+        if (manager->size() != PerThread * Threads)
+        {
+            state.SkipWithError("Task Count Does Not Add Up After Queued Adds");
+        }
+        Queue.reset();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(PerThread * Threads));
+}
+
+/**
+ * @brief Registers the concurrent store and mutation queue benchmarks.
+ */
+void vidRegisterConcurrencyBenchmarks(void)
+{
+    for (int Threads : BENCH_THREAD_COUNTS)
+    {
+        benchmark::RegisterBenchmark("Concurrent/MixedOps/Sharded", BM_MixedOps<ConcurrentTaskManager>)
+            ->Arg(Threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Concurrent/MixedOps/Mutex", BM_MixedOps<LockedTaskManager>)
+            ->Arg(Threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Ingest/MutexAddTask", BM_MutexAddTask)
+            ->Arg(Threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Ingest/QueueAddTask", BM_QueueAddTask)
+            ->Arg(Threads)->UseRealTime()->Unit(benchmark::kMillisecond);
+    }
+}
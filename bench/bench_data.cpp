@@ -0,0 +1,270 @@
+/**
+ * @file bench_data.cpp
+ * @brief Implementation of the synthetic task sets and helpers shared by the benchmarks.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "bench_data.hpp"
+#include <array>
+#include <filesystem>
+
+/**
+ * @brief Number of distinct words titles and descriptions are made of.
+ */
+static constexpr std::size_t BENCH_VOCABULARY_SIZE = 1024;
+
+/**
+ * @brief Number of days over which due dates are spread.
+ */
+static constexpr std::size_t BENCH_DUE_SPAN = 730;
+
+/**
+ * @brief Builds the vocabulary from pairs and triples of syllables.
+ *
+ * @return Words, the most frequent first.
+ */
+static std::vector<std::string> BuildVocabulary(void)
+{
+    static const std::array<const char *, 16> Syllables = {"ka", "lo", "mi", "ne", "ra", "so", "tu", "vi",
+                                                           "ba", "de", "fo", "gu", "ha", "ji", "pe", "zo"};
+    std::vector<std::string> Words;
+    Words.reserve(BENCH_VOCABULARY_SIZE);
+    for (std::size_t Index = 0; Words.size() < BENCH_VOCABULARY_SIZE; ++Index)
+    {
+        std::string Word = Syllables[Index % 16];
+        Word += Syllables[(Index / 16) % 16];
+        if (Index >= 256)
+        {
+            Word += Syllables[(Index / 256) % 16];
+        }
+        Words.push_back(std::move(Word));
+    }
+    return Words;
+}
+
+/**
+ * @brief Gets the vocabulary.
+ *
+ * @return Words, built once.
+ */
+static const std::vector<std::string> &GetVocabulary(void)
+{
+    static const std::vector<std::string> Words = BuildVocabulary();
+    return Words;
+}
+
+/**
+ * @brief Gets the first due day of generated tasks.
+ *
+ * @return Day number of 2025-01-01.
+ */
+static std::int32_t int32GetFirstDueDay(void)
+{
+    static const std::int32_t First = []()
+    {
+        std::int32_t Day = 0;
+        ParseDueDate("2025-01-01", Day);
+        return Day;
+    }();
+    return First;
+}
+
+/**
+ * @brief Constructs a generator.
+ *
+ * @param Seed Seed of the sequence; equal seeds give equal tasks.
+ */
+TaskGenerator::TaskGenerator(std::uint64_t Seed) : State(Seed * 0x9E3779B97F4A7C15ULL + 1)
+{
+}
+
+/**
+ * @brief Draws the next 64-bit random number (splitmix64).
+ *
+ * @return Random number.
+ */
+std::uint64_t TaskGenerator::u64Next(void)
+{
+    std::uint64_t Value = (State += 0x9E3779B97F4A7C15ULL);
+    Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBULL;
+    return Value ^ (Value >> 31);
+}
+
+/**
+ * @brief Draws a random number below a bound.
+ *
+ * @param Bound Exclusive upper bound, above 0.
+ * @return Random number in [0, Bound).
+ */
+std::size_t TaskGenerator::u64Below(std::size_t Bound)
+{
+    return static_cast<std::size_t>(u64Next() % Bound);
+}
+
+/**
+ * @brief Appends words drawn from the vocabulary to a string.
+ *
+ * The product of two uniform draws favours the first words, so a few words
+ * are common and most are rare, as in real text.
+ *
+ * @param Out String to append to.
+ * @param Count Number of words.
+ */
+void TaskGenerator::vidAppendWords(std::string &Out, std::size_t Count)
+{
+    const std::vector<std::string> &Words = GetVocabulary();
+    for (std::size_t Index = 0; Index < Count; ++Index)
+    {
+        std::size_t Word = u64Below(BENCH_VOCABULARY_SIZE) * u64Below(BENCH_VOCABULARY_SIZE) / BENCH_VOCABULARY_SIZE;
+        if (Index > 0)
+        {
+            Out.push_back(' ');
+        }
+        Out += Words[Word];
+    }
+}
+
+/**
+ * @brief Generates the next task.
+ *
+ * One task in ten has no due date and one in five is done.
+ *
+ * @param task Receives the task fields.
+ */
+void TaskGenerator::vidNext(SyntheticTask &task)
+{
+    task.Title.clear();
+    task.Description.clear();
+    vidAppendWords(task.Title, 3);
+    vidAppendWords(task.Description, 8);
+    task.DueDay = (u64Below(10) == 0) ? TASK_NO_DUE_DATE
+                                      : int32GetFirstDueDay() + static_cast<std::int32_t>(u64Below(BENCH_DUE_SPAN));
+    task.Priority = static_cast<TaskPriority>(u64Below(4));
+    task.State = (u64Below(5) == 0) ? TaskState::Done : TaskState::Pending;
+}
+
+/**
+ * @brief Gets the options of the current run.
+ *
+ * @return Mutable options, set up by main() before any benchmark runs.
+ */
+BenchConfig &GetBenchConfig(void)
+{
+    static BenchConfig Config;
+    return Config;
+}
+
+/**
+ * @brief Gets the task set sizes allowed by the current run.
+ *
+ * @return Sizes from BENCH_TASK_SIZES up to BenchConfig::MaxTasks.
+ */
+std::vector<std::size_t> GetBenchSizes(void)
+{
+    std::vector<std::size_t> Sizes;
+    for (std::size_t Size : BENCH_TASK_SIZES)
+    {
+        if (Size <= GetBenchConfig().MaxTasks)
+        {
+            Sizes.push_back(Size);
+        }
+    }
+    return Sizes;
+}
+
+/**
+ * @brief Adds generated tasks to a task manager.
+ *
+ * @param manager Task manager to fill.
+ * @param Count Number of tasks to add.
+ * @param Seed Seed of the generator.
+ */
+void vidFillTasks(TaskManager &manager, std::size_t Count, std::uint64_t Seed)
+{
+    TaskGenerator Generator(Seed);
+    SyntheticTask task;
+    for (std::size_t Index = 0; Index < Count; ++Index)
+    {
+        Generator.vidNext(task);
+        int id = manager.addTask(std::string_view(task.Title), std::string_view(task.Description), task.DueDay, task.Priority);
+        if (task.State == TaskState::Done)
+        {
+            manager.setStatus(id, TaskState::Done);
+        }
+    }
+}
+
+/**
+ * @brief Gets the path of a generated task file, writing it on first use.
+ *
+ * Files are kept in the work directory between runs; their names carry the
+ * generator version so a changed generator never reuses stale files.
+ *
+ * @param Count Number of tasks in the file.
+ * @param Extension Extension selecting the file format, such as ".txt", ".bin" or ".tsnap".
+ * @return Path of the file inside BenchConfig::WorkDir.
+ */
+std::string GetTaskFile(std::size_t Count, const std::string &Extension)
+{
+    std::string Path = GetBenchConfig().WorkDir + "/tasks_v1_" + std::to_string(Count) + Extension;
+    std::error_code Error;
+    if (std::filesystem::exists(Path, Error) == false)
+    {
+        QuietConsole Quiet;
+        TaskManager manager;
+        vidFillTasks(manager, Count);
+        manager.SaveTasksToFile(Path);
+    }
+    return Path;
+}
+
+/**
+ * @brief Gets a batch of "add" commands for the batch runner.
+ *
+ * @param Count Number of commands.
+ * @return Commands, one per line.
+ */
+std::string MakeAddBatch(std::size_t Count)
+{
+    TaskGenerator Generator(2);
+    SyntheticTask task;
+    std::string Batch;
+    for (std::size_t Index = 0; Index < Count; ++Index)
+    {
+        Generator.vidNext(task);
+        Batch.append("add|").append(task.Title).push_back('|');
+        Batch.append(task.Description).push_back('|');
+        if (task.DueDay != TASK_NO_DUE_DATE)
+        {
+            Batch.append(FormatDueDate(task.DueDay));
+        }
+        Batch.push_back('|');
+        if (task.Priority != TaskPriority::Unknown)
+        {
+            Batch.append(TaskPriorityName(task.Priority));
+        }
+        Batch.push_back('\n');
+    }
+    return Batch;
+}
+
+/**
+ * @brief Silences the console.
+ */
+QuietConsole::QuietConsole() : OldOut(std::cout.rdbuf(nullptr)), OldErr(std::cerr.rdbuf(nullptr))
+{
+}
+
+/**
+ * @brief Restores the console.
+ */
+QuietConsole::~QuietConsole()
+{
+    std::cout.rdbuf(OldOut);
+    std::cerr.rdbuf(OldErr);
+    std::cout.clear();
+    std::cerr.clear();
+}
@@ -0,0 +1,182 @@
+/**
+ * @file bench_data.hpp
+ * @brief Declaration of the synthetic task sets and helpers shared by the benchmarks.
+ *
+ * Task sets are generated from a fixed seed, so every run and every release
+ * measures the same data. Titles and descriptions are drawn from a small
+ * vocabulary with a skewed distribution, which gives the text index a
+ * realistic mix of common and rare terms.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __BENCH__DATA__
+#define __BENCH__DATA__
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "task_manager.hpp"
+
+/**
+ * @brief Task set sizes the size-dependent benchmarks run with, capped by --max_tasks.
+ */
+constexpr std::size_t BENCH_TASK_SIZES[] = {1000, 10000, 100000, 1000000, 10000000};
+
+/**
+ * @struct BenchConfig
+ * @brief Options of a benchmark run.
+ */
+struct BenchConfig
+{
+    std::size_t MaxTasks = 10000000;    /**< Largest task set to generate. */
+    std::string WorkDir;                /**< Directory holding the generated task files. */
+};
+
+/**
+ * @struct SyntheticTask
+ * @brief Fields of one generated task.
+ */
+struct SyntheticTask
+{
+    std::string Title;                              /**< Title, three words. */
+    std::string Description;                        /**< Description, eight words. */
+    std::int32_t DueDay = TASK_NO_DUE_DATE;         /**< Due date as a day number, or TASK_NO_DUE_DATE. */
+    TaskPriority Priority = TaskPriority::Unknown;  /**< Priority. */
+    TaskState State = TaskState::Pending;           /**< Status. */
+};
+
+/**
+ * @class TaskGenerator
+ * @brief Deterministic source of synthetic tasks.
+ */
+class TaskGenerator
+{
+private:
+    std::uint64_t State;    /**< State of the random number generator. */
+
+    /**
+     * @brief Draws the next 64-bit random number.
+     *
+     * @return Random number.
+     */
+    std::uint64_t u64Next(void);
+
+    /**
+     * @brief Appends words drawn from the vocabulary to a string.
+     *
+     * @param Out String to append to.
+     * @param Count Number of words.
+     */
+    void vidAppendWords(std::string &Out, std::size_t Count);
+
+public:
+    /**
+     * @brief Constructs a generator.
+     *
+     * @param Seed Seed of the sequence; equal seeds give equal tasks.
+     */
+    explicit TaskGenerator(std::uint64_t Seed = 1);
+
+    /**
+     * @brief Generates the next task.
+     *
+     * @param task Receives the task fields.
+     */
+    void vidNext(SyntheticTask &task);
+
+    /**
+     * @brief Draws a random number below a bound.
+     *
+     * @param Bound Exclusive upper bound, above 0.
+     * @return Random number in [0, Bound).
+     */
+    std::size_t u64Below(std::size_t Bound);
+};
+
+/**
+ * @brief Gets the options of the current run.
+ *
+ * @return Mutable options, set up by main() before any benchmark runs.
+ */
+BenchConfig &GetBenchConfig(void);
+
+/**
+ * @brief Gets the task set sizes allowed by the current run.
+ *
+ * @return Sizes from BENCH_TASK_SIZES up to BenchConfig::MaxTasks.
+ */
+std::vector<std::size_t> GetBenchSizes(void);
+
+/**
+ * @brief Adds generated tasks to a task manager.
+ *
+ * @param manager Task manager to fill.
+ * @param Count Number of tasks to add.
+ * @param Seed Seed of the generator.
+ */
+void vidFillTasks(TaskManager &manager, std::size_t Count, std::uint64_t Seed = 1);
+
+/**
+ * @brief Gets the path of a generated task file, writing it on first use.
+ *
+ * @param Count Number of tasks in the file.
+ * @param Extension Extension selecting the file format, such as ".txt", ".bin" or ".tsnap".
+ * @return Path of the file inside BenchConfig::WorkDir.
+ */
+std::string GetTaskFile(std::size_t Count, const std::string &Extension);
+
+/**
+ * @brief Gets a batch of "add" commands for the batch runner.
+ *
+ * @param Count Number of commands.
+ * @return Commands, one per line.
+ */
+std::string MakeAddBatch(std::size_t Count);
+
+/**
+ * @class QuietConsole
+ * @brief Silences std::cout and std::cerr while it is alive.
+ *
+ * The task manager reports progress on the console, which would interleave
+ * with the benchmark results.
+ */
+class QuietConsole
+{
+private:
+    std::streambuf *OldOut;     /**< Buffer of std::cout to restore. */
+    std::streambuf *OldErr;     /**< Buffer of std::cerr to restore. */
+
+public:
+    /**
+     * @brief Silences the console.
+     */
+    QuietConsole();
+
+    QuietConsole(const QuietConsole &) = delete;
+    QuietConsole &operator=(const QuietConsole &) = delete;
+
+    /**
+     * @brief Restores the console.
+     */
+    ~QuietConsole();
+};
+
+/**
+ * @brief Registers the in-memory task manager benchmarks.
+ */
+void vidRegisterTaskBenchmarks(void);
+
+/**
+ * @brief Registers the file format, import and scanner benchmarks.
+ */
+void vidRegisterStorageBenchmarks(void);
+
+/**
+ * @brief Registers the concurrent store and mutation queue benchmarks.
+ */
+void vidRegisterConcurrencyBenchmarks(void);
+
+#endif // __BENCH__DATA__
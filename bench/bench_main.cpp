@@ -0,0 +1,113 @@
+/**
+ * @file bench_main.cpp
+ * @brief Entry point of the taskmanager_bench benchmark suite.
+ *
+ * Besides the Google Benchmark flags, the suite takes:
+ *   --max_tasks=<n>   largest task set to generate (default 10000000)
+ *   --work_dir=<dir>  directory for generated task files (default: a
+ *                     "taskmanager_bench" directory in the system temporary directory)
+ *
+ * Results are printed as JSON unless --benchmark_format is given, so runs can
+ * be stored and compared across releases.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "bench_data.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <filesystem>
+
+/**
+ * @brief Reads the options of the suite and removes them from the arguments.
+ *
+ * @param argc Number of arguments, updated.
+ * @param argv Arguments, compacted in place.
+ * @return true if every option of the suite is valid.
+ */
+static bool bParseBenchOptions(int &argc, char **argv)
+{
+    BenchConfig &Config = GetBenchConfig();
+    int Kept = 1;
+    for (int Index = 1; Index < argc; ++Index)
+    {
+        const char *Arg = argv[Index];
+        if (std::strncmp(Arg, "--max_tasks=", 12) == 0)
+        {
+            char *End = nullptr;
+            unsigned long long Value = std::strtoull(Arg + 12, &End, 10);
+            if (End == Arg + 12 || *End != '\0')
+            {
+                std::cerr << "Invalid Task Count: " << (Arg + 12) << std::endl;
+                return false;
+            }
+            Config.MaxTasks = static_cast<std::size_t>(Value);
+        }
+        else if (std::strncmp(Arg, "--work_dir=", 11) == 0)
+        {
+            Config.WorkDir = Arg + 11;
+        }
+        else
+        {
+            argv[Kept++] = argv[Index];
+        }
+    }
+    argc = Kept;
+    argv[argc] = nullptr;
+
+    if (Config.WorkDir.empty() == true)
+    {
+        std::error_code Error;
+        Config.WorkDir = (std::filesystem::temp_directory_path(Error) / "taskmanager_bench").string();
+    }
+    std::error_code Error;
+    std::filesystem::create_directories(Config.WorkDir, Error);
+    if (Error)
+    {
+        std::cerr << "Cannot Create Work Directory: " << Config.WorkDir << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Runs the benchmark suite.
+ *
+ * @param argc Number of arguments.
+ * @param argv Arguments.
+ * @return 0 on success, 1 on invalid arguments.
+ */
+int main(int argc, char **argv)
+{
+    if (bParseBenchOptions(argc, argv) == false)
+    {
+        return 1;
+    }
+
+    bool HasFormat = false;
+    for (int Index = 1; Index < argc; ++Index)
+    {
+        HasFormat = HasFormat || (std::strncmp(argv[Index], "--benchmark_format=", 19) == 0);
+    }
+    std::vector<char *> Args(argv, argv + argc);
+    static char JsonFormat[] = "--benchmark_format=json";
+    if (HasFormat == false)
+    {
+        Args.push_back(JsonFormat);
+    }
+    int ArgCount = static_cast<int>(Args.size());
+    Args.push_back(nullptr);
+
+    benchmark::Initialize(&ArgCount, Args.data());
+    if (benchmark::ReportUnrecognizedArguments(ArgCount, Args.data()) == true)
+    {
+        return 1;
+    }
+    vidRegisterTaskBenchmarks();
+    vidRegisterStorageBenchmarks();
+    vidRegisterConcurrencyBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,279 @@
+/**
+ * @file bench_storage.cpp
+ * @brief Benchmarks of the task file formats, the batch import and the delimiter scanner.
+ *
+ * Throughput is reported in bytes per second of task file, so the text,
+ * binary and snapshot formats can be compared directly; the snapshot format
+ * being compressed, its file size is also reported as a counter.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "bench_data.hpp"
+#include "task_batch.hpp"
+#include "task_text_scanner.hpp"
+#include "mapped_file.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+/**
+ * @brief Gets the size of a file.
+ *
+ * @param Path Name of the file.
+ * @return Size in bytes, or 0 if it cannot be read.
+ */
+static std::int64_t int64FileSize(const std::string &Path)
+{
+    std::error_code Error;
+    std::uintmax_t Size = std::filesystem::file_size(Path, Error);
+    return Error ? 0 : static_cast<std::int64_t>(Size);
+}
+
+/**
+ * @brief Saves a task set with SaveTasksToFile().
+ *
+ * One task is changed before each save, since a save with nothing changed
+ * since the last one writes nothing.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ * @param Extension Extension selecting the file format.
+ */
+static void BM_Save(benchmark::State &state, const char *Extension)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = std::make_unique<TaskManager>();
+    vidFillTasks(*manager, Count);
+    std::string Path = GetBenchConfig().WorkDir + "/save" + Extension;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        manager->setStatus(1, (manager->findTask(1)->GetTaskState() == TaskState::Done) ? TaskState::Pending : TaskState::Done);
+        state.ResumeTiming();
+        QuietConsole Quiet;
+        manager->SaveTasksToFile(Path);
+    }
+    state.SetBytesProcessed(state.iterations() * int64FileSize(Path));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+    state.counters["file_bytes"] = static_cast<double>(int64FileSize(Path));
+    std::error_code Error;
+    std::filesystem::remove(Path, Error);
+}
+
+/**
+ * @brief Loads a task set with LoadTasksFrom() into an empty manager.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ * @param Extension Extension selecting the file format.
+ * @param CachedBodies Task bodies kept by a lazy load (see TaskManager::SetLazyLoading()), or 0 for a full load.
+ */
+static void BM_Load(benchmark::State &state, const char *Extension, std::size_t CachedBodies)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    std::string Path = GetTaskFile(Count, Extension);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = std::make_unique<TaskManager>();
+        manager->SetLazyLoading(CachedBodies);
+        state.ResumeTiming();
+        {
+            QuietConsole Quiet;
+            manager->LoadTasksFrom(Path);
+        }
+        state.PauseTiming();
+        if (manager->size() != Count)
+        {
+            state.SkipWithError("Loaded Task Count Does Not Match");
+        }
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * int64FileSize(Path));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Loads a text task file the way LoadTasksFrom() did before it was memory-mapped.
+ *
+ * Every line is read with std::getline and split through std::stringstream
+ * into std::string fields, and every task is built in a temporary and copied
+ * into the list. Same file as Storage/LoadText, so the two compare directly.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_LoadTextGetline(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    std::string Path = GetTaskFile(Count, ".txt");
+    for (auto _ : state)
+    {
+        TaskList tasks;
+        std::fstream Content(Path, std::ios::in | std::ios::out);
+        std::string Data;
+        while (std::getline(Content, Data))
+        {
+            if (Data.empty() == true || Data[0] == '#')
+            {
+                continue;    /*The Old Loader Predates The Next ID Line*/
+            }
+            std::stringstream stream(Data);
+            std::vector<std::string> ParsedData;
+            std::string buffer;
+            std::string key, value;
+            while (std::getline(stream, buffer, '|'))
+            {
+                std::stringstream str(buffer);
+                if (std::getline(str, key, ':') && std::getline(str, value))
+                {
+                    ParsedData.push_back(value.substr((value.empty() == true) ? 0 : 1));
+                }
+            }
+            std::int32_t DueDay = TASK_NO_DUE_DATE;
+            TaskPriority Priority = TaskPriority::Unknown;
+            TaskState Status = TaskState::Pending;
+            ParseDueDate(ParsedData[3], DueDay);
+            ParseTaskPriority(ParsedData[4], Priority);
+            ParseTaskState(ParsedData[5], Status);
+            Task temp(std::stoi(ParsedData[0]), ParsedData[1], ParsedData[2], DueDay, Priority);
+            temp.vidSetTaskStatus(Status);
+            tasks.push_back(temp);
+        }
+        state.PauseTiming();
+        if (tasks.size() != Count)
+        {
+            state.SkipWithError("Loaded Task Count Does Not Match");
+        }
+        tasks = TaskList();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * int64FileSize(Path));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Saves a paged task set after changing one task, which patches a single page.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_PatchPaged(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = std::make_unique<TaskManager>();
+    vidFillTasks(*manager, Count);
+    std::string Path = GetBenchConfig().WorkDir + "/patch.tdb";
+    TaskGenerator Generator;
+    {
+        QuietConsole Quiet;
+        manager->SaveTasksToFile(Path);
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        int id = static_cast<int>(Generator.u64Below(Count)) + 1;
+        manager->setStatus(id, (manager->findTask(id)->GetTaskState() == TaskState::Done) ? TaskState::Pending : TaskState::Done);
+        state.ResumeTiming();
+        QuietConsole Quiet;
+        manager->SaveTasksToFile(Path);
+    }
+    state.SetItemsProcessed(state.iterations());
+    std::error_code Error;
+    std::filesystem::remove(Path, Error);
+}
+
+/**
+ * @brief Imports "add" commands through the batch runner.
+ *
+ * @param state Benchmark state; range 0 is the command count.
+ */
+static void BM_ImportBatch(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    std::string Batch = MakeAddBatch(Count);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = std::make_unique<TaskManager>();
+        std::istringstream In(Batch);
+        std::ostringstream Out;
+        state.ResumeTiming();
+        if (RunTaskBatch(*manager, In, Out) != 0)
+        {
+            state.SkipWithError("Batch Commands Failed");
+        }
+        state.PauseTiming();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(Batch.size()));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Finds the delimiters of a text task file at one scan level.
+ *
+ * @param state Benchmark state; range 0 is the task count of the file.
+ * @param Level Scan level to use.
+ */
+static void BM_ScanDelimiters(benchmark::State &state, ScanLevel Level)
+{
+    MappedFile Content(GetTaskFile(static_cast<std::size_t>(state.range(0)), ".txt"));
+    std::string_view Text = Content.View();
+    std::vector<std::uint32_t> Positions(Text.size());
+    std::size_t Found = 0;
+    for (auto _ : state)
+    {
+        Found = u64ScanDelimiters(Text, Positions.data(), Level);
+        benchmark::DoNotOptimize(Found);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(Text.size()));
+    state.counters["delimiters"] = static_cast<double>(Found);
+}
+
+/**
+ * @brief Registers the file format, import and scanner benchmarks.
+ *
+ * The scanner runs on the largest text file up to one million tasks, at every
+ * level the running processor supports.
+ */
+void vidRegisterStorageBenchmarks(void)
+{
+    std::vector<std::size_t> Sizes = GetBenchSizes();
+    for (std::size_t Size : Sizes)
+    {
+        std::int64_t Count = static_cast<std::int64_t>(Size);
+        benchmark::RegisterBenchmark("Storage/SaveText", BM_Save, ".txt")->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/SaveBinary", BM_Save, ".bin")->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/SaveSnapshot", BM_Save, ".tsnap")->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/LoadText", BM_Load, ".txt", 0)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/LoadTextGetline", BM_LoadTextGetline)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/LoadBinary", BM_Load, ".bin", 0)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/LoadSnapshot", BM_Load, ".tsnap", 0)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/LoadLazy", BM_Load, ".tsnap", TASK_BODY_CACHE_DEFAULT)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Storage/PatchPaged", BM_PatchPaged)->Arg(Count)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("Storage/ImportBatch", BM_ImportBatch)->Arg(Count)->Unit(benchmark::kMillisecond);
+    }
+
+    std::size_t ScanSize = 0;
+    for (std::size_t Size : Sizes)
+    {
+        ScanSize = (Size <= 1000000) ? Size : ScanSize;
+    }
+    if (ScanSize == 0)
+    {
+        return;
+    }
+    ScanLevel Best = GetBestScanLevel();
+    for (ScanLevel Level : {ScanLevel::Scalar, ScanLevel::Sse2, ScanLevel::Avx2})
+    {
+        if (static_cast<int>(Level) > static_cast<int>(Best))
+        {
+            continue;
+        }
+        std::string Name = "Scanner/" + std::string(GetScanLevelName(Level));
+        benchmark::RegisterBenchmark(Name.c_str(), BM_ScanDelimiters, Level)->Arg(static_cast<std::int64_t>(ScanSize))->Unit(benchmark::kMillisecond);
+    }
+}
@@ -0,0 +1,434 @@
+/**
+ * @file bench_tasks.cpp
+ * @brief Benchmarks of the in-memory TaskManager operations.
+ *
+ * Each benchmark runs once per task set size. Set-up work, such as filling a
+ * fresh manager, happens with the timer paused, so the reported time covers
+ * only the operation named by the benchmark. The Layout benchmarks run the
+ * same filter over the task vector and over TaskColumnStore.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "bench_data.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+/**
+ * @brief Number of random IDs drawn ahead of a lookup or update benchmark.
+ */
+static constexpr std::size_t BENCH_RANDOM_IDS = 1 << 16;
+
+/**
+ * @brief Stream buffer that discards everything written to it.
+ */
+class NullBuffer : public std::streambuf
+{
+protected:
+    /**
+     * @brief Accepts a block of characters.
+     *
+     * @param Count Number of characters.
+     * @return Count, so the stream never fails.
+     */
+    std::streamsize xsputn(const char *, std::streamsize Count) override
+    {
+        return Count;
+    }
+
+    /**
+     * @brief Accepts one character.
+     *
+     * @param Character Character written.
+     * @return Character, so the stream never fails.
+     */
+    int overflow(int Character) override
+    {
+        return Character;
+    }
+};
+
+/**
+ * @brief Draws random IDs of a task set.
+ *
+ * @param Count Number of tasks; IDs are 1 to Count.
+ * @return BENCH_RANDOM_IDS IDs.
+ */
+static std::vector<int> DrawIds(std::size_t Count)
+{
+    TaskGenerator Generator(3);
+    std::vector<int> Ids(BENCH_RANDOM_IDS);
+    for (int &id : Ids)
+    {
+        id = static_cast<int>(Generator.u64Below(Count)) + 1;
+    }
+    return Ids;
+}
+
+/**
+ * @brief Creates a task manager holding a generated task set.
+ *
+ * @param Count Number of tasks.
+ * @return Filled task manager.
+ */
+static std::unique_ptr<TaskManager> MakeManager(std::size_t Count)
+{
+    auto manager = std::make_unique<TaskManager>();
+    vidFillTasks(*manager, Count);
+    return manager;
+}
+
+/**
+ * @brief Adds a whole task set to an empty manager.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_AddTask(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    TaskGenerator Generator;
+    std::vector<SyntheticTask> Input(Count);
+    for (SyntheticTask &task : Input)
+    {
+        Generator.vidNext(task);
+    }
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = std::make_unique<TaskManager>();
+        state.ResumeTiming();
+        for (const SyntheticTask &task : Input)
+        {
+            benchmark::DoNotOptimize(manager->addTask(std::string_view(task.Title), std::string_view(task.Description),
+                                                      task.DueDay, task.Priority));
+        }
+        state.PauseTiming();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Deletes a tenth of a task set, at random.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_RemoveTask(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    std::vector<int> Ids = DrawIds(Count);
+    std::size_t Removals = std::min(Ids.size(), Count / 10);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = MakeManager(Count);
+        state.ResumeTiming();
+        for (std::size_t Index = 0; Index < Removals; ++Index)
+        {
+            benchmark::DoNotOptimize(manager->removeTask(Ids[Index]));
+        }
+        state.PauseTiming();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Removals));
+}
+
+/**
+ * @brief Looks tasks up by random ID.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_FindTask(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    std::vector<int> Ids = DrawIds(Count);
+    std::size_t Next = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(manager->findTask(Ids[Next]));
+        Next = (Next + 1) % Ids.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Updates the status and title of tasks by random ID, as updateTask() does after its lookup.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_UpdateTask(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    std::vector<int> Ids = DrawIds(Count);
+    std::size_t Next = 0;
+    for (auto _ : state)
+    {
+        int id = Ids[Next];
+        manager->setStatus(id, (Next % 2 == 0) ? TaskState::Done : TaskState::Pending);
+        manager->setTitle(id, (Next % 2 == 0) ? std::string_view("updated title") : std::string_view("title updated"));
+        Next = (Next + 1) % Ids.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * @brief Formats the whole task listing.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_ListTasks(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    NullBuffer Sink;
+    std::ostream Out(&Sink);
+    for (auto _ : state)
+    {
+        manager->listTasks(Out);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Formats the whole task listing the way listTasks() did before it was buffered.
+ *
+ * Every task goes through a temporary Task::toString() string, and every line
+ * ends with std::endl, which flushes the stream. Same task set and sink as
+ * BM_ListTasks, so the two compare directly.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_ListTasksUnbuffered(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    NullBuffer Sink;
+    std::ostream Out(&Sink);
+    std::vector<const Task *> Listed;
+    Listed.reserve(Count);
+    for (int id = 1; id <= static_cast<int>(Count); ++id)
+    {
+        Listed.push_back(static_cast<const TaskManager &>(*manager).findTask(id));
+    }
+    for (auto _ : state)
+    {
+        int TaskCounter = 0;
+        Out << "\n------------------- List Of Tasks -------------------" << std::endl;
+        for (const Task *it : Listed)
+        {
+            Out << "Task " << ++TaskCounter << " Data ==>" << std::endl;
+            Out << it->toString() << std::endl;
+            Out << "------------------------------------------------------" << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Runs a status, priority and one-month due date query on the secondary index.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_Query(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    TaskFilter Filter;
+    Filter.HasState = true;
+    Filter.State = TaskState::Pending;
+    Filter.HasPriority = true;
+    Filter.Priority = TaskPriority::High;
+    ParseDueDate("2025-06-01", Filter.DueFrom);
+    ParseDueDate("2025-06-30", Filter.DueTo);
+    manager->Query(Filter);
+    std::size_t Matches = 0;
+    for (auto _ : state)
+    {
+        Matches = manager->Query(Filter).size();
+    }
+    state.counters["matches"] = static_cast<double>(Matches);
+}
+
+/**
+ * @brief Collects every task through Query, the path a batch list takes.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_QueryAll(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    manager->Query(TaskFilter());
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(manager->Query(TaskFilter()));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Generates a task set in the array-of-structures layout TaskManager keeps its tasks in.
+ *
+ * @param Count Number of tasks.
+ * @param Arena Memory resource serving the list and its text.
+ * @return Generated tasks, with IDs 1 to Count.
+ */
+static TaskList MakeTaskList(std::size_t Count, std::pmr::memory_resource *Arena)
+{
+    TaskGenerator Generator;
+    SyntheticTask task;
+    TaskList tasks(Arena);
+    tasks.reserve(Count);
+    for (std::size_t Index = 0; Index < Count; ++Index)
+    {
+        Generator.vidNext(task);
+        tasks.emplace_back(static_cast<int>(Index) + 1, task.Title, task.Description, task.DueDay, task.Priority);
+        if (task.State == TaskState::Done)
+        {
+            tasks.back().markDone();
+        }
+    }
+    return tasks;
+}
+
+/**
+ * @brief Gets the filter of the layout benchmarks: pending, high priority tasks due in 2025.
+ *
+ * It restricts all three scanned fields, so neither layout can skip a row.
+ *
+ * @return The filter.
+ */
+static TaskFilter GetScanFilter(void)
+{
+    TaskFilter Filter;
+    Filter.HasState = true;
+    Filter.State = TaskState::Pending;
+    Filter.HasPriority = true;
+    Filter.Priority = TaskPriority::High;
+    ParseDueDate("2025-01-01", Filter.DueFrom);
+    ParseDueDate("2025-12-31", Filter.DueTo);
+    return Filter;
+}
+
+/**
+ * @brief Counts the tasks matching a filter by walking the task vector.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_ScanTaskVector(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    std::pmr::unsynchronized_pool_resource Arena;
+    TaskList tasks = MakeTaskList(Count, &Arena);
+    TaskFilter Filter = GetScanFilter();
+    std::size_t Matches = 0;
+    for (auto _ : state)
+    {
+        Matches = 0;
+        for (auto &it : tasks)
+        {
+            Matches += (it.bIsRemoved() == false && it.GetTaskState() == Filter.State && it.GetTaskPriority() == Filter.Priority &&
+                        it.int32GetDueDay() >= Filter.DueFrom && it.int32GetDueDay() <= Filter.DueTo)
+                           ? 1
+                           : 0;
+        }
+        benchmark::DoNotOptimize(Matches);
+    }
+    state.counters["matches"] = static_cast<double>(Matches);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Counts the tasks matching a filter by scanning the column store.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_ScanColumns(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    TaskColumnStore Columns;
+    {
+        std::pmr::unsynchronized_pool_resource Arena;
+        Columns.vidBuild(MakeTaskList(Count, &Arena));
+    }
+    TaskFilter Filter = GetScanFilter();
+    std::size_t Matches = 0;
+    for (auto _ : state)
+    {
+        Matches = Columns.u64Count(Filter);
+        benchmark::DoNotOptimize(Matches);
+    }
+    state.counters["matches"] = static_cast<double>(Matches);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Builds the text index on the first search of a fresh manager.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ */
+static void BM_BuildTextIndex(benchmark::State &state)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto manager = MakeManager(Count);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(manager->Search("kalo"));
+        state.PauseTiming();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(Count));
+}
+
+/**
+ * @brief Runs a keyword search on a built text index.
+ *
+ * @param state Benchmark state; range 0 is the task count.
+ * @param Query Search query.
+ */
+static void BM_Search(benchmark::State &state, const char *Query)
+{
+    std::size_t Count = static_cast<std::size_t>(state.range(0));
+    auto manager = MakeManager(Count);
+    manager->Search(Query);
+    std::size_t Matches = 0;
+    for (auto _ : state)
+    {
+        Matches = manager->Search(Query).size();
+    }
+    state.counters["matches"] = static_cast<double>(Matches);
+}
+
+/**
+ * @brief Registers the in-memory task manager benchmarks.
+ */
+void vidRegisterTaskBenchmarks(void)
+{
+    for (std::size_t Size : GetBenchSizes())
+    {
+        std::int64_t Count = static_cast<std::int64_t>(Size);
+        benchmark::RegisterBenchmark("TaskManager/AddTask", BM_AddTask)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("TaskManager/RemoveTask", BM_RemoveTask)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("TaskManager/FindTask", BM_FindTask)->Arg(Count);
+        benchmark::RegisterBenchmark("TaskManager/UpdateTask", BM_UpdateTask)->Arg(Count);
+        benchmark::RegisterBenchmark("TaskManager/ListTasks", BM_ListTasks)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("TaskManager/ListTasksUnbuffered", BM_ListTasksUnbuffered)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("TaskManager/Query", BM_Query)->Arg(Count)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("TaskManager/QueryAll", BM_QueryAll)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Layout/ScanTaskVector", BM_ScanTaskVector)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("Layout/ScanColumns", BM_ScanColumns)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("TaskManager/BuildTextIndex", BM_BuildTextIndex)->Arg(Count)->Unit(benchmark::kMillisecond);
+        benchmark::RegisterBenchmark("TaskManager/Search/Term", BM_Search, "kalo")->Arg(Count)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("TaskManager/Search/And", BM_Search, "kalo lolo")->Arg(Count)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("TaskManager/Search/Or", BM_Search, "kalo OR milo")->Arg(Count)->Unit(benchmark::kMicrosecond);
+        benchmark::RegisterBenchmark("TaskManager/Search/Prefix", BM_Search, "ka*")->Arg(Count)->Unit(benchmark::kMicrosecond);
+    }
+}
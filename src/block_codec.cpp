@@ -0,0 +1,324 @@
+/**
+ * @file block_codec.cpp
+ * @brief Implementation of the LZ4 block format compressor and decompressor.
+ *
+ * A block is a series of sequences. Each sequence starts with a token whose
+ * high four bits hold the number of literal bytes and whose low four bits
+ * hold the match length minus four; either field saturated at 15 goes on in
+ * extra bytes of 255 ended by a smaller one. The literals follow, then the
+ * two-byte little-endian match offset and the extra match length bytes. The
+ * last sequence holds literals only, and the format requires the last five
+ * bytes to be literals and no match to start within the last twelve.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "block_codec.hpp"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Shortest match worth encoding.
+ */
+static constexpr std::size_t CODEC_MIN_MATCH = 4;
+
+/**
+ * @brief Number of bytes at the end of a block that are always literals.
+ */
+static constexpr std::size_t CODEC_LAST_LITERALS = 5;
+
+/**
+ * @brief No match may start within this many bytes of the end of a block.
+ */
+static constexpr std::size_t CODEC_MATCH_LIMIT = 12;
+
+/**
+ * @brief Largest distance a match may refer back.
+ */
+static constexpr std::size_t CODEC_MAX_OFFSET = 65535;
+
+/**
+ * @brief Number of bits of the match finder hash; 2^12 positions fit in 16 KiB, well within L1.
+ */
+static constexpr unsigned CODEC_HASH_BITS = 12;
+
+/**
+ * @brief After this many failed searches in a row, the search step grows by one byte.
+ *
+ * Skipping faster through data that does not compress keeps incompressible
+ * blocks nearly as cheap as a copy.
+ */
+static constexpr unsigned CODEC_SKIP_SHIFT = 6;
+
+/**
+ * @brief Number of bytes the decompressor copies at once when there is room for it.
+ *
+ * Most literal runs and matches are shorter than this; copying a fixed size,
+ * then moving on by the real length, spares a variable-length copy for each,
+ * at the price of a few bytes written past the run and overwritten next.
+ */
+static constexpr std::size_t CODEC_WILD_COPY = 16;
+
+/**
+ * @brief Reads four bytes in host order.
+ *
+ * @param Data First byte.
+ * @return The bytes as an integer.
+ */
+static std::uint32_t u32Load(const unsigned char *Data)
+{
+    std::uint32_t Value;
+    std::memcpy(&Value, Data, sizeof(Value));
+    return Value;
+}
+
+/**
+ * @brief Hashes four bytes into the match finder table.
+ *
+ * @param Sequence The four bytes.
+ * @return Slot in the table.
+ */
+static std::uint32_t u32HashSequence(std::uint32_t Sequence)
+{
+    return (Sequence * 2654435761u) >> (32 - CODEC_HASH_BITS);
+}
+
+/**
+ * @brief Writes the extra bytes of a saturated length field.
+ *
+ * @param Out Next output byte, advanced past the written bytes.
+ * @param Length Part of the length beyond the 15 held by the token.
+ */
+static void vidWriteLength(unsigned char *&Out, std::size_t Length)
+{
+    while (Length >= 255)
+    {
+        *Out++ = 255;
+        Length -= 255;
+    }
+    *Out++ = static_cast<unsigned char>(Length);
+}
+
+/**
+ * @brief Writes one sequence: a token, the literals and, unless it is the last one, a match.
+ *
+ * @param Out Next output byte, advanced past the sequence.
+ * @param Literals First literal byte.
+ * @param LiteralCount Number of literal bytes.
+ * @param Offset Distance the match refers back, or 0 for the last sequence.
+ * @param MatchLength Length of the match, at least CODEC_MIN_MATCH unless Offset is 0.
+ */
+static void vidWriteSequence(unsigned char *&Out, const unsigned char *Literals, std::size_t LiteralCount,
+                             std::size_t Offset, std::size_t MatchLength)
+{
+    unsigned char *Token = Out++;
+    std::size_t MatchCode = (Offset != 0) ? MatchLength - CODEC_MIN_MATCH : 0;
+    *Token = static_cast<unsigned char>(((LiteralCount < 15) ? LiteralCount : 15) << 4);
+    if (LiteralCount >= 15)
+    {
+        vidWriteLength(Out, LiteralCount - 15);
+    }
+    std::memcpy(Out, Literals, LiteralCount);
+    Out += LiteralCount;
+    if (Offset == 0)
+    {
+        return;
+    }
+    *Out++ = static_cast<unsigned char>(Offset & 0xFF);
+    *Out++ = static_cast<unsigned char>(Offset >> 8);
+    *Token |= static_cast<unsigned char>((MatchCode < 15) ? MatchCode : 15);
+    if (MatchCode >= 15)
+    {
+        vidWriteLength(Out, MatchCode - 15);
+    }
+}
+
+/**
+ * @brief Gets the largest size the compressed form of a block can have.
+ *
+ * Incompressible data grows by one length byte per 255 literals, plus a token.
+ *
+ * @param Size Number of bytes in the block.
+ * @return Upper bound of the compressed size.
+ */
+std::size_t u64CompressBound(std::size_t Size)
+{
+    return Size + Size / 255 + 16;
+}
+
+/**
+ * @brief Compresses a block and appends the result to a buffer.
+ *
+ * A greedy parse: at each position the table gives the last position whose
+ * four bytes hashed alike; if they really match, the match is extended
+ * backwards over pending literals and forwards as far as it goes.
+ *
+ * @param Source First byte of the block.
+ * @param Size Number of bytes in the block.
+ * @param Out Buffer the compressed block is appended to.
+ * @return Number of bytes appended.
+ */
+std::size_t u64CompressBlock(const char *Source, std::size_t Size, std::string &Out)
+{
+    std::size_t Start = Out.size();
+    Out.resize(Start + u64CompressBound(Size));
+    const unsigned char *Base = reinterpret_cast<const unsigned char *>(Source);
+    unsigned char *Begin = reinterpret_cast<unsigned char *>(&Out[Start]);
+    unsigned char *Write = Begin;
+    std::size_t Anchor = 0;
+
+    if (Size > CODEC_MATCH_LIMIT)
+    {
+        std::uint32_t Table[1u << CODEC_HASH_BITS] = {};
+        std::size_t SearchLimit = Size - CODEC_MATCH_LIMIT;
+        std::size_t MatchLimit = Size - CODEC_LAST_LITERALS;
+        std::size_t Position = 0;
+        std::size_t Misses = 0;
+        while (Position < SearchLimit)
+        {
+            std::uint32_t Sequence = u32Load(Base + Position);
+            std::uint32_t Slot = u32HashSequence(Sequence);
+            std::size_t Candidate = Table[Slot];
+            Table[Slot] = static_cast<std::uint32_t>(Position);
+            if (Candidate >= Position || Position - Candidate > CODEC_MAX_OFFSET || u32Load(Base + Candidate) != Sequence)
+            {
+                Position += 1 + (Misses++ >> CODEC_SKIP_SHIFT);
+                continue;
+            }
+            while (Position > Anchor && Candidate > 0 && Base[Position - 1] == Base[Candidate - 1])
+            {
+                --Position;
+                --Candidate;
+            }
+            std::size_t Length = CODEC_MIN_MATCH;
+            while (Position + Length < MatchLimit && Base[Position + Length] == Base[Candidate + Length])
+            {
+                ++Length;
+            }
+            vidWriteSequence(Write, Base + Anchor, Position - Anchor, Position - Candidate, Length);
+            Position += Length;
+            Anchor = Position;
+            Misses = 0;
+            if (Position < SearchLimit)
+            {
+                Table[u32HashSequence(u32Load(Base + Position - 2))] = static_cast<std::uint32_t>(Position - 2);
+            }
+        }
+    }
+    vidWriteSequence(Write, Base + Anchor, Size - Anchor, 0, 0);
+
+    std::size_t Written = static_cast<std::size_t>(Write - Begin);
+    Out.resize(Start + Written);
+    return Written;
+}
+
+/**
+ * @brief Reads the extra bytes of a saturated length field.
+ *
+ * @param Source Compressed block.
+ * @param Size Size of the compressed block.
+ * @param Position Next byte to read, advanced past the field.
+ * @param Length Length to add the extra bytes to.
+ * @return true if the field ended within the block.
+ */
+static bool bReadLength(const unsigned char *Source, std::size_t Size, std::size_t &Position, std::size_t &Length)
+{
+    unsigned char Byte = 255;
+    while (Byte == 255)
+    {
+        if (Position >= Size)
+        {
+            return false;
+        }
+        Byte = Source[Position++];
+        Length += Byte;
+    }
+    return true;
+}
+
+/**
+ * @brief Decompresses a block whose original size is known.
+ *
+ * Away from the end of the buffers, short literal runs and matches that
+ * reach back at least CODEC_WILD_COPY bytes are copied in fixed-size chunks.
+ * Matches that overlap their own output, as a run of one repeated byte does,
+ * are copied one byte at a time.
+ *
+ * @param Source First byte of the compressed block.
+ * @param Size Number of bytes in the compressed block.
+ * @param Dest Buffer receiving the original bytes.
+ * @param DestSize Original size of the block, which Dest must be able to hold.
+ * @return true if the block was whole and decompressed to exactly DestSize bytes.
+ */
+bool bDecompressBlock(const char *Source, std::size_t Size, char *Dest, std::size_t DestSize)
+{
+    const unsigned char *In = reinterpret_cast<const unsigned char *>(Source);
+    std::size_t Read = 0;
+    std::size_t Written = 0;
+    while (Read < Size)
+    {
+        unsigned char Token = In[Read++];
+        std::size_t Literals = Token >> 4;
+        if (Literals == 15 && bReadLength(In, Size, Read, Literals) == false)
+        {
+            return false;
+        }
+        if (Literals > Size - Read || Literals > DestSize - Written)
+        {
+            return false;
+        }
+        if (Size - Read >= CODEC_WILD_COPY && DestSize - Written >= CODEC_WILD_COPY && Literals <= CODEC_WILD_COPY)
+        {
+            std::memcpy(Dest + Written, In + Read, CODEC_WILD_COPY);
+        }
+        else
+        {
+            std::memcpy(Dest + Written, In + Read, Literals);
+        }
+        Read += Literals;
+        Written += Literals;
+        if (Read == Size)
+        {
+            return Written == DestSize;
+        }
+
+        if (Size - Read < 2)
+        {
+            return false;
+        }
+        std::size_t Offset = static_cast<std::size_t>(In[Read]) | (static_cast<std::size_t>(In[Read + 1]) << 8);
+        Read += 2;
+        std::size_t Length = Token & 15;
+        if (Length == 15 && bReadLength(In, Size, Read, Length) == false)
+        {
+            return false;
+        }
+        Length += CODEC_MIN_MATCH;
+        if (Offset == 0 || Offset > Written || Length > DestSize - Written)
+        {
+            return false;
+        }
+        char *Match = Dest + Written - Offset;
+        if (Offset >= CODEC_WILD_COPY && DestSize - Written >= Length + CODEC_WILD_COPY)
+        {
+            for (std::size_t Index = 0; Index < Length; Index += CODEC_WILD_COPY)
+            {
+                std::memcpy(Dest + Written + Index, Match + Index, CODEC_WILD_COPY);
+            }
+        }
+        else if (Offset >= Length)
+        {
+            std::memcpy(Dest + Written, Match, Length);
+        }
+        else
+        {
+            for (std::size_t Index = 0; Index < Length; ++Index)
+            {
+                Dest[Written + Index] = Match[Index];
+            }
+        }
+        Written += Length;
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file block_codec.hpp
+ * @brief Declaration of a fast block compressor producing the LZ4 block format.
+ *
+ * The compressor finds repeated sequences of at least four bytes with a small
+ * hash table and encodes them as back references of up to 64 KiB, in the LZ4
+ * block format, so any LZ4 block decoder can read its output. It favours
+ * speed over ratio: text compresses a few times at hundreds of megabytes per
+ * second, and decompression is mostly plain copies.
+ *
+ * Each block is independent: it needs no dictionary or state from any other
+ * block, so blocks can be compressed and decompressed in parallel and in any
+ * order. The decompressor checks every length and offset, so corrupt input
+ * is rejected rather than read or written out of bounds.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __BLOCK__CODEC__
+#define __BLOCK__CODEC__
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Gets the largest size the compressed form of a block can have.
+ *
+ * @param Size Number of bytes in the block.
+ * @return Upper bound of the compressed size.
+ */
+std::size_t u64CompressBound(std::size_t Size);
+
+/**
+ * @brief Compresses a block and appends the result to a buffer.
+ *
+ * @param Source First byte of the block.
+ * @param Size Number of bytes in the block.
+ * @param Out Buffer the compressed block is appended to.
+ * @return Number of bytes appended.
+ */
+std::size_t u64CompressBlock(const char *Source, std::size_t Size, std::string &Out);
+
+/**
+ * @brief Decompresses a block whose original size is known.
+ *
+ * @param Source First byte of the compressed block.
+ * @param Size Number of bytes in the compressed block.
+ * @param Dest Buffer receiving the original bytes.
+ * @param DestSize Original size of the block, which Dest must be able to hold.
+ * @return true if the block was whole and decompressed to exactly DestSize bytes.
+ */
+bool bDecompressBlock(const char *Source, std::size_t Size, char *Dest, std::size_t DestSize);
+
+#endif // __BLOCK__CODEC__
@@ -0,0 +1,389 @@
+/**
+ * @file concurrent_task_manager.cpp
+ * @brief Implementation of the ConcurrentTaskManager class.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "concurrent_task_manager.hpp"
+#include "task_file.hpp"
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <tuple>
+
+/**
+ * @brief Size after which the listing buffer is written to the output stream.
+ */
+static constexpr std::size_t CONCURRENT_TASK_LIST_FLUSH_SIZE = 1 << 16;
+
+/**
+ * @brief Constructs an empty shard with its secondary index ready.
+ */
+ConcurrentTaskManager::TaskShard::TaskShard()
+{
+    FieldIndex.vidBuild(Tasks);
+}
+
+/**
+ * @brief Constructs an empty task store.
+ *
+ * @param ShardCount Number of shards, or 0 for CONCURRENT_TASK_DEFAULT_SHARDS.
+ */
+ConcurrentTaskManager::ConcurrentTaskManager(std::size_t ShardCount)
+{
+    ShardCount = (ShardCount == 0) ? CONCURRENT_TASK_DEFAULT_SHARDS : ShardCount;
+    Shards.reserve(ShardCount);
+    for (std::size_t Index = 0; Index < ShardCount; ++Index)
+    {
+        Shards.push_back(std::make_unique<TaskShard>());
+    }
+}
+
+/**
+ * @brief Gets the shard a task ID belongs to.
+ *
+ * Consecutive IDs go to consecutive shards, so writers adding tasks at the
+ * same time spread over every shard.
+ *
+ * @param id Task ID.
+ * @return Shard of the ID.
+ */
+ConcurrentTaskManager::TaskShard &ConcurrentTaskManager::ShardOf(int id) const
+{
+    return *Shards[static_cast<std::uint32_t>(id) % Shards.size()];
+}
+
+/**
+ * @brief Applies a change to a task under the exclusive lock of its shard.
+ *
+ * @param id ID of the task to change.
+ * @param Change Callable receiving the task to change.
+ * @return true if the task exists and was changed, false otherwise.
+ */
+template <typename Function>
+bool ConcurrentTaskManager::bModify(int id, Function &&Change)
+{
+    TaskShard &Shard = ShardOf(id);
+    std::unique_lock<std::shared_mutex> Guard(Shard.Lock);
+    auto it = Shard.Index.find(id);
+    if (it == Shard.Index.end())
+    {
+        return false;
+    }
+    Task &task = Shard.Tasks[it->second];
+    Shard.FieldIndex.vidErase(task);
+    Change(task);
+    Shard.FieldIndex.vidInsert(task);
+    return true;
+}
+
+/**
+ * @brief Adds a task that already has an ID, under the exclusive lock of its shard.
+ *
+ * @param task Task to add; a task with the same ID is replaced.
+ */
+void ConcurrentTaskManager::vidPut(const Task &task)
+{
+    TaskShard &Shard = ShardOf(task.int32GetTaskID());
+    std::unique_lock<std::shared_mutex> Guard(Shard.Lock);
+    auto it = Shard.Index.find(task.int32GetTaskID());
+    if (it != Shard.Index.end())
+    {
+        Shard.FieldIndex.vidErase(Shard.Tasks[it->second]);
+        Shard.Tasks[it->second] = task;
+    }
+    else
+    {
+        Shard.Tasks.push_back(task);
+        Shard.Index[task.int32GetTaskID()] = Shard.Tasks.size() - 1;
+        ++TaskCount;
+    }
+    Shard.FieldIndex.vidInsert(task);
+}
+
+/**
+ * @brief Adds a new task.
+ *
+ * The ID is taken from the atomic counter, so only the shard of the new task
+ * is locked.
+ *
+ * @param title Title of the task.
+ * @param desc Description of the task.
+ * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+ * @param Priority Priority level of the task.
+ * @return ID of the new task.
+ */
+int ConcurrentTaskManager::addTask(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority)
+{
+    int id = nextId.fetch_add(1);
+    TaskShard &Shard = ShardOf(id);
+    std::unique_lock<std::shared_mutex> Guard(Shard.Lock);
+    Shard.Tasks.emplace_back(id, title, desc, DueDay, Priority);
+    Shard.Index[id] = Shard.Tasks.size() - 1;
+    Shard.FieldIndex.vidInsert(Shard.Tasks.back());
+    ++TaskCount;
+    return id;
+}
+
+/**
+ * @brief Removes a task by ID.
+ *
+ * Tasks in a shard are unordered, so the last task of the shard is moved into
+ * the freed slot and the removal costs constant time.
+ *
+ * @param id ID of the task to remove.
+ * @return true if the task existed and was removed, false otherwise.
+ */
+bool ConcurrentTaskManager::removeTask(int id)
+{
+    TaskShard &Shard = ShardOf(id);
+    std::unique_lock<std::shared_mutex> Guard(Shard.Lock);
+    auto it = Shard.Index.find(id);
+    if (it == Shard.Index.end())
+    {
+        return false;
+    }
+    std::size_t Slot = it->second;
+    Shard.Index.erase(it);
+    Shard.FieldIndex.vidErase(Shard.Tasks[Slot]);
+    if (Slot + 1 != Shard.Tasks.size())
+    {
+        Shard.Tasks[Slot] = std::move(Shard.Tasks.back());
+        Shard.Index[Shard.Tasks[Slot].int32GetTaskID()] = Slot;
+    }
+    Shard.Tasks.pop_back();
+    --TaskCount;
+    return true;
+}
+
+/**
+ * @brief Sets the status of a task.
+ *
+ * @param id ID of the task to update.
+ * @param state New status.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool ConcurrentTaskManager::setStatus(int id, TaskState state)
+{
+    return bModify(id, [state](Task &task)
+                   { task.vidSetTaskStatus(state); });
+}
+
+/**
+ * @brief Sets the title of a task.
+ *
+ * @param id ID of the task to update.
+ * @param title New title.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool ConcurrentTaskManager::setTitle(int id, std::string_view title)
+{
+    return bModify(id, [title](Task &task)
+                   { task.vidSetTitle(title); });
+}
+
+/**
+ * @brief Sets the description of a task.
+ *
+ * @param id ID of the task to update.
+ * @param desc New description.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool ConcurrentTaskManager::setDescription(int id, std::string_view desc)
+{
+    return bModify(id, [desc](Task &task)
+                   { task.vidSetDescription(desc); });
+}
+
+/**
+ * @brief Sets the due date of a task.
+ *
+ * @param id ID of the task to update.
+ * @param DueDay New due date as a day number, or TASK_NO_DUE_DATE.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool ConcurrentTaskManager::setDueDate(int id, std::int32_t DueDay)
+{
+    return bModify(id, [DueDay](Task &task)
+                   { task.vidSetDueDate(DueDay); });
+}
+
+/**
+ * @brief Sets the priority of a task.
+ *
+ * @param id ID of the task to update.
+ * @param Priority New priority.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool ConcurrentTaskManager::setPriority(int id, TaskPriority Priority)
+{
+    return bModify(id, [Priority](Task &task)
+                   { task.vidSetPriority(Priority); });
+}
+
+/**
+ * @brief Copies a task by its ID.
+ *
+ * @param id ID of the task to look up.
+ * @param Out Receives a copy of the task.
+ * @return true if the task exists, false otherwise.
+ */
+bool ConcurrentTaskManager::bGetTask(int id, Task &Out) const
+{
+    TaskShard &Shard = ShardOf(id);
+    std::shared_lock<std::shared_mutex> Guard(Shard.Lock);
+    auto it = Shard.Index.find(id);
+    if (it == Shard.Index.end())
+    {
+        return false;
+    }
+    Out = Shard.Tasks[it->second];
+    return true;
+}
+
+/**
+ * @brief Gets the number of tasks currently stored.
+ *
+ * @return Number of tasks.
+ */
+std::size_t ConcurrentTaskManager::size(void) const
+{
+    return TaskCount.load();
+}
+
+/**
+ * @brief Lists all current tasks in ID order, in the same layout as TaskManager::listTasks().
+ *
+ * Each shard is formatted into its own buffer under its shared lock, so the
+ * lock is held only while that shard's tasks are formatted. The lines are then
+ * merged by ID and written out with no lock held.
+ *
+ * @param Out Stream to write the listing to.
+ */
+void ConcurrentTaskManager::listTasks(std::ostream &Out) const
+{
+    std::vector<std::string> Buffers(Shards.size());
+    std::vector<std::tuple<int, std::size_t, std::size_t, std::size_t>> Lines;
+    for (std::size_t Index = 0; Index < Shards.size(); ++Index)
+    {
+        std::shared_lock<std::shared_mutex> Guard(Shards[Index]->Lock);
+        for (auto &it : Shards[Index]->Tasks)
+        {
+            std::size_t Begin = Buffers[Index].size();
+            it.vidAppendTo(Buffers[Index]);
+            Lines.emplace_back(it.int32GetTaskID(), Index, Begin, Buffers[Index].size() - Begin);
+        }
+    }
+    if (Lines.empty() == true)
+    {
+        Out << "\nNo Tasks Found !!" << std::endl;
+        return;
+    }
+    std::sort(Lines.begin(), Lines.end());
+
+    std::string Buffer("\n------------------- List Of Tasks -------------------\n");
+    Buffer.reserve(CONCURRENT_TASK_LIST_FLUSH_SIZE + 4096);
+    std::size_t TaskCounter = 0;
+    char CounterText[24];
+    for (auto &[id, Index, Begin, Length] : Lines)
+    {
+        auto CounterEnd = std::to_chars(CounterText, CounterText + sizeof(CounterText), ++TaskCounter).ptr;
+        Buffer.append("Task ").append(CounterText, static_cast<std::size_t>(CounterEnd - CounterText));
+        Buffer.append(" Data ==>\n");
+        Buffer.append(Buffers[Index], Begin, Length).push_back('\n');
+        Buffer.append("------------------------------------------------------\n");
+        if (Buffer.size() >= CONCURRENT_TASK_LIST_FLUSH_SIZE)
+        {
+            Out.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        }
+    }
+    Out.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    Out.flush();
+}
+
+/**
+ * @brief Collects the tasks matching a filter.
+ *
+ * Each shard answers from its secondary index under its shared lock, and the
+ * copies are merged by due date and ID afterwards.
+ *
+ * @param Filter Conditions to match.
+ * @return Copies of the matching tasks ordered by due date and then ID.
+ */
+std::vector<Task> ConcurrentTaskManager::Query(const TaskFilter &Filter) const
+{
+    std::vector<Task> Matches;
+    for (auto &Shard : Shards)
+    {
+        std::shared_lock<std::shared_mutex> Guard(Shard->Lock);
+        for (int id : Shard->FieldIndex.Select(Filter))
+        {
+            Matches.push_back(Shard->Tasks[Shard->Index.at(id)]);
+        }
+    }
+    std::sort(Matches.begin(), Matches.end(), [](const Task &Left, const Task &Right)
+              { return std::make_pair(Left.int32GetDueDay(), Left.int32GetTaskID()) <
+                       std::make_pair(Right.int32GetDueDay(), Right.int32GetTaskID()); });
+    return Matches;
+}
+
+/**
+ * @brief Adds every task of a file, keeping their IDs.
+ *
+ * The file is parsed without any lock held; each task is then put into its
+ * shard, and the ID counter is moved past every loaded ID.
+ *
+ * @param filename Name of the file to load tasks from.
+ * @return true if the file was read, false if it is missing or unreadable.
+ */
+bool ConcurrentTaskManager::LoadTasksFrom(const std::string &filename)
+{
+    TaskList Loaded;
+    int SavedNextId = 0;
+    std::vector<std::size_t> MalformedLines;
+    std::vector<std::size_t> NormalizedLines;
+    if (ReadTaskFile(filename, Loaded, SavedNextId, nullptr, MalformedLines, NormalizedLines) == false)
+    {
+        return false;
+    }
+
+    int LastId = SavedNextId - 1;
+    for (auto &it : Loaded)
+    {
+        vidPut(it);
+        LastId = std::max(LastId, it.int32GetTaskID());
+    }
+    int Current = nextId.load();
+    while (Current <= LastId && nextId.compare_exchange_weak(Current, LastId + 1) == false)
+    {
+    }
+    return true;
+}
+
+/**
+ * @brief Saves all tasks to a file in ID order.
+ *
+ * The tasks are copied one shard at a time under its shared lock, then
+ * written by WriteTaskFile() with no lock held.
+ *
+ * @param filename Name of the file to save tasks to.
+ * @return true on success, false if the file could not be written.
+ */
+bool ConcurrentTaskManager::SaveTasksToFile(const std::string &filename) const
+{
+    TaskList Snapshot;
+    Snapshot.reserve(size());
+    for (auto &Shard : Shards)
+    {
+        std::shared_lock<std::shared_mutex> Guard(Shard->Lock);
+        Snapshot.insert(Snapshot.end(), Shard->Tasks.begin(), Shard->Tasks.end());
+    }
+    int NextId = nextId.load();
+    std::sort(Snapshot.begin(), Snapshot.end(), [](const Task &Left, const Task &Right)
+              { return Left.int32GetTaskID() < Right.int32GetTaskID(); });
+
+    return WriteTaskFile(Snapshot, filename, NextId);
+}
@@ -0,0 +1,225 @@
+/**
+ * @file concurrent_task_manager.hpp
+ * @brief Declaration of the ConcurrentTaskManager class, a thread-safe task store.
+ *
+ * Tasks are spread over shards by ID, and each shard has its own reader/writer
+ * lock, task list, ID index and secondary index. Readers of one shard never
+ * block each other, writers only lock the shard of the task they change, and
+ * operations that span every shard (listing, queries, saving) lock one shard
+ * at a time and merge the results outside the locks. IDs come from a shared
+ * atomic counter, so adding tasks never takes a global lock.
+ *
+ * Each shard is consistent on its own; an operation spanning several shards
+ * may see a writer's change to one shard but not yet to another.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __CONCURRENT__TASK__MANAGER__
+#define __CONCURRENT__TASK__MANAGER__
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "task.hpp"
+#include "task_secondary_index.hpp"
+
+/**
+ * @brief Number of shards used when none is given.
+ */
+constexpr std::size_t CONCURRENT_TASK_DEFAULT_SHARDS = 64;
+
+/**
+ * @class ConcurrentTaskManager
+ * @brief Task store whose operations can all be called from many threads at once.
+ *
+ * Tasks are returned by copy, so results stay valid whatever other threads do.
+ */
+class ConcurrentTaskManager
+{
+private:
+    /**
+     * @struct TaskShard
+     * @brief Tasks whose IDs map to one shard, with the lock guarding them.
+     */
+    struct TaskShard
+    {
+        mutable std::shared_mutex Lock;                     /**< Shared for readers, exclusive for writers. */
+        std::pmr::unsynchronized_pool_resource Arena;       /**< Pool serving the text of the shard's tasks. */
+        TaskList Tasks{&Arena};                             /**< Tasks of the shard, in no particular order. */
+        std::unordered_map<int, std::size_t> Index;         /**< Maps each task ID to its slot in Tasks. */
+        TaskSecondaryIndex FieldIndex;                      /**< Tasks by status, priority and due date. */
+
+        /**
+         * @brief Constructs an empty shard with its secondary index ready.
+         */
+        TaskShard();
+    };
+
+    std::vector<std::unique_ptr<TaskShard>> Shards;    /**< Shards, indexed by task ID modulo their count. */
+    std::atomic<int> nextId{1};                         /**< Next task ID to hand out. */
+    std::atomic<std::size_t> TaskCount{0};              /**< Number of tasks over all shards. */
+
+    /**
+     * @brief Gets the shard a task ID belongs to.
+     *
+     * @param id Task ID.
+     * @return Shard of the ID.
+     */
+    TaskShard &ShardOf(int id) const;
+
+    /**
+     * @brief Applies a change to a task under the exclusive lock of its shard.
+     *
+     * The task is taken out of the shard's secondary index before the change
+     * and put back after it.
+     *
+     * @param id ID of the task to change.
+     * @param Change Callable receiving the task to change.
+     * @return true if the task exists and was changed, false otherwise.
+     */
+    template <typename Function>
+    bool bModify(int id, Function &&Change);
+
+    /**
+     * @brief Adds a task that already has an ID, under the exclusive lock of its shard.
+     *
+     * @param task Task to add; a task with the same ID is replaced.
+     */
+    void vidPut(const Task &task);
+
+public:
+    /**
+     * @brief Constructs an empty task store.
+     *
+     * @param ShardCount Number of shards, or 0 for CONCURRENT_TASK_DEFAULT_SHARDS.
+     */
+    explicit ConcurrentTaskManager(std::size_t ShardCount = 0);
+
+    ConcurrentTaskManager(const ConcurrentTaskManager &) = delete;
+    ConcurrentTaskManager &operator=(const ConcurrentTaskManager &) = delete;
+
+    /**
+     * @brief Adds a new task.
+     *
+     * @param title Title of the task.
+     * @param desc Description of the task.
+     * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+     * @param Priority Priority level of the task.
+     * @return ID of the new task.
+     */
+    int addTask(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority);
+
+    /**
+     * @brief Removes a task by ID.
+     *
+     * @param id ID of the task to remove.
+     * @return true if the task existed and was removed, false otherwise.
+     */
+    bool removeTask(int id);
+
+    /**
+     * @brief Sets the status of a task.
+     *
+     * @param id ID of the task to update.
+     * @param state New status.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setStatus(int id, TaskState state);
+
+    /**
+     * @brief Sets the title of a task.
+     *
+     * @param id ID of the task to update.
+     * @param title New title.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setTitle(int id, std::string_view title);
+
+    /**
+     * @brief Sets the description of a task.
+     *
+     * @param id ID of the task to update.
+     * @param desc New description.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setDescription(int id, std::string_view desc);
+
+    /**
+     * @brief Sets the due date of a task.
+     *
+     * @param id ID of the task to update.
+     * @param DueDay New due date as a day number, or TASK_NO_DUE_DATE.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setDueDate(int id, std::int32_t DueDay);
+
+    /**
+     * @brief Sets the priority of a task.
+     *
+     * @param id ID of the task to update.
+     * @param Priority New priority.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setPriority(int id, TaskPriority Priority);
+
+    /**
+     * @brief Copies a task by its ID.
+     *
+     * @param id ID of the task to look up.
+     * @param Out Receives a copy of the task.
+     * @return true if the task exists, false otherwise.
+     */
+    bool bGetTask(int id, Task &Out) const;
+
+    /**
+     * @brief Gets the number of tasks currently stored.
+     *
+     * @return Number of tasks.
+     */
+    std::size_t size(void) const;
+
+    /**
+     * @brief Lists all current tasks in ID order, in the same layout as TaskManager::listTasks().
+     *
+     * @param Out Stream to write the listing to.
+     */
+    void listTasks(std::ostream &Out = std::cout) const;
+
+    /**
+     * @brief Collects the tasks matching a filter.
+     *
+     * @param Filter Conditions to match.
+     * @return Copies of the matching tasks ordered by due date and then ID.
+     */
+    std::vector<Task> Query(const TaskFilter &Filter) const;
+
+    /**
+     * @brief Adds every task of a file, keeping their IDs.
+     *
+     * The file format is chosen by extension, as for TaskManager::LoadTasksFrom().
+     *
+     * @param filename Name of the file to load tasks from.
+     * @return true if the file was read, false if it is missing or unreadable.
+     */
+    bool LoadTasksFrom(const std::string &filename);
+
+    /**
+     * @brief Saves all tasks to a file in ID order.
+     *
+     * The file format is chosen by extension, as for TaskManager::SaveTasksToFile().
+     *
+     * @param filename Name of the file to save tasks to.
+     * @return true on success, false if the file could not be written.
+     */
+    bool SaveTasksToFile(const std::string &filename) const;
+};
+
+#endif // __CONCURRENT__TASK__MANAGER__
@@ -11,20 +11,178 @@
  */
 
 #include "task_manager.hpp"
+#include "task_batch.hpp"
+#include "task_server.hpp"
+#include "task_metrics.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <memory>
 #include <limits>
 
 /**
  * @brief Main function to drive the task manager application.
  *
  * Provides a console-based menu to perform various task-related operations.
- * Loads tasks from file at startup and saves them on exit.
+ * Loads tasks from file at startup and replays its journal. Every change is then
+ * appended to the journal as it happens, so exiting only needs to sync it.
  *
+ * Supported command-line options:
+ * - --file <path>: Use the given task file instead of tasks.txt (".bin" selects the binary format, ".tdb" the paged
+ *   format and ".tsnap" a compressed snapshot; any other name is a text file).
+ * - --lazy <tasks>: Load a snapshot (".tsnap") file as a compact index of its tasks, keeping at most the given number
+ *   of tasks read from the file in memory and reading the others as they are needed.
+ * - --convert <from> <to>: Convert a task file between the text, binary (".bin"), paged (".tdb") and snapshot (".tsnap")
+ *   formats, each chosen by its extension, and exit.
+ * - --batch <path>: Run the batch commands in the given file ("-" for standard input) and exit.
+ * - --serve <address>: Keep the tasks loaded and serve batch commands on a socket until SIGINT or SIGTERM.
+ * - --connect <address>: Send the batch commands (standard input unless --batch is given) to a server and exit.
+ * - --metrics <path>: Write the operation metrics to the given file in the Prometheus text format, periodically and on exit.
+ * - --metrics-interval <seconds>: Time between two metrics writes (10 by default).
+ *
+ * Addresses are "tcp:<port>" for a localhost TCP port, or the path of a Unix socket.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Command-line arguments.
  * @return int Exit status code.
  */
-int main()
+int main(int argc, char *argv[])
 {
+    std::string TaskFile = "tasks.txt";
+    std::string BatchFile;
+    std::string ServeAddress;
+    std::string ConnectAddress;
+    std::string MetricsFile;
+    int MetricsInterval = 10;
+    std::size_t LazyBodies = 0;
+    for (int Arg = 1; Arg < argc; ++Arg)
+    {
+        std::string Option = argv[Arg];
+        if (Option == "--file" && Arg + 1 < argc)
+        {
+            TaskFile = argv[++Arg];
+        }
+        else if (Option == "--batch" && Arg + 1 < argc)
+        {
+            BatchFile = argv[++Arg];
+        }
+        else if (Option == "--serve" && Arg + 1 < argc)
+        {
+            ServeAddress = argv[++Arg];
+        }
+        else if (Option == "--connect" && Arg + 1 < argc)
+        {
+            ConnectAddress = argv[++Arg];
+        }
+        else if (Option == "--metrics" && Arg + 1 < argc)
+        {
+            MetricsFile = argv[++Arg];
+        }
+        else if (Option == "--metrics-interval" && Arg + 1 < argc && std::atoi(argv[Arg + 1]) > 0)
+        {
+            MetricsInterval = std::atoi(argv[++Arg]);
+        }
+        else if (Option == "--lazy" && Arg + 1 < argc && std::atoi(argv[Arg + 1]) > 0)
+        {
+            LazyBodies = static_cast<std::size_t>(std::atoi(argv[++Arg]));
+        }
+        else if (Option == "--convert" && Arg + 2 < argc)
+        {
+            return ConvertTaskFile(argv[Arg + 1], argv[Arg + 2]) ? 0 : 1;
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--file <path>] [--batch <path>] [--serve <address>] [--connect <address>] [--metrics <path> [--metrics-interval <seconds>]] [--lazy <tasks>] [--convert <from> <to>]" << std::endl;
+            std::cerr << "Task files ending in .bin, .tdb or .tsnap use the binary, paged or snapshot format, any other a text file" << std::endl;
+            return 1;
+        }
+    }
+
+    if (ConnectAddress.empty() == false)    /*Thin Client: The Server Holds The Tasks, Nothing Is Loaded Here*/
+    {
+        std::size_t Failed = 0;
+        bool Done = false;
+        if (BatchFile.empty() == true || BatchFile == "-")
+        {
+            Done = bRunTaskClient(ConnectAddress, std::cin, std::cout, Failed);
+        }
+        else
+        {
+            std::ifstream Batch(BatchFile);
+            if (!Batch)
+            {
+                std::cerr << "Error While Opening The Batch File" << std::endl;
+                return 1;
+            }
+            Done = bRunTaskClient(ConnectAddress, Batch, std::cout, Failed);
+        }
+        return (Done == false) ? 1 : ((Failed == 0) ? 0 : 2);
+    }
+
+    if (ServeAddress.empty() == false)
+    {
+        vidBlockTaskServerSignals();    /*Before Any Thread Starts, So Every Thread Inherits The Mask*/
+    }
+
+    std::unique_ptr<MetricsDumper> Metrics;    /*Destroyed On Every Return Below, Which Writes The Final Figures*/
+    if (MetricsFile.empty() == false)
+    {
+        Metrics = std::make_unique<MetricsDumper>(MetricsFile, std::chrono::seconds(MetricsInterval));
+    }
+
     TaskManager manager;
-    manager.LoadTasksFrom("tasks.txt");
+    manager.SetLazyLoading(LazyBodies);
+    manager.LoadTasksFrom(TaskFile);
+    bool Journaled = manager.OpenJournal(TaskFile);   /*Mutations Are Persisted To The Journal As They Happen*/
+
+    if (ServeAddress.empty() == false)
+    {
+        bool Served = false;
+        {
+            TaskServer Server(manager);
+            Served = Server.bListen(ServeAddress);
+            if (Served == true)
+            {
+                Server.vidRun();
+            }
+        }
+        if (Journaled == true)
+        {
+            manager.CloseJournal();
+        }
+        else if (Served == true)
+        {
+            manager.SaveTasksToFile(TaskFile);
+        }
+        return (Served == true) ? 0 : 1;
+    }
+
+    if (BatchFile.empty() == false)
+    {
+        std::size_t Failed = 0;
+        if (BatchFile == "-")
+        {
+            Failed = RunTaskBatch(manager, std::cin, std::cout);
+        }
+        else
+        {
+            std::ifstream Batch(BatchFile);
+            if (!Batch)
+            {
+                std::cerr << "Error While Opening The Batch File" << std::endl;
+                return 1;
+            }
+            Failed = RunTaskBatch(manager, Batch, std::cout);
+        }
+        if (Journaled == true)
+        {
+            manager.CloseJournal();
+        }
+        else
+        {
+            manager.SaveTasksToFile(TaskFile);
+        }
+        return (Failed == 0) ? 0 : 2;
+    }
 
     int choice;
     bool condition = true;
@@ -50,9 +208,9 @@ int main()
                 std::getline(std::cin, TaskTitle);
                 std::cout << "Task Description: ";
                 std::getline(std::cin, TaskDescription);
-                std::cout << "Task Due Date: ";
+                std::cout << "Task Due Date (YYYY-MM-DD): ";
                 std::getline(std::cin, TaskDueDate);
-                std::cout << "Task Priority: ";
+                std::cout << "Task Priority (Low, Medium Or High): ";
                 std::getline(std::cin, TaskPriority);
 
                 manager.addTask(TaskTitle, TaskDescription, TaskDueDate, TaskPriority);
@@ -112,6 +270,13 @@ int main()
         }
     }
 
-    manager.SaveTasksToFile("tasks.txt");
+    if (Journaled == true)
+    {
+        manager.CloseJournal();
+    }
+    else
+    {
+        manager.SaveTasksToFile(TaskFile);
+    }
     return 0;
 }
@@ -0,0 +1,107 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implementation of the MappedFile class.
+ *
+ * Uses mmap() where available and falls back to reading the file into memory.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "mapped_file.hpp"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TASK_HAS_MMAP 1
+#else
+#define TASK_HAS_MMAP 0
+#endif
+
+/**
+ * @brief Opens and maps the given file.
+ *
+ * Empty files are reported as open with an empty view, since a zero-length
+ * mapping cannot be created.
+ *
+ * @param filename Name of the file to map.
+ */
+MappedFile::MappedFile(const std::string &filename)
+{
+#if TASK_HAS_MMAP
+    int Descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (Descriptor < 0)
+    {
+        return;
+    }
+    struct stat FileInfo;
+    if (::fstat(Descriptor, &FileInfo) == 0)
+    {
+        Size = static_cast<std::size_t>(FileInfo.st_size);
+        if (Size == 0)
+        {
+            Open = true;
+        }
+        else
+        {
+            void *Mapping = ::mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, Descriptor, 0);
+            if (Mapping != MAP_FAILED)
+            {
+                ::madvise(Mapping, Size, MADV_SEQUENTIAL);
+                Data = static_cast<const char *>(Mapping);
+                Mapped = true;
+                Open = true;
+            }
+        }
+    }
+    ::close(Descriptor);
+#else
+    std::ifstream FileHandler(filename, std::ios::binary | std::ios::ate);
+    if (!FileHandler)
+    {
+        return;
+    }
+    Fallback.resize(static_cast<std::size_t>(FileHandler.tellg()));
+    FileHandler.seekg(0);
+    FileHandler.read(&Fallback[0], static_cast<std::streamsize>(Fallback.size()));
+    Data = Fallback.data();
+    Size = Fallback.size();
+    Open = static_cast<bool>(FileHandler);
+#endif
+}
+
+/**
+ * @brief Tells whether the file was opened successfully.
+ *
+ * @return true if the content is available, false otherwise.
+ */
+bool MappedFile::bIsOpen(void) const
+{
+    return Open;
+}
+
+/**
+ * @brief Gets a view over the whole file content.
+ *
+ * @return View over the file bytes (empty for an empty or unopened file).
+ */
+std::string_view MappedFile::View(void) const
+{
+    return (Data == nullptr) ? std::string_view() : std::string_view(Data, Size);
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+#if TASK_HAS_MMAP
+    if (Mapped == true)
+    {
+        ::munmap(const_cast<char *>(Data), Size);
+    }
+#endif
+}
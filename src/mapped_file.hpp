@@ -0,0 +1,65 @@
+/**
+ * @file mapped_file.hpp
+ * @brief Declaration of the MappedFile class giving read-only, zero-copy access to a file.
+ *
+ * On POSIX systems the file is memory-mapped, so parsers can work directly on the
+ * page cache without copying it into process buffers. On other systems the file
+ * is read into memory with a single read instead.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __MAPPED__FILE__
+#define __MAPPED__FILE__
+
+#include <string>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Read-only view over the whole content of a file.
+ *
+ * The view stays valid for the lifetime of the MappedFile object.
+ */
+class MappedFile
+{
+private:
+    const char *Data = nullptr; /**< First byte of the file content. */
+    std::size_t Size = 0;       /**< Number of bytes in the file. */
+    bool Mapped = false;        /**< true if Data points into a memory mapping. */
+    bool Open = false;          /**< true if the file was opened successfully. */
+    std::string Fallback;       /**< File content when memory mapping is not available. */
+
+public:
+    /**
+     * @brief Opens and maps the given file.
+     *
+     * @param filename Name of the file to map.
+     */
+    explicit MappedFile(const std::string &filename);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Tells whether the file was opened successfully.
+     *
+     * @return true if the content is available, false otherwise.
+     */
+    bool bIsOpen(void) const;
+
+    /**
+     * @brief Gets a view over the whole file content.
+     *
+     * @return View over the file bytes (empty for an empty or unopened file).
+     */
+    std::string_view View(void) const;
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+};
+
+#endif // __MAPPED__FILE__
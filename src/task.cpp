@@ -11,6 +11,200 @@
  */
 
 #include "task.hpp"
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+
+/**
+ * @brief Compares two strings ignoring ASCII letter case.
+ *
+ * @param Left First string.
+ * @param Right Second string.
+ * @return true if both strings are equal ignoring case.
+ */
+static bool EqualsIgnoreCase(std::string_view Left, std::string_view Right)
+{
+    if (Left.size() != Right.size())
+    {
+        return false;
+    }
+    for (std::size_t Index = 0; Index < Left.size(); ++Index)
+    {
+        if (std::tolower(static_cast<unsigned char>(Left[Index])) != std::tolower(static_cast<unsigned char>(Right[Index])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Parses a task status name ("Pending" or "Done", any letter case).
+ *
+ * @param Text Status name to parse.
+ * @param State Receives the parsed status.
+ * @return true if the name was recognized, false otherwise.
+ */
+bool ParseTaskState(std::string_view Text, TaskState &State)
+{
+    if (EqualsIgnoreCase(Text, "Pending") == true)
+    {
+        State = TaskState::Pending;
+        return true;
+    }
+    if (EqualsIgnoreCase(Text, "Done") == true)
+    {
+        State = TaskState::Done;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the display name of a task status.
+ *
+ * @param State Status to name.
+ * @return "Pending" or "Done".
+ */
+const char *TaskStateName(TaskState State)
+{
+    return (State == TaskState::Done) ? "Done" : "Pending";
+}
+
+/**
+ * @brief Parses a priority name ("Low", "Medium", "High" or "L", "M", "H", any letter case).
+ *
+ * @param Text Priority name to parse.
+ * @param Priority Receives the parsed priority.
+ * @return true if the name was recognized, false otherwise.
+ */
+bool ParseTaskPriority(std::string_view Text, TaskPriority &Priority)
+{
+    if (Text.empty() == true)
+    {
+        Priority = TaskPriority::Unknown;
+    }
+    else if (EqualsIgnoreCase(Text, "Low") == true || EqualsIgnoreCase(Text, "L") == true)
+    {
+        Priority = TaskPriority::Low;
+    }
+    else if (EqualsIgnoreCase(Text, "Medium") == true || EqualsIgnoreCase(Text, "M") == true)
+    {
+        Priority = TaskPriority::Medium;
+    }
+    else if (EqualsIgnoreCase(Text, "High") == true || EqualsIgnoreCase(Text, "H") == true)
+    {
+        Priority = TaskPriority::High;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the display name of a priority level.
+ *
+ * @param Priority Priority to name.
+ * @return "Low", "Medium", "High", or an empty string for an unknown priority.
+ */
+const char *TaskPriorityName(TaskPriority Priority)
+{
+    switch (Priority)
+    {
+    case TaskPriority::Low:
+        return "Low";
+    case TaskPriority::Medium:
+        return "Medium";
+    case TaskPriority::High:
+        return "High";
+    default:
+        return "";
+    }
+}
+
+/**
+ * @brief Parses a due date in the "YYYY-MM-DD" form into a day number.
+ *
+ * Uses the proleptic Gregorian calendar; the day count follows Howard Hinnant's
+ * days_from_civil algorithm.
+ *
+ * @param Text Date to parse.
+ * @param Day Receives the day number.
+ * @return true if the text is empty or a valid calendar date, false otherwise.
+ */
+bool ParseDueDate(std::string_view Text, std::int32_t &Day)
+{
+    if (Text.empty() == true)
+    {
+        Day = TASK_NO_DUE_DATE;
+        return true;
+    }
+    if (Text.size() != 10 || Text[4] != '-' || Text[7] != '-')
+    {
+        return false;
+    }
+    int Digits[8];
+    const int Positions[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+    for (int Index = 0; Index < 8; ++Index)
+    {
+        char Character = Text[Positions[Index]];
+        if (Character < '0' || Character > '9')
+        {
+            return false;
+        }
+        Digits[Index] = Character - '0';
+    }
+    int Year = Digits[0] * 1000 + Digits[1] * 100 + Digits[2] * 10 + Digits[3];
+    int Month = Digits[4] * 10 + Digits[5];
+    int DayOfMonth = Digits[6] * 10 + Digits[7];
+
+    static const int DaysInMonth[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool LeapYear = (Year % 4 == 0 && Year % 100 != 0) || Year % 400 == 0;
+    if (Month < 1 || Month > 12 || DayOfMonth < 1 ||
+        DayOfMonth > DaysInMonth[Month - 1] + ((Month == 2 && LeapYear) ? 1 : 0))
+    {
+        return false;
+    }
+
+    Year -= (Month <= 2) ? 1 : 0;
+    int Era = (Year >= 0 ? Year : Year - 399) / 400;
+    int YearOfEra = Year - Era * 400;
+    int DayOfYear = (153 * (Month + (Month > 2 ? -3 : 9)) + 2) / 5 + DayOfMonth - 1;
+    int DayOfEra = YearOfEra * 365 + YearOfEra / 4 - YearOfEra / 100 + DayOfYear;
+    Day = Era * 146097 + DayOfEra - 719468;
+    return true;
+}
+
+/**
+ * @brief Formats a day number back into the "YYYY-MM-DD" form.
+ *
+ * Inverse of ParseDueDate(), following Howard Hinnant's civil_from_days algorithm.
+ *
+ * @param Day Day number to format.
+ * @return The date, or an empty string for TASK_NO_DUE_DATE.
+ */
+std::string FormatDueDate(std::int32_t Day)
+{
+    if (Day == TASK_NO_DUE_DATE)
+    {
+        return std::string();
+    }
+    int Shifted = Day + 719468;
+    int Era = (Shifted >= 0 ? Shifted : Shifted - 146096) / 146097;
+    int DayOfEra = Shifted - Era * 146097;
+    int YearOfEra = (DayOfEra - DayOfEra / 1460 + DayOfEra / 36524 - DayOfEra / 146096) / 365;
+    int DayOfYear = DayOfEra - (365 * YearOfEra + YearOfEra / 4 - YearOfEra / 100);
+    int MonthIndex = (5 * DayOfYear + 2) / 153;
+    int DayOfMonth = DayOfYear - (153 * MonthIndex + 2) / 5 + 1;
+    int Month = MonthIndex + (MonthIndex < 10 ? 3 : -9);
+    int Year = YearOfEra + Era * 400 + (Month <= 2 ? 1 : 0);
+
+    char Buffer[32];
+    std::snprintf(Buffer, sizeof(Buffer), "%04d-%02d-%02d", Year, Month, DayOfMonth);
+    return std::string(Buffer);
+}
 
 /**
  * @brief Default constructor for Task.
@@ -25,16 +219,117 @@ Task::Task() = default;
  * @param id Unique identifier for the task.
  * @param title Title of the task.
  * @param desc Description of the task.
- * @param dueDate Due date of the task.
+ * @param dueDay Due date of the task as a day number.
  * @param priority Priority level of the task.
+ * @param Allocator Allocator for the title and description.
+ */
+Task::Task(int id, std::string_view title, std::string_view desc, std::int32_t dueDay, TaskPriority priority,
+           const allocator_type &Allocator)
+    : title(title, Allocator), description(desc, Allocator)
+{
+    this->id = id;
+    this->dueDay = dueDay;
+    this->priority = priority;
+}
+
+/**
+ * @brief Constructs an empty task whose text uses the given allocator.
+ *
+ * @param Allocator Allocator for the title and description.
+ */
+Task::Task(const allocator_type &Allocator) : title(Allocator), description(Allocator)
+{
+}
+
+/**
+ * @brief Copy constructor for Task.
+ *
+ * @param Other Task to copy.
+ */
+Task::Task(const Task &Other)
+    : id(Other.id), dueDay(Other.dueDay), priority(Other.priority), TaskStatus(Other.TaskStatus), Removed(Other.Removed),
+      Raw((Other.Raw != nullptr) ? std::make_unique<TaskRawFields>(*Other.Raw) : nullptr),
+      title(Other.title), description(Other.description)
+{
+}
+
+/**
+ * @brief Copy constructor placing the copied text in the given allocator.
+ *
+ * @param Other Task to copy.
+ * @param Allocator Allocator for the title and description.
+ */
+Task::Task(const Task &Other, const allocator_type &Allocator)
+    : id(Other.id), dueDay(Other.dueDay), priority(Other.priority), TaskStatus(Other.TaskStatus), Removed(Other.Removed),
+      Raw((Other.Raw != nullptr) ? std::make_unique<TaskRawFields>(*Other.Raw) : nullptr),
+      title(Other.title, Allocator), description(Other.description, Allocator)
+{
+}
+
+/**
+ * @brief Move constructor placing the text in the given allocator.
+ *
+ * @param Other Task to move from.
+ * @param Allocator Allocator for the title and description.
+ */
+Task::Task(Task &&Other, const allocator_type &Allocator)
+    : id(Other.id), dueDay(Other.dueDay), priority(Other.priority), TaskStatus(Other.TaskStatus), Removed(Other.Removed),
+      Raw(std::move(Other.Raw)), title(std::move(Other.title), Allocator), description(std::move(Other.description), Allocator)
+{
+}
+
+/**
+ * @brief Copy assignment; the task keeps its own allocator.
+ *
+ * @param Other Task to copy.
+ * @return Reference to this task.
+ */
+Task &Task::operator=(const Task &Other)
+{
+    id = Other.id;
+    dueDay = Other.dueDay;
+    priority = Other.priority;
+    TaskStatus = Other.TaskStatus;
+    Removed = Other.Removed;
+    Raw = (Other.Raw != nullptr) ? std::make_unique<TaskRawFields>(*Other.Raw) : nullptr;
+    title = Other.title;
+    description = Other.description;
+    return *this;
+}
+
+/**
+ * @brief Gets the allocator used for the task text.
+ *
+ * @return Allocator of the title and description.
+ */
+Task::allocator_type Task::get_allocator(void) const
+{
+    return title.get_allocator();
+}
+
+/**
+ * @brief Replaces every field of the task, reusing the storage of its text.
+ *
+ * Only a title or description longer than the current capacity allocates.
+ *
+ * @param id Task ID.
+ * @param title Task title.
+ * @param desc Task description.
+ * @param dueDay Task due date as a day number.
+ * @param priority Task priority level.
+ * @param status Task status.
  */
-Task::Task(int id, std::string title, std::string desc, std::string dueDate, std::string priority)
+void Task::vidAssign(int id, std::string_view title, std::string_view desc, std::int32_t dueDay, TaskPriority priority,
+                     TaskState status)
 {
     this->id = id;
-    this->title = title;
-    this->description = desc;
-    this->dueDate = dueDate;
+    this->title.assign(title);
+    this->description.assign(desc);
+    this->dueDay = dueDay;
     this->priority = priority;
+    this->TaskStatus = status;
+    this->Removed = false;
+    this->Raw.reset();
 }
 
 /**
@@ -42,7 +337,7 @@ Task::Task(int id, std::string title, std::string desc, std::string dueDate, std
  */
 void Task::markDone(void)
 {
-    this->TaskStatus = "Done";
+    this->TaskStatus = TaskState::Done;
 }
 
 /**
@@ -50,7 +345,29 @@ void Task::markDone(void)
  */
 void Task::markPending(void)
 {
-    this->TaskStatus = "Pending";
+    this->TaskStatus = TaskState::Pending;
+}
+
+/**
+ * @brief Turns the task into a tombstone and releases its text.
+ */
+void Task::vidMarkRemoved(void)
+{
+    this->Removed = true;
+    this->title.clear();
+    this->title.shrink_to_fit();
+    this->description.clear();
+    this->description.shrink_to_fit();
+}
+
+/**
+ * @brief Tells whether the task has been deleted.
+ *
+ * @return true if the task is a tombstone.
+ */
+bool Task::bIsRemoved(void) const
+{
+    return this->Removed;
 }
 
 /**
@@ -61,15 +378,31 @@ void Task::markPending(void)
 std::string Task::toString(void) const
 {
     std::string TaskDetails;
-    TaskDetails = "ID: " + std::to_string(id) + '\n' +
-                  "Title: " + this->title + '\n' +
-                  "Description: " + this->description + '\n' +
-                  "Due Date: " + this->dueDate + '\n' +
-                  "Priority: " + this->priority + '\n' +
-                  "Status: " + this->TaskStatus;
+    TaskDetails.reserve(80 + title.size() + description.size());
+    vidAppendTo(TaskDetails);
     return TaskDetails;
 }
 
+/**
+ * @brief Appends the string representation of the task to a buffer.
+ *
+ * Formats in place with no temporary strings, so listing many tasks into one
+ * reused buffer does not allocate per task.
+ *
+ * @param Buffer Buffer the formatted task details are appended to.
+ */
+void Task::vidAppendTo(std::string &Buffer) const
+{
+    char IdText[16];
+    auto IdEnd = std::to_chars(IdText, IdText + sizeof(IdText), id).ptr;
+    Buffer.append("ID: ").append(IdText, static_cast<std::size_t>(IdEnd - IdText));
+    Buffer.append("\nTitle: ").append(title);
+    Buffer.append("\nDescription: ").append(description);
+    Buffer.append("\nDue Date: ").append(FormatDueDate(dueDay));
+    Buffer.append("\nPriority: ").append(TaskPriorityName(priority));
+    Buffer.append("\nStatus: ").append(TaskStateName(TaskStatus));
+}
+
 /**
  * @brief Gets the ID of the task.
  *
@@ -83,9 +416,19 @@ int Task::int32GetTaskID(void) const
 /**
  * @brief Gets the current status of the task.
  *
- * @return Task status as a string ("Done" or "Pending").
+ * @return Task status name ("Done" or "Pending").
+ */
+std::string_view Task::GetTaskStatus(void) const
+{
+    return TaskStateName(this->TaskStatus);
+}
+
+/**
+ * @brief Gets the current status of the task.
+ *
+ * @return Task status as an enum value.
  */
-std::string Task::GetTaskStatus(void) const
+TaskState Task::GetTaskState(void) const
 {
     return this->TaskStatus;
 }
@@ -95,7 +438,7 @@ std::string Task::GetTaskStatus(void) const
  *
  * @param status New status value for the task.
  */
-void Task::vidSetTaskStatus(std::string status)
+void Task::vidSetTaskStatus(TaskState status)
 {
     this->TaskStatus = status;
 }
@@ -103,9 +446,9 @@ void Task::vidSetTaskStatus(std::string status)
 /**
  * @brief Gets the title of the task.
  *
- * @return Task title as a string.
+ * @return View of the task title, valid until the task is modified.
  */
-std::string Task::int32GetTaskTitle(void) const
+std::string_view Task::int32GetTaskTitle(void) const
 {
     return title;
 }
@@ -113,9 +456,9 @@ std::string Task::int32GetTaskTitle(void) const
 /**
  * @brief Gets the description of the task.
  *
- * @return Task description as a string.
+ * @return View of the task description, valid until the task is modified.
  */
-std::string Task::int32GetTaskDescription(void) const
+std::string_view Task::int32GetTaskDescription(void) const
 {
     return description;
 }
@@ -123,19 +466,47 @@ std::string Task::int32GetTaskDescription(void) const
 /**
  * @brief Gets the due date of the task.
  *
- * @return Due date as a string.
+ * @return Due date as a "YYYY-MM-DD" string, empty if the task has none, or the unrecognized text it was read with.
  */
 std::string Task::int32GetTaskdueDate(void) const
 {
-    return dueDate;
+    if (Raw != nullptr && Raw->DueDate.empty() == false)
+    {
+        return Raw->DueDate;
+    }
+    return FormatDueDate(dueDay);
+}
+
+/**
+ * @brief Gets the due date of the task as a day number.
+ *
+ * @return Days since 1970-01-01, or TASK_NO_DUE_DATE.
+ */
+std::int32_t Task::int32GetDueDay(void) const
+{
+    return dueDay;
+}
+
+/**
+ * @brief Gets the priority of the task.
+ *
+ * @return Priority name, empty if the priority is unknown, or the unrecognized text it was read with.
+ */
+std::string_view Task::int32GetTaskpriority(void) const
+{
+    if (Raw != nullptr && Raw->Priority.empty() == false)
+    {
+        return Raw->Priority;
+    }
+    return TaskPriorityName(priority);
 }
 
 /**
  * @brief Gets the priority of the task.
  *
- * @return Priority as a string.
+ * @return Priority as an enum value.
  */
-std::string Task::int32GetTaskpriority(void) const
+TaskPriority Task::GetTaskPriority(void) const
 {
     return priority;
 }
@@ -145,7 +516,7 @@ std::string Task::int32GetTaskpriority(void) const
  *
  * @param strNewTitle New title string to assign.
  */
-void Task::vidSetTitle(std::string strNewTitle)
+void Task::vidSetTitle(std::string_view strNewTitle)
 {
     this->title = strNewTitle;
 }
@@ -155,7 +526,7 @@ void Task::vidSetTitle(std::string strNewTitle)
  *
  * @param strNewDescription New description string to assign.
  */
-void Task::vidSetDescription(std::string strNewDescription)
+void Task::vidSetDescription(std::string_view strNewDescription)
 {
     this->description = strNewDescription;
 }
@@ -163,21 +534,80 @@ void Task::vidSetDescription(std::string strNewDescription)
 /**
  * @brief Sets the due date of the task.
  *
- * @param strNewDueDate New due date string to assign.
+ * @param NewDueDay New due date as a day number.
  */
-void Task::vidSetDueDate(std::string strNewDueDate)
+void Task::vidSetDueDate(std::int32_t NewDueDay)
 {
-    this->dueDate = strNewDueDate;
+    this->dueDay = NewDueDay;
+    if (Raw != nullptr)
+    {
+        vidKeepRawFields(std::string_view(), Raw->Priority);
+    }
 }
 
 /**
  * @brief Sets the priority of the task.
  *
- * @param strNewPriority New priority string to assign.
+ * @param NewPriority New priority to assign.
+ */
+void Task::vidSetPriority(TaskPriority NewPriority)
+{
+    this->priority = NewPriority;
+    if (Raw != nullptr)
+    {
+        vidKeepRawFields(Raw->DueDate, std::string_view());
+    }
+}
+
+/**
+ * @brief Keeps the text of a due date or priority that could not be parsed.
+ *
+ * The text is only allocated for the rare task that has any.
+ *
+ * @param DueDate Unrecognized due date text, or empty if the due date was parsed.
+ * @param Priority Unrecognized priority text, or empty if the priority was parsed.
+ */
+void Task::vidKeepRawFields(std::string_view DueDate, std::string_view Priority)
+{
+    if (DueDate.empty() == true && Priority.empty() == true)
+    {
+        Raw.reset();
+        return;
+    }
+    std::unique_ptr<TaskRawFields> Fields = std::make_unique<TaskRawFields>();
+    Fields->DueDate.assign(DueDate);
+    Fields->Priority.assign(Priority);
+    Raw = std::move(Fields);    /*The Views May Point Into The Old Fields*/
+}
+
+/**
+ * @brief Tells whether the task holds unrecognized due date or priority text.
+ *
+ * @return true if a field is kept as text.
+ */
+bool Task::bHasRawFields(void) const
+{
+    return Raw != nullptr;
+}
+
+/**
+ * @brief Gets the unrecognized due date text of the task.
+ *
+ * @return Due date text, empty if the due date was parsed.
+ */
+std::string_view Task::GetRawDueDate(void) const
+{
+    return (Raw != nullptr) ? std::string_view(Raw->DueDate) : std::string_view();
+}
+
+/**
+ * @brief Gets the unrecognized priority text of the task.
+ *
+ * @return Priority text, empty if the priority was parsed.
  */
-void Task::vidSetPriority(std::string strNewPriority)
+std::string_view Task::GetRawPriority(void) const
 {
-    this->priority = strNewPriority;
+    return (Raw != nullptr) ? std::string_view(Raw->Priority) : std::string_view();
 }
 
 /**
@@ -3,7 +3,8 @@
  * @brief Declaration of the Task class representing individual tasks.
  *
  * The Task class encapsulates task-related data such as ID, title, description,
- * due date, priority, and status. It provides methods to access and modify these fields,
+ * due date, priority, and status. Status and priority are stored as one-byte enums
+ * and the due date as a day number, so they compare without string operations. It provides methods to access and modify these fields,
  * as well as utility functions like marking as done/pending and converting to string format.
  * 
  * @author Mohamed Waaer
@@ -14,20 +15,133 @@
 #define __TASK__
 
 #include <iostream>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @enum TaskState
+ * @brief Completion states a task can be in.
+ */
+enum class TaskState : std::uint8_t
+{
+    Pending,    /**< Task is still open. */
+    Done        /**< Task has been completed. */
+};
+
+/**
+ * @enum TaskPriority
+ * @brief Priority levels a task can have.
+ */
+enum class TaskPriority : std::uint8_t
+{
+    Unknown,    /**< Priority was not given or not recognized. */
+    Low,        /**< Low priority. */
+    Medium,     /**< Medium priority. */
+    High        /**< High priority. */
+};
+
+/**
+ * @brief Day number used for tasks without a due date.
+ *
+ * It sorts after every real date, so undated tasks come last in date order.
+ */
+constexpr std::int32_t TASK_NO_DUE_DATE = std::numeric_limits<std::int32_t>::max();
+
+/**
+ * @brief Parses a task status name ("Pending" or "Done", any letter case).
+ *
+ * @param Text Status name to parse.
+ * @param State Receives the parsed status.
+ * @return true if the name was recognized, false otherwise.
+ */
+bool ParseTaskState(std::string_view Text, TaskState &State);
+
+/**
+ * @brief Gets the display name of a task status.
+ *
+ * @param State Status to name.
+ * @return "Pending" or "Done".
+ */
+const char *TaskStateName(TaskState State);
+
+/**
+ * @brief Parses a priority name ("Low", "Medium", "High" or "L", "M", "H", any letter case).
+ *
+ * An empty text means "no priority" and parses as TaskPriority::Unknown.
+ *
+ * @param Text Priority name to parse.
+ * @param Priority Receives the parsed priority.
+ * @return true if the name was recognized, false otherwise.
+ */
+bool ParseTaskPriority(std::string_view Text, TaskPriority &Priority);
+
+/**
+ * @brief Gets the display name of a priority level.
+ *
+ * @param Priority Priority to name.
+ * @return "Low", "Medium", "High", or an empty string for an unknown priority.
+ */
+const char *TaskPriorityName(TaskPriority Priority);
+
+/**
+ * @brief Parses a due date in the "YYYY-MM-DD" form into a day number.
+ *
+ * Day numbers count days since 1970-01-01, so they compare like the dates they
+ * stand for. An empty text means "no due date" and parses as TASK_NO_DUE_DATE.
+ *
+ * @param Text Date to parse.
+ * @param Day Receives the day number.
+ * @return true if the text is empty or a valid calendar date, false otherwise.
+ */
+bool ParseDueDate(std::string_view Text, std::int32_t &Day);
+
+/**
+ * @brief Formats a day number back into the "YYYY-MM-DD" form.
+ *
+ * @param Day Day number to format.
+ * @return The date, or an empty string for TASK_NO_DUE_DATE.
+ */
+std::string FormatDueDate(std::int32_t Day);
+
+/**
+ * @struct TaskRawFields
+ * @brief Due date and priority text of a task that could not be parsed.
+ *
+ * Kept with the task so saving it as text writes the text back as it was
+ * read. An empty field was parsed normally.
+ */
+struct TaskRawFields
+{
+    std::string DueDate;    /**< Unrecognized due date text, or empty. */
+    std::string Priority;   /**< Unrecognized priority text, or empty. */
+};
 
 /**
  * @class Task
  * @brief Represents a single task in the task management system.
+ *
+ * The title and description are allocated through a polymorphic allocator, so a
+ * container of tasks can keep all of their text in one memory resource (see TaskList).
  */
 class Task
 {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<char>;  /**< Allocator used for the task text. */
+
 private:
     int id = 0;                     /**< Unique identifier of the task. */
-    std::string title = "";         /**< Title of the task. */
-    std::string description = "";   /**< Description of the task. */
-    std::string dueDate = "";       /**< Due date of the task. */
-    std::string priority = "";      /**< Priority level of the task. */
-    std::string TaskStatus = "Pending"; /**< Current status of the task (e.g., Pending, Done). */
+    std::int32_t dueDay = TASK_NO_DUE_DATE;         /**< Due date of the task, as a day number. */
+    TaskPriority priority = TaskPriority::Unknown;  /**< Priority level of the task. */
+    TaskState TaskStatus = TaskState::Pending;      /**< Current status of the task (Pending or Done). */
+    bool Removed = false;           /**< true once the task is deleted and only its slot remains. */
+    std::unique_ptr<TaskRawFields> Raw;             /**< Unrecognized due date and priority text, or nullptr for most tasks. */
+    std::pmr::string title;         /**< Title of the task. */
+    std::pmr::string description;   /**< Description of the task. */
 
 public:
     /**
@@ -35,16 +149,93 @@ public:
      */
     Task();
 
+    /**
+     * @brief Constructs an empty task whose text uses the given allocator.
+     *
+     * @param Allocator Allocator for the title and description.
+     */
+    explicit Task(const allocator_type &Allocator);
+
     /**
      * @brief Parameterized constructor for Task.
      *
      * @param id Task ID.
      * @param title Task title.
      * @param desc Task description.
-     * @param dueDate Task due date.
+     * @param dueDay Task due date as a day number (see ParseDueDate()).
      * @param priority Task priority level.
+     * @param Allocator Allocator for the title and description.
      */
-    Task(int id, std::string title, std::string desc, std::string dueDate, std::string priority);
+    Task(int id, std::string_view title, std::string_view desc, std::int32_t dueDay, TaskPriority priority,
+         const allocator_type &Allocator = allocator_type());
+
+    /**
+     * @brief Copy constructor for Task.
+     *
+     * @param Other Task to copy.
+     */
+    Task(const Task &Other);
+
+    /**
+     * @brief Copy constructor placing the copied text in the given allocator.
+     *
+     * @param Other Task to copy.
+     * @param Allocator Allocator for the title and description.
+     */
+    Task(const Task &Other, const allocator_type &Allocator);
+
+    /**
+     * @brief Move constructor for Task.
+     *
+     * @param Other Task to move from.
+     */
+    Task(Task &&Other) noexcept = default;
+
+    /**
+     * @brief Move constructor placing the text in the given allocator.
+     *
+     * The text is only copied if Other uses a different memory resource.
+     *
+     * @param Other Task to move from.
+     * @param Allocator Allocator for the title and description.
+     */
+    Task(Task &&Other, const allocator_type &Allocator);
+
+    /**
+     * @brief Copy assignment; the task keeps its own allocator.
+     *
+     * @param Other Task to copy.
+     * @return Reference to this task.
+     */
+    Task &operator=(const Task &Other);
+
+    /**
+     * @brief Move assignment; the task keeps its own allocator.
+     *
+     * @param Other Task to move from.
+     * @return Reference to this task.
+     */
+    Task &operator=(Task &&Other) = default;
+
+    /**
+     * @brief Gets the allocator used for the task text.
+     *
+     * @return Allocator of the title and description.
+     */
+    allocator_type get_allocator(void) const;
+
+    /**
+     * @brief Replaces every field of the task, reusing the storage of its text.
+     *
+     * @param id Task ID.
+     * @param title Task title.
+     * @param desc Task description.
+     * @param dueDay Task due date as a day number.
+     * @param priority Task priority level.
+     * @param status Task status.
+     */
+    void vidAssign(int id, std::string_view title, std::string_view desc, std::int32_t dueDay, TaskPriority priority,
+                   TaskState status);
 
     /**
      * @brief Marks the task as done.
@@ -56,6 +247,20 @@ public:
      */
     void markPending(void);
 
+    /**
+     * @brief Turns the task into a tombstone and releases its text.
+     *
+     * The tombstone keeps its slot in the task list until the list is compacted.
+     */
+    void vidMarkRemoved(void);
+
+    /**
+     * @brief Tells whether the task has been deleted.
+     *
+     * @return true if the task is a tombstone.
+     */
+    bool bIsRemoved(void) const;
+
     /**
      * @brief Returns a string representation of the task.
      *
@@ -63,6 +268,13 @@ public:
      */
     std::string toString(void) const;
 
+    /**
+     * @brief Appends the string representation of the task to a buffer.
+     *
+     * @param Buffer Buffer the formatted task details are appended to.
+     */
+    void vidAppendTo(std::string &Buffer) const;
+
     /**
      * @brief Gets the task ID.
      *
@@ -73,72 +285,122 @@ public:
     /**
      * @brief Gets the task title.
      *
-     * @return Task title as a string.
+     * @return View of the task title, valid until the task is modified.
      */
-    std::string int32GetTaskTitle(void) const;
+    std::string_view int32GetTaskTitle(void) const;
 
     /**
      * @brief Gets the task description.
      *
-     * @return Task description as a string.
+     * @return View of the task description, valid until the task is modified.
      */
-    std::string int32GetTaskDescription(void) const;
+    std::string_view int32GetTaskDescription(void) const;
 
     /**
      * @brief Gets the task due date.
      *
-     * @return Due date as a string.
+     * @return Due date as a "YYYY-MM-DD" string, empty if the task has none, or the unrecognized text it was read with.
      */
     std::string int32GetTaskdueDate(void) const;
 
+    /**
+     * @brief Gets the task due date as a day number.
+     *
+     * @return Days since 1970-01-01, or TASK_NO_DUE_DATE.
+     */
+    std::int32_t int32GetDueDay(void) const;
+
+    /**
+     * @brief Gets the task priority level.
+     *
+     * @return Priority name, empty if the priority is unknown, or the unrecognized text it was read with.
+     */
+    std::string_view int32GetTaskpriority(void) const;
+
     /**
      * @brief Gets the task priority level.
      *
-     * @return Priority as a string.
+     * @return Priority as an enum value.
      */
-    std::string int32GetTaskpriority(void) const;
+    TaskPriority GetTaskPriority(void) const;
 
     /**
      * @brief Gets the current status of the task.
      *
-     * @return Task status as a string.
+     * @return Task status name.
      */
-    std::string GetTaskStatus(void) const;
+    std::string_view GetTaskStatus(void) const;
+
+    /**
+     * @brief Gets the current status of the task.
+     *
+     * @return Task status as an enum value.
+     */
+    TaskState GetTaskState(void) const;
 
     /**
      * @brief Sets the task status.
      *
-     * @param status New status string.
+     * @param status New status.
      */
-    void vidSetTaskStatus(std::string status);
+    void vidSetTaskStatus(TaskState status);
 
     /**
      * @brief Sets a new title for the task.
      *
      * @param strNewTitle New title.
      */
-    void vidSetTitle(std::string strNewTitle);
+    void vidSetTitle(std::string_view strNewTitle);
 
     /**
      * @brief Sets a new description for the task.
      *
      * @param strNewDescription New description.
      */
-    void vidSetDescription(std::string strNewDescription);
+    void vidSetDescription(std::string_view strNewDescription);
 
     /**
      * @brief Sets a new due date for the task.
      *
-     * @param strNewDueDate New due date.
+     * @param NewDueDay New due date as a day number.
      */
-    void vidSetDueDate(std::string strNewDueDate);
+    void vidSetDueDate(std::int32_t NewDueDay);
 
     /**
      * @brief Sets a new priority level for the task.
      *
-     * @param strNewPriority New priority.
+     * @param NewPriority New priority.
      */
-    void vidSetPriority(std::string strNewPriority);
+    void vidSetPriority(TaskPriority NewPriority);
+
+    /**
+     * @brief Keeps the text of a due date or priority that could not be parsed.
+     *
+     * @param DueDate Unrecognized due date text, or empty if the due date was parsed.
+     * @param Priority Unrecognized priority text, or empty if the priority was parsed.
+     */
+    void vidKeepRawFields(std::string_view DueDate, std::string_view Priority);
+
+    /**
+     * @brief Tells whether the task holds unrecognized due date or priority text.
+     *
+     * @return true if a field is kept as text.
+     */
+    bool bHasRawFields(void) const;
+
+    /**
+     * @brief Gets the unrecognized due date text of the task.
+     *
+     * @return Due date text, empty if the due date was parsed.
+     */
+    std::string_view GetRawDueDate(void) const;
+
+    /**
+     * @brief Gets the unrecognized priority text of the task.
+     *
+     * @return Priority text, empty if the priority was parsed.
+     */
+    std::string_view GetRawPriority(void) const;
 
     /**
      * @brief Destructor for Task.
@@ -146,4 +408,9 @@ public:
     ~Task();
 };
 
+/**
+ * @brief Container of tasks whose elements allocate their text from the container's memory resource.
+ */
+using TaskList = std::pmr::vector<Task>;
+
 #endif // __TASK__
@@ -0,0 +1,285 @@
+/**
+ * @file task_alloc_counter.cpp
+ * @brief Replacement of the global operator new and delete that counts heap allocations in the task metrics.
+ *
+ * Replacing operator new affects the whole program that links it, so this
+ * file is kept out of the task manager library: only the command-line
+ * application links it in, and libraries and benchmarks built on the task
+ * manager keep the standard allocator and report no allocations.
+ *
+ * Every form is replaced as one matched set: plain, array, nothrow, sized and
+ * aligned. Each new form allocates with std::malloc or std::aligned_alloc and
+ * each delete form frees with std::free, so no allocation escapes the count
+ * and no block is freed by an allocator other than the one that made it.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_metrics.hpp"
+#include <cstdlib>
+#include <new>
+
+#if TASKMANAGER_METRICS
+
+/**
+ * @brief Allocates memory like the standard operator new, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @param Alignment Required alignment, or 0 for the default alignment of std::malloc.
+ * @return Allocated memory, or nullptr if the new handler gave up.
+ */
+static void *pAllocate(std::size_t Size, std::size_t Alignment)
+{
+    vidAddToCounter(MetricCounter::Allocations, 1);
+    Size = (Size == 0) ? 1 : Size;
+    if (Alignment != 0)
+    {
+        Size = (Size + Alignment - 1) & ~(Alignment - 1);    /*aligned_alloc Wants A Multiple Of The Alignment*/
+    }
+    while (true)
+    {
+        void *Memory = (Alignment == 0) ? std::malloc(Size) : std::aligned_alloc(Alignment, Size);
+        if (Memory != nullptr)
+        {
+            return Memory;
+        }
+        std::new_handler Handler = std::get_new_handler();
+        if (Handler == nullptr)
+        {
+            return nullptr;
+        }
+        Handler();
+    }
+}
+
+/**
+ * @brief Allocates memory like the standard throwing operator new, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @param Alignment Required alignment, or 0 for the default alignment of std::malloc.
+ * @return Allocated memory.
+ */
+static void *pAllocateOrThrow(std::size_t Size, std::size_t Alignment)
+{
+    void *Memory = pAllocate(Size, Alignment);
+    if (Memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return Memory;
+}
+
+/**
+ * @brief Allocates memory, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @return Allocated memory.
+ */
+void *operator new(std::size_t Size)
+{
+    return pAllocateOrThrow(Size, 0);
+}
+
+/**
+ * @brief Allocates memory for an array, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @return Allocated memory.
+ */
+void *operator new[](std::size_t Size)
+{
+    return pAllocateOrThrow(Size, 0);
+}
+
+/**
+ * @brief Allocates memory without throwing, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @return Allocated memory, or nullptr on failure.
+ */
+void *operator new(std::size_t Size, const std::nothrow_t &) noexcept
+{
+    return pAllocate(Size, 0);
+}
+
+/**
+ * @brief Allocates memory for an array without throwing, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @return Allocated memory, or nullptr on failure.
+ */
+void *operator new[](std::size_t Size, const std::nothrow_t &) noexcept
+{
+    return pAllocate(Size, 0);
+}
+
+/**
+ * @brief Allocates over-aligned memory, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @param Alignment Required alignment.
+ * @return Allocated memory.
+ */
+void *operator new(std::size_t Size, std::align_val_t Alignment)
+{
+    return pAllocateOrThrow(Size, static_cast<std::size_t>(Alignment));
+}
+
+/**
+ * @brief Allocates over-aligned memory for an array, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @param Alignment Required alignment.
+ * @return Allocated memory.
+ */
+void *operator new[](std::size_t Size, std::align_val_t Alignment)
+{
+    return pAllocateOrThrow(Size, static_cast<std::size_t>(Alignment));
+}
+
+/**
+ * @brief Allocates over-aligned memory without throwing, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @param Alignment Required alignment.
+ * @return Allocated memory, or nullptr on failure.
+ */
+void *operator new(std::size_t Size, std::align_val_t Alignment, const std::nothrow_t &) noexcept
+{
+    return pAllocate(Size, static_cast<std::size_t>(Alignment));
+}
+
+/**
+ * @brief Allocates over-aligned memory for an array without throwing, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @param Alignment Required alignment.
+ * @return Allocated memory, or nullptr on failure.
+ */
+void *operator new[](std::size_t Size, std::align_val_t Alignment, const std::nothrow_t &) noexcept
+{
+    return pAllocate(Size, static_cast<std::size_t>(Alignment));
+}
+
+/**
+ * @brief Frees memory allocated by the counting operator new.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete(void *Memory) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees memory allocated by the counting operator new[].
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete[](void *Memory) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees memory allocated by the counting nothrow operator new.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete(void *Memory, const std::nothrow_t &) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees memory allocated by the counting nothrow operator new[].
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete[](void *Memory, const std::nothrow_t &) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees memory allocated by the counting operator new, given its size.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete(void *Memory, std::size_t) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees memory allocated by the counting operator new[], given its size.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete[](void *Memory, std::size_t) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees over-aligned memory allocated by the counting operator new.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete(void *Memory, std::align_val_t) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees over-aligned memory allocated by the counting operator new[].
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete[](void *Memory, std::align_val_t) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees over-aligned memory allocated by the counting nothrow operator new.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete(void *Memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees over-aligned memory allocated by the counting nothrow operator new[].
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete[](void *Memory, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees over-aligned memory allocated by the counting operator new, given its size.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete(void *Memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees over-aligned memory allocated by the counting operator new[], given its size.
+ *
+ * @param Memory Memory to free, or nullptr.
+ */
+void operator delete[](void *Memory, std::size_t, std::align_val_t) noexcept
+{
+    std::free(Memory);
+}
+
+#endif // TASKMANAGER_METRICS
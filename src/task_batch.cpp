@@ -0,0 +1,482 @@
+/**
+ * @file task_batch.cpp
+ * @brief Implementation of the non-interactive batch command runner.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_batch.hpp"
+#include "task_text.hpp"
+#include "task_metrics.hpp"
+#include <charconv>
+#include <sstream>
+
+/**
+ * @brief Largest number of pipe-separated fields a batch command can have.
+ */
+static constexpr std::size_t TASK_BATCH_MAX_FIELDS = 6;
+
+/**
+ * @brief Size after which the result buffer is written to the output stream.
+ */
+static constexpr std::size_t TASK_BATCH_FLUSH_SIZE = 1 << 16;
+
+/**
+ * @brief Splits a batch command into its pipe-separated fields.
+ *
+ * @param Line Command line to split.
+ * @param Fields Array receiving the fields.
+ * @return Number of fields, or TASK_BATCH_MAX_FIELDS + 1 if there are too many.
+ */
+static std::size_t SplitBatchLine(std::string_view Line, std::string_view (&Fields)[TASK_BATCH_MAX_FIELDS])
+{
+    std::size_t Count = 0;
+    while (true)
+    {
+        if (Count == TASK_BATCH_MAX_FIELDS)
+        {
+            return TASK_BATCH_MAX_FIELDS + 1;
+        }
+        std::size_t Separator = Line.find('|');
+        Fields[Count++] = Line.substr(0, Separator);
+        if (Separator == std::string_view::npos)
+        {
+            return Count;
+        }
+        Line.remove_prefix(Separator + 1);
+    }
+}
+
+/**
+ * @brief Parses a task ID.
+ *
+ * @param Text Text to parse.
+ * @param id Receives the ID.
+ * @return true if the text is a plain decimal integer.
+ */
+static bool bParseId(std::string_view Text, int &id)
+{
+    const char *End = Text.data() + Text.size();
+    auto Result = std::from_chars(Text.data(), End, id);
+    return Result.ec == std::errc() && Result.ptr == End;
+}
+
+/**
+ * @brief Parses the conditions of a query command into a filter.
+ *
+ * @param Conditions First condition.
+ * @param Count Number of conditions.
+ * @param Filter Filter receiving the conditions.
+ * @return nullptr on success, or the reason the conditions were rejected.
+ */
+static const char *ParseBatchFilter(const std::string_view *Conditions, std::size_t Count, TaskFilter &Filter)
+{
+    for (std::size_t Index = 0; Index < Count; ++Index)
+    {
+        std::string_view Condition = Conditions[Index];
+        std::size_t Equal = Condition.find('=');
+        if (Equal == std::string_view::npos)
+        {
+            return "Invalid Condition";
+        }
+        std::string_view Key = Condition.substr(0, Equal);
+        std::string_view Value = Condition.substr(Equal + 1);
+        if (Key == "status")
+        {
+            if (ParseTaskState(Value, Filter.State) == false)
+            {
+                return "Invalid Status";
+            }
+            Filter.HasState = true;
+        }
+        else if (Key == "priority")
+        {
+            if (ParseTaskPriority(Value, Filter.Priority) == false)
+            {
+                return "Invalid Priority";
+            }
+            Filter.HasPriority = true;
+        }
+        else if (Key == "due")
+        {
+            std::size_t Range = Value.find("..");
+            if (Range == std::string_view::npos)
+            {
+                return "Invalid Due Date Range";
+            }
+            std::string_view From = Value.substr(0, Range);
+            std::string_view To = Value.substr(Range + 2);
+            if (ParseDueDate(From, Filter.DueFrom) == false || ParseDueDate(To, Filter.DueTo) == false)
+            {
+                return "Invalid Due Date";
+            }
+            if (From.empty() == true)
+            {
+                Filter.DueFrom = std::numeric_limits<std::int32_t>::min();
+            }
+            if (Filter.DueTo == TASK_NO_DUE_DATE)
+            {
+                Filter.DueTo = TASK_NO_DUE_DATE - 1;
+            }
+        }
+        else
+        {
+            return "Invalid Condition";
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Appends "OK <value>" and a newline to the result buffer.
+ *
+ * @param Buffer Result buffer.
+ * @param Value Number reported with the success.
+ */
+static void vidAppendOk(std::string &Buffer, std::size_t Value)
+{
+    char Text[24];
+    auto End = std::to_chars(Text, Text + sizeof(Text), Value).ptr;
+    Buffer.append("OK ").append(Text, static_cast<std::size_t>(End - Text)).push_back('\n');
+}
+
+/**
+ * @brief Appends the text-format lines of some tasks and their count to the result buffer.
+ *
+ * @param Buffer Result buffer, written to Out whenever it grows past TASK_BATCH_FLUSH_SIZE.
+ * @param Matches Tasks to append.
+ * @param Out Output stream, or nullptr to keep every line in Buffer.
+ */
+static void vidAppendTasks(std::string &Buffer, const std::vector<const Task *> &Matches, std::ostream *Out)
+{
+    for (const Task *it : Matches)
+    {
+        AppendTaskLine(Buffer, *it);
+        if (Out != nullptr && Buffer.size() >= TASK_BATCH_FLUSH_SIZE)
+        {
+            Out->write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        }
+    }
+    vidAppendOk(Buffer, Matches.size());
+}
+
+/**
+ * @brief Writes the matches of a command to the result buffer, or keeps them in a listing.
+ *
+ * @param Buffer Result buffer.
+ * @param Matches Tasks matched by the command.
+ * @param Out Output stream, or nullptr to keep every line in Buffer.
+ * @param Listing Listing receiving the IDs of the matches, or nullptr to append them to Buffer.
+ */
+static void vidReportMatches(std::string &Buffer, const std::vector<const Task *> &Matches, std::ostream *Out,
+                             TaskBatchListing *Listing)
+{
+    if (Listing == nullptr)
+    {
+        vidAppendTasks(Buffer, Matches, Out);
+        return;
+    }
+    Listing->Ids.clear();
+    Listing->Ids.reserve(Matches.size());
+    for (const Task *it : Matches)
+    {
+        Listing->Ids.push_back(it->int32GetTaskID());
+    }
+    Listing->Next = 0;
+    Listing->Written = 0;
+    Listing->Pending = true;
+}
+
+/**
+ * @brief Runs one batch command.
+ *
+ * @param manager Task manager the command is applied to.
+ * @param Fields Fields of the command, the command name first.
+ * @param Count Number of fields.
+ * @param Buffer Result buffer the output of the command is appended to.
+ * @param Out Output stream, flushed by the commit command, or nullptr to keep every result in Buffer.
+ * @param Listing Listing receiving the matches of list, query and search, or nullptr to append them to Buffer.
+ * @return nullptr on success, or the reason the command failed.
+ */
+static const char *RunBatchCommand(TaskManager &manager, const std::string_view *Fields, std::size_t Count,
+                                   std::string &Buffer, std::ostream *Out, TaskBatchListing *Listing)
+{
+    std::string_view Command = Fields[0];
+    int id = 0;
+    if (Command == "add")
+    {
+        std::int32_t DueDay = TASK_NO_DUE_DATE;
+        TaskPriority Priority = TaskPriority::Unknown;
+        if (Count != 5)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        if (ParseDueDate(Fields[3], DueDay) == false)
+        {
+            return "Invalid Due Date";
+        }
+        if (ParseTaskPriority(Fields[4], Priority) == false)
+        {
+            return "Invalid Priority";
+        }
+        vidAppendOk(Buffer, static_cast<std::size_t>(manager.addTask(Fields[1], Fields[2], DueDay, Priority)));
+    }
+    else if (Command == "update")
+    {
+        bool Found = false;
+        if (Count != 4)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        if (bParseId(Fields[1], id) == false)
+        {
+            return "Invalid Task ID";
+        }
+        if (Fields[2] == "title")
+        {
+            Found = manager.setTitle(id, Fields[3]);
+        }
+        else if (Fields[2] == "description")
+        {
+            Found = manager.setDescription(id, Fields[3]);
+        }
+        else if (Fields[2] == "due")
+        {
+            std::int32_t DueDay = TASK_NO_DUE_DATE;
+            if (ParseDueDate(Fields[3], DueDay) == false)
+            {
+                return "Invalid Due Date";
+            }
+            Found = manager.setDueDate(id, DueDay);
+        }
+        else if (Fields[2] == "priority")
+        {
+            TaskPriority Priority = TaskPriority::Unknown;
+            if (ParseTaskPriority(Fields[3], Priority) == false)
+            {
+                return "Invalid Priority";
+            }
+            Found = manager.setPriority(id, Priority);
+        }
+        else
+        {
+            return "Unknown Field";
+        }
+        if (Found == false)
+        {
+            return "No Task With This ID";
+        }
+        vidAppendOk(Buffer, static_cast<std::size_t>(id));
+    }
+    else if (Command == "status")
+    {
+        TaskState State = TaskState::Pending;
+        if (Count != 3)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        if (bParseId(Fields[1], id) == false)
+        {
+            return "Invalid Task ID";
+        }
+        if (ParseTaskState(Fields[2], State) == false)
+        {
+            return "Invalid Status";
+        }
+        if (manager.setStatus(id, State) == false)
+        {
+            return "No Task With This ID";
+        }
+        vidAppendOk(Buffer, static_cast<std::size_t>(id));
+    }
+    else if (Command == "delete")
+    {
+        if (Count != 2)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        if (bParseId(Fields[1], id) == false)
+        {
+            return "Invalid Task ID";
+        }
+        if (manager.removeTask(id) == false)
+        {
+            return "No Task With This ID";
+        }
+        vidAppendOk(Buffer, static_cast<std::size_t>(id));
+    }
+    else if (Command == "list" || Command == "query")
+    {
+        TaskFilter Filter;
+        if (Command == "list" && Count != 1)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        const char *Error = ParseBatchFilter(Fields + 1, Count - 1, Filter);
+        if (Error != nullptr)
+        {
+            return Error;
+        }
+        vidReportMatches(Buffer, manager.Query(Filter), Out, Listing);
+    }
+    else if (Command == "count")
+    {
+        TaskFilter Filter;
+        const char *Error = ParseBatchFilter(Fields + 1, Count - 1, Filter);
+        if (Error != nullptr)
+        {
+            return Error;
+        }
+        vidAppendOk(Buffer, manager.Count(Filter));
+    }
+    else if (Command == "search")
+    {
+        if (Count != 2)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        vidReportMatches(Buffer, manager.Search(Fields[1]), Out, Listing);
+    }
+    else if (Command == "commit")
+    {
+        if (Count != 1)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        manager.Commit();
+        vidAppendOk(Buffer, manager.size());
+        if (Out != nullptr)
+        {
+            Out->write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Out->flush();
+            Buffer.clear();
+        }
+    }
+    else if (Command == "stats")
+    {
+        if (Count != 1)
+        {
+            return "Wrong Number Of Arguments";
+        }
+        std::ostringstream Summary;
+        vidWriteMetricsSummary(Summary);
+        Buffer += Summary.str();
+        vidAppendOk(Buffer, manager.size());
+    }
+    else
+    {
+        return "Unknown Command";
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Runs one batch command line, appending its results to a buffer.
+ *
+ * @param manager Task manager the command is applied to.
+ * @param Line Command line, without its newline.
+ * @param LineNumber Number of the line, reported in errors.
+ * @param Buffer Result buffer the output of the command is appended to.
+ * @param Out Stream large results are written to as they grow, or nullptr to keep every result in Buffer.
+ * @param Listing Receives the matches of a list, query or search command instead of Buffer, to be written with bAppendTaskBatchListing(); nullptr to write them at once.
+ * @return false if the command failed, true if it succeeded or the line was blank or a comment.
+ */
+bool bRunTaskBatchLine(TaskManager &manager, std::string_view Line, std::size_t LineNumber, std::string &Buffer,
+                       std::ostream *Out, TaskBatchListing *Listing)
+{
+    std::string_view Fields[TASK_BATCH_MAX_FIELDS];
+    if (Line.empty() == false && Line.back() == '\r')
+    {
+        Line.remove_suffix(1);
+    }
+    if (Line.empty() == true || Line[0] == '#')
+    {
+        return true;
+    }
+
+    std::size_t Count = SplitBatchLine(Line, Fields);
+    const char *Error = (Count > TASK_BATCH_MAX_FIELDS) ? "Wrong Number Of Arguments"
+                                                         : RunBatchCommand(manager, Fields, Count, Buffer, Out, Listing);
+    if (Error == nullptr)
+    {
+        return true;
+    }
+    char Text[24];
+    auto End = std::to_chars(Text, Text + sizeof(Text), LineNumber).ptr;
+    Buffer.append("ERROR ").append(Text, static_cast<std::size_t>(End - Text));
+    Buffer.append(": ").append(Error).push_back('\n');
+    return false;
+}
+
+/**
+ * @brief Appends the lines of the next tasks of a listing, and its "OK" line once they are all written.
+ *
+ * @param manager Task manager the listing came from.
+ * @param Listing Listing filled in by bRunTaskBatchLine().
+ * @param Buffer Result buffer the lines are appended to.
+ * @param Limit Size of Buffer after which no further task is appended.
+ * @return true once the listing is complete, false if tasks remain.
+ */
+bool bAppendTaskBatchListing(const TaskManager &manager, TaskBatchListing &Listing, std::string &Buffer, std::size_t Limit)
+{
+    while (Listing.Next < Listing.Ids.size())
+    {
+        if (Buffer.size() >= Limit)
+        {
+            return false;
+        }
+        const Task *it = manager.findTask(Listing.Ids[Listing.Next++]);
+        if (it != nullptr)
+        {
+            AppendTaskLine(Buffer, *it);
+            ++Listing.Written;
+        }
+    }
+    vidAppendOk(Buffer, Listing.Written);
+    Listing.Ids.clear();
+    Listing.Ids.shrink_to_fit();
+    Listing.Pending = false;
+    return true;
+}
+
+/**
+ * @brief Runs a stream of batch commands against a task manager without prompting.
+ *
+ * Results are collected in one buffer and written out in large blocks. The
+ * manager batches its journal for the whole run, so mutations are persisted at
+ * each commit command and once more at the end.
+ *
+ * @param manager Task manager the commands are applied to.
+ * @param In Stream the commands are read from.
+ * @param Out Stream the results are written to.
+ * @return Number of commands that failed.
+ */
+std::size_t RunTaskBatch(TaskManager &manager, std::istream &In, std::ostream &Out)
+{
+    std::string Line;
+    std::string Buffer;
+    Buffer.reserve(TASK_BATCH_FLUSH_SIZE + 4096);
+    std::size_t LineNumber = 0;
+    std::size_t Failed = 0;
+
+    manager.BeginBatch();
+    while (std::getline(In, Line))
+    {
+        ++LineNumber;
+        if (bRunTaskBatchLine(manager, Line, LineNumber, Buffer, &Out) == false)
+        {
+            ++Failed;
+        }
+        if (Buffer.size() >= TASK_BATCH_FLUSH_SIZE)
+        {
+            Out.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        }
+    }
+    manager.EndBatch();
+    Out.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    Out.flush();
+    return Failed;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file task_batch.hpp
+ * @brief Declaration of the non-interactive batch command runner.
+ *
+ * A batch is a stream of commands, one per line, with pipe-separated arguments:
+ *
+ * - add|<title>|<description>|<due date>|<priority>
+ * - update|<id>|title|<title>  (also description, due and priority)
+ * - status|<id>|<Pending or Done>
+ * - delete|<id>
+ * - list
+ * - query|<condition>|...  with conditions status=<status>, priority=<priority>
+ *   and due=<from>..<to> (either end may be left open; tasks without a due date
+ *   never match a due range)
+ * - count|<condition>|...  with the same conditions as query
+ * - search|<keywords>  (see TaskTextIndex for the query syntax)
+ * - commit
+ * - stats
+ *
+ * Blank lines and lines starting with '#' are ignored. Every mutation prints
+ * "OK <id>", failures print "ERROR <line>: <reason>", and list, query and
+ * search print matching tasks in the text file format followed by "OK <count>";
+ * count prints only "OK <count>".
+ * stats prints the operation latencies and counters as "# " lines (see
+ * task_metrics.hpp) followed by "OK <number of tasks>".
+ * Every command therefore ends with exactly one "OK" or "ERROR" line, which is
+ * how TaskServer clients find the end of each response. Mutations are
+ * persisted together at each commit command and at the end of the batch.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__BATCH__
+#define __TASK__BATCH__
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "task_manager.hpp"
+
+/**
+ * @struct TaskBatchListing
+ * @brief Tasks matched by a list, query or search command whose lines are still to be written.
+ *
+ * Holding only the IDs lets a caller such as TaskServer write a large reply a
+ * chunk at a time, as its client takes it, instead of formatting it whole.
+ */
+struct TaskBatchListing
+{
+    std::vector<int> Ids;       /**< IDs of the matched tasks, in output order. */
+    std::size_t Next = 0;       /**< Index in Ids of the next task to write. */
+    std::size_t Written = 0;    /**< Number of task lines written so far. */
+    bool Pending = false;       /**< true from the command until its "OK" line is written. */
+};
+
+/**
+ * @brief Runs one batch command line, appending its results to a buffer.
+ *
+ * @param manager Task manager the command is applied to.
+ * @param Line Command line, without its newline.
+ * @param LineNumber Number of the line, reported in errors.
+ * @param Buffer Result buffer the output of the command is appended to.
+ * @param Out Stream large results are written to as they grow, or nullptr to keep every result in Buffer.
+ * @param Listing Receives the matches of a list, query or search command instead of Buffer, to be written with bAppendTaskBatchListing(); nullptr to write them at once.
+ * @return false if the command failed, true if it succeeded or the line was blank or a comment.
+ */
+bool bRunTaskBatchLine(TaskManager &manager, std::string_view Line, std::size_t LineNumber, std::string &Buffer,
+                       std::ostream *Out = nullptr, TaskBatchListing *Listing = nullptr);
+
+/**
+ * @brief Appends the lines of the next tasks of a listing, and its "OK" line once they are all written.
+ *
+ * Tasks are looked up when they are written, so a task deleted since the
+ * command ran is skipped and one changed since is written as it is now; the
+ * count on the "OK" line is that of the lines actually written.
+ *
+ * @param manager Task manager the listing came from.
+ * @param Listing Listing filled in by bRunTaskBatchLine().
+ * @param Buffer Result buffer the lines are appended to.
+ * @param Limit Size of Buffer after which no further task is appended.
+ * @return true once the listing is complete, false if tasks remain.
+ */
+bool bAppendTaskBatchListing(const TaskManager &manager, TaskBatchListing &Listing, std::string &Buffer, std::size_t Limit);
+
+/**
+ * @brief Runs a stream of batch commands against a task manager without prompting.
+ *
+ * @param manager Task manager the commands are applied to.
+ * @param In Stream the commands are read from.
+ * @param Out Stream the results are written to.
+ * @return Number of commands that failed.
+ */
+std::size_t RunTaskBatch(TaskManager &manager, std::istream &In, std::ostream &Out);
+
+#endif // __TASK__BATCH__
@@ -0,0 +1,437 @@
+/**
+ * @file task_binary.cpp
+ * @brief Implementation of the compact binary task file format.
+ *
+ * Tasks are encoded into an in-memory buffer that is flushed to disk in large
+ * chunks. The header is written last, once the task count and payload checksum
+ * are known. Loading maps the file and decodes it in place.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_binary.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+/**
+ * @brief Magic bytes identifying a binary task file.
+ */
+static const char TASK_BINARY_MAGIC[8] = {'T', 'A', 'S', 'K', 'B', 'I', 'N', '\0'};
+
+/**
+ * @brief Payload size after which the save buffer is flushed to disk.
+ */
+static constexpr std::size_t TASK_BINARY_FLUSH_SIZE = 1 << 20;
+
+/**
+ * @brief Smallest encoded task record of any version: ID, status, priority, due day and two empty strings.
+ */
+static constexpr std::size_t TASK_BINARY_MIN_RECORD_SIZE = 4 + 1 + 1 + 4 + 4 + 4;
+
+/**
+ * @brief Constructs a writer appending to the given buffer.
+ *
+ * @param Out Destination buffer.
+ */
+BinaryWriter::BinaryWriter(std::string &Out) : Buffer(Out)
+{
+}
+
+/**
+ * @brief Appends a single byte.
+ *
+ * @param Value Byte to append.
+ */
+void BinaryWriter::vidWriteU8(std::uint8_t Value)
+{
+    Buffer.push_back(static_cast<char>(Value));
+}
+
+/**
+ * @brief Appends a 32-bit unsigned integer in little-endian order.
+ *
+ * @param Value Integer to append.
+ */
+void BinaryWriter::vidWriteU32(std::uint32_t Value)
+{
+    char Bytes[4];
+    for (int Index = 0; Index < 4; ++Index)
+    {
+        Bytes[Index] = static_cast<char>((Value >> (8 * Index)) & 0xFF);
+    }
+    Buffer.append(Bytes, sizeof(Bytes));
+}
+
+/**
+ * @brief Appends a 64-bit unsigned integer in little-endian order.
+ *
+ * @param Value Integer to append.
+ */
+void BinaryWriter::vidWriteU64(std::uint64_t Value)
+{
+    char Bytes[8];
+    for (int Index = 0; Index < 8; ++Index)
+    {
+        Bytes[Index] = static_cast<char>((Value >> (8 * Index)) & 0xFF);
+    }
+    Buffer.append(Bytes, sizeof(Bytes));
+}
+
+/**
+ * @brief Appends a string as a 32-bit length followed by its bytes.
+ *
+ * @param Value String to append.
+ */
+void BinaryWriter::vidWriteString(std::string_view Value)
+{
+    vidWriteU32(static_cast<std::uint32_t>(Value.size()));
+    Buffer.append(Value);
+}
+
+/**
+ * @brief Appends the binary record of a task.
+ *
+ * The record holds the ID, a status byte, a priority byte, the due day and
+ * the title and description as length-prefixed strings.
+ *
+ * @param task Task to encode.
+ */
+void BinaryWriter::vidWriteTask(const Task &task)
+{
+    vidWriteU32(static_cast<std::uint32_t>(task.int32GetTaskID()));
+    vidWriteU8(static_cast<std::uint8_t>(task.GetTaskState()));
+    vidWriteU8(static_cast<std::uint8_t>(task.GetTaskPriority()));
+    vidWriteU32(static_cast<std::uint32_t>(task.int32GetDueDay()));
+    vidWriteString(task.int32GetTaskTitle());
+    vidWriteString(task.int32GetTaskDescription());
+}
+
+/**
+ * @brief Constructs a reader over the given byte range.
+ *
+ * @param Data First byte of the range.
+ * @param Size Number of bytes in the range.
+ */
+BinaryReader::BinaryReader(const char *Data, std::size_t Size) : Cursor(Data), End(Data + Size)
+{
+}
+
+/**
+ * @brief Checks that the given number of bytes is still readable.
+ *
+ * @param Count Number of bytes about to be read.
+ * @return true if the bytes are available, false otherwise.
+ */
+bool BinaryReader::bHasBytes(std::size_t Count)
+{
+    if (Failed == true || static_cast<std::size_t>(End - Cursor) < Count)
+    {
+        Failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a single byte.
+ *
+ * @return The byte read, or 0 on failure.
+ */
+std::uint8_t BinaryReader::u8Read(void)
+{
+    if (bHasBytes(1) == false)
+    {
+        return 0;
+    }
+    return static_cast<std::uint8_t>(*Cursor++);
+}
+
+/**
+ * @brief Reads a 32-bit little-endian unsigned integer.
+ *
+ * @return The integer read, or 0 on failure.
+ */
+std::uint32_t BinaryReader::u32Read(void)
+{
+    if (bHasBytes(4) == false)
+    {
+        return 0;
+    }
+    std::uint32_t Value = 0;
+    for (int Index = 0; Index < 4; ++Index)
+    {
+        Value |= static_cast<std::uint32_t>(static_cast<unsigned char>(Cursor[Index])) << (8 * Index);
+    }
+    Cursor += 4;
+    return Value;
+}
+
+/**
+ * @brief Reads a 64-bit little-endian unsigned integer.
+ *
+ * @return The integer read, or 0 on failure.
+ */
+std::uint64_t BinaryReader::u64Read(void)
+{
+    if (bHasBytes(8) == false)
+    {
+        return 0;
+    }
+    std::uint64_t Value = 0;
+    for (int Index = 0; Index < 8; ++Index)
+    {
+        Value |= static_cast<std::uint64_t>(static_cast<unsigned char>(Cursor[Index])) << (8 * Index);
+    }
+    Cursor += 8;
+    return Value;
+}
+
+/**
+ * @brief Reads a length-prefixed string without copying it.
+ *
+ * @return View into the input range, or an empty view on failure.
+ */
+std::string_view BinaryReader::svRead(void)
+{
+    std::uint32_t Length = u32Read();
+    if (bHasBytes(Length) == false)
+    {
+        return std::string_view();
+    }
+    std::string_view Value(Cursor, Length);
+    Cursor += Length;
+    return Value;
+}
+
+/**
+ * @brief Reads the binary record of a task.
+ *
+ * @param task Task that receives the decoded fields.
+ * @param Version Format version the record was written with.
+ * @return true if the whole record was read, false otherwise.
+ */
+bool BinaryReader::bReadTask(Task &task, std::uint32_t Version)
+{
+    int id = static_cast<int>(u32Read());
+    std::uint8_t Status = u8Read();
+    TaskPriority priority = TaskPriority::Unknown;
+    std::int32_t dueDay = TASK_NO_DUE_DATE;
+    std::string_view title;
+    std::string_view desc;
+    if (Version == 1)
+    {
+        title = svRead();
+        desc = svRead();
+        if (ParseDueDate(svRead(), dueDay) == false)
+        {
+            dueDay = TASK_NO_DUE_DATE;
+        }
+        ParseTaskPriority(svRead(), priority);
+    }
+    else
+    {
+        std::uint8_t PriorityCode = u8Read();
+        dueDay = static_cast<std::int32_t>(u32Read());
+        title = svRead();
+        desc = svRead();
+        if (PriorityCode > static_cast<std::uint8_t>(TaskPriority::High))
+        {
+            Failed = true;
+        }
+        priority = static_cast<TaskPriority>(PriorityCode);
+    }
+    if (Failed == true || Status > static_cast<std::uint8_t>(TaskState::Done))
+    {
+        return false;
+    }
+    task.vidAssign(id, title, desc, dueDay, priority, static_cast<TaskState>(Status));
+    return true;
+}
+
+/**
+ * @brief Gets the number of bytes left to read.
+ *
+ * @return Remaining byte count.
+ */
+std::size_t BinaryReader::u64Remaining(void) const
+{
+    return static_cast<std::size_t>(End - Cursor);
+}
+
+/**
+ * @brief Tells whether a read has failed.
+ *
+ * @return true if any read ran past the end of the range.
+ */
+bool BinaryReader::bFailed(void) const
+{
+    return Failed;
+}
+
+/**
+ * @brief Computes a 64-bit FNV-1a style checksum of a byte range.
+ *
+ * The range is consumed as little-endian 64-bit words, with the remaining tail hashed
+ * byte by byte.
+ *
+ * @param Data First byte of the range.
+ * @param Size Number of bytes in the range.
+ * @param Seed Checksum to continue from, allowing incremental hashing.
+ * @return Checksum of the range.
+ */
+std::uint64_t u64Checksum(const char *Data, std::size_t Size, std::uint64_t Seed)
+{
+    std::uint64_t Hash = Seed;
+    std::size_t Index = 0;
+    for (; Index + 8 <= Size; Index += 8)
+    {
+        std::uint64_t Word = 0;
+        for (int Byte = 0; Byte < 8; ++Byte)
+        {
+            Word |= static_cast<std::uint64_t>(static_cast<unsigned char>(Data[Index + Byte])) << (8 * Byte);
+        }
+        Hash ^= Word;
+        Hash *= 0x100000001b3ULL;
+        Hash ^= Hash >> 29;
+    }
+    for (; Index < Size; ++Index)
+    {
+        Hash ^= static_cast<unsigned char>(Data[Index]);
+        Hash *= 0x100000001b3ULL;
+    }
+    return Hash;
+}
+
+/**
+ * @brief Tells whether a file name selects the binary task format.
+ *
+ * @param filename Name of the task file.
+ * @return true if the file has the ".bin" extension, false otherwise.
+ */
+bool IsBinaryTaskFile(const std::string &filename)
+{
+    const std::string Extension = ".bin";
+    return filename.size() >= Extension.size() &&
+           filename.compare(filename.size() - Extension.size(), Extension.size(), Extension) == 0;
+}
+
+/**
+ * @brief Writes tasks to a file in the binary format.
+ *
+ * A zeroed header is written first as a placeholder. Task records are encoded
+ * into a buffer that is flushed whenever it grows past TASK_BINARY_FLUSH_SIZE.
+ * Flushes are kept to multiples of eight bytes so the incremental checksum
+ * matches a checksum of the whole payload. The real header is written over the placeholder at the end.
+ *
+ * @param tasks Tasks to write.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header, or 0 to record none.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksBinary(const TaskList &tasks, const std::string &filename, int NextId)
+{
+    std::ofstream FileHandler(filename, std::ios::binary | std::ios::trunc);
+    if (!FileHandler)
+    {
+        return false;
+    }
+
+    std::string Buffer(TASK_BINARY_HEADER_SIZE, '\0');
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    Buffer.clear();
+    Buffer.reserve(TASK_BINARY_FLUSH_SIZE + 4096);
+
+    BinaryWriter Writer(Buffer);
+    std::uint64_t Checksum = u64Checksum(nullptr, 0);
+    std::uint64_t Count = 0;
+    for (auto &it : tasks)
+    {
+        if (it.bIsRemoved() == true)
+        {
+            continue;
+        }
+        Writer.vidWriteTask(it);
+        ++Count;
+        if (Buffer.size() >= TASK_BINARY_FLUSH_SIZE)
+        {
+            std::size_t Flushed = Buffer.size() & ~static_cast<std::size_t>(7);
+            Checksum = u64Checksum(Buffer.data(), Flushed, Checksum);
+            FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Flushed));
+            Buffer.erase(0, Flushed);
+        }
+    }
+    Checksum = u64Checksum(Buffer.data(), Buffer.size(), Checksum);
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+
+    Buffer.clear();
+    Buffer.append(TASK_BINARY_MAGIC, sizeof(TASK_BINARY_MAGIC));
+    Writer.vidWriteU32(TASK_BINARY_VERSION);
+    Writer.vidWriteU32(static_cast<std::uint32_t>(std::max(NextId, 0)));
+    Writer.vidWriteU64(Count);
+    Writer.vidWriteU64(Checksum);
+    FileHandler.seekp(0);
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    FileHandler.close();
+    return !FileHandler.fail();
+}
+
+/**
+ * @brief Reads tasks from a file in the binary format.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks Vector the decoded tasks are appended to.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if none was recorded.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool LoadTasksBinary(const std::string &filename, TaskList &tasks, int &NextId)
+{
+    NextId = 0;
+    MappedFile File(filename);
+    if (File.bIsOpen() == false)
+    {
+        return false;
+    }
+    std::string_view Content = File.View();
+    if (Content.empty() == true)
+    {
+        return true;
+    }
+    if (Content.size() < TASK_BINARY_HEADER_SIZE ||
+        std::memcmp(Content.data(), TASK_BINARY_MAGIC, sizeof(TASK_BINARY_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    BinaryReader Header(Content.data() + sizeof(TASK_BINARY_MAGIC), TASK_BINARY_HEADER_SIZE - sizeof(TASK_BINARY_MAGIC));
+    std::uint32_t Version = Header.u32Read();
+    std::uint32_t SavedNextId = Header.u32Read();
+    std::uint64_t Count = Header.u64Read();
+    std::uint64_t Checksum = Header.u64Read();
+
+    const char *Payload = Content.data() + TASK_BINARY_HEADER_SIZE;
+    std::size_t PayloadSize = Content.size() - TASK_BINARY_HEADER_SIZE;
+    if (Version < 1 || Version > TASK_BINARY_VERSION || u64Checksum(Payload, PayloadSize) != Checksum ||
+        Count > PayloadSize / TASK_BINARY_MIN_RECORD_SIZE)    /*The Checksum Does Not Cover The Header*/
+    {
+        return false;
+    }
+
+    BinaryReader Reader(Payload, PayloadSize);
+    std::size_t FirstNew = tasks.size();
+    tasks.reserve(FirstNew + Count);
+    for (std::uint64_t Index = 0; Index < Count; ++Index)
+    {
+        tasks.emplace_back();
+        if (Reader.bReadTask(tasks.back(), Version) == false)
+        {
+            tasks.resize(FirstNew);
+            return false;
+        }
+    }
+    NextId = (SavedNextId <= static_cast<std::uint32_t>(std::numeric_limits<int>::max())) ? static_cast<int>(SavedNextId) : 0;
+    return Reader.u64Remaining() == 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file task_binary.hpp
+ * @brief Declaration of the compact binary task file format and its helpers.
+ *
+ * A binary task file starts with a fixed header holding a magic string, the format
+ * version, the next task ID to hand out, the number of tasks and a checksum of
+ * the payload. Files written before the next ID was recorded hold 0 there. The payload stores
+ * each task as its ID, status, priority and due day followed by its length-prefixed
+ * title and description. Files written with version 1, which stored the due date
+ * and priority as text, can still be read.
+ * All integers are stored little-endian regardless of the host byte order.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__BINARY__
+#define __TASK__BINARY__
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "task.hpp"
+
+/**
+ * @brief Size in bytes of the binary task file header.
+ */
+constexpr std::size_t TASK_BINARY_HEADER_SIZE = 32;
+
+/**
+ * @brief Current version of the binary task file format.
+ */
+constexpr std::uint32_t TASK_BINARY_VERSION = 2;
+
+/**
+ * @class BinaryWriter
+ * @brief Appends little-endian integers and length-prefixed strings to a byte buffer.
+ */
+class BinaryWriter
+{
+private:
+    std::string &Buffer;    /**< Destination buffer the encoded bytes are appended to. */
+
+public:
+    /**
+     * @brief Constructs a writer appending to the given buffer.
+     *
+     * @param Out Destination buffer.
+     */
+    explicit BinaryWriter(std::string &Out);
+
+    /**
+     * @brief Appends a single byte.
+     *
+     * @param Value Byte to append.
+     */
+    void vidWriteU8(std::uint8_t Value);
+
+    /**
+     * @brief Appends a 32-bit unsigned integer.
+     *
+     * @param Value Integer to append.
+     */
+    void vidWriteU32(std::uint32_t Value);
+
+    /**
+     * @brief Appends a 64-bit unsigned integer.
+     *
+     * @param Value Integer to append.
+     */
+    void vidWriteU64(std::uint64_t Value);
+
+    /**
+     * @brief Appends a string as a 32-bit length followed by its bytes.
+     *
+     * @param Value String to append.
+     */
+    void vidWriteString(std::string_view Value);
+
+    /**
+     * @brief Appends the binary record of a task.
+     *
+     * @param task Task to encode.
+     */
+    void vidWriteTask(const Task &task);
+};
+
+/**
+ * @class BinaryReader
+ * @brief Reads little-endian integers and length-prefixed strings from a byte range.
+ *
+ * Every read is bounds-checked; once a read runs past the end the reader is marked
+ * as failed and all further reads return zero values.
+ */
+class BinaryReader
+{
+private:
+    const char *Cursor;     /**< Next byte to read. */
+    const char *End;        /**< One past the last readable byte. */
+    bool Failed = false;    /**< Set once a read ran past the end of the range. */
+
+    /**
+     * @brief Checks that the given number of bytes is still readable.
+     *
+     * @param Count Number of bytes about to be read.
+     * @return true if the bytes are available, false otherwise.
+     */
+    bool bHasBytes(std::size_t Count);
+
+public:
+    /**
+     * @brief Constructs a reader over the given byte range.
+     *
+     * @param Data First byte of the range.
+     * @param Size Number of bytes in the range.
+     */
+    BinaryReader(const char *Data, std::size_t Size);
+
+    /**
+     * @brief Reads a single byte.
+     *
+     * @return The byte read, or 0 on failure.
+     */
+    std::uint8_t u8Read(void);
+
+    /**
+     * @brief Reads a 32-bit unsigned integer.
+     *
+     * @return The integer read, or 0 on failure.
+     */
+    std::uint32_t u32Read(void);
+
+    /**
+     * @brief Reads a 64-bit unsigned integer.
+     *
+     * @return The integer read, or 0 on failure.
+     */
+    std::uint64_t u64Read(void);
+
+    /**
+     * @brief Reads a length-prefixed string without copying it.
+     *
+     * @return View into the input range, or an empty view on failure.
+     */
+    std::string_view svRead(void);
+
+    /**
+     * @brief Reads the binary record of a task.
+     *
+     * Version 1 records stored the due date and priority as strings; they are
+     * decoded into the typed fields, with unrecognized values cleared. The text
+     * is copied straight from the input into memory from the task's own allocator.
+     *
+     * @param task Task that receives the decoded fields.
+     * @param Version Format version the record was written with.
+     * @return true if the whole record was read, false otherwise.
+     */
+    bool bReadTask(Task &task, std::uint32_t Version = TASK_BINARY_VERSION);
+
+    /**
+     * @brief Gets the number of bytes left to read.
+     *
+     * @return Remaining byte count.
+     */
+    std::size_t u64Remaining(void) const;
+
+    /**
+     * @brief Tells whether a read has failed.
+     *
+     * @return true if any read ran past the end of the range.
+     */
+    bool bFailed(void) const;
+};
+
+/**
+ * @brief Computes a 64-bit FNV-1a style checksum of a byte range.
+ *
+ * When hashing incrementally, every chunk but the last must be a multiple of
+ * eight bytes long for the result to match a single call over the whole range.
+ *
+ * @param Data First byte of the range.
+ * @param Size Number of bytes in the range.
+ * @param Seed Checksum to continue from, allowing incremental hashing.
+ * @return Checksum of the range.
+ */
+std::uint64_t u64Checksum(const char *Data, std::size_t Size, std::uint64_t Seed = 0xcbf29ce484222325ULL);
+
+/**
+ * @brief Tells whether a file name selects the binary task format.
+ *
+ * Files with the ".bin" extension are stored in the binary format.
+ *
+ * @param filename Name of the task file.
+ * @return true if the file uses the binary format, false for the text format.
+ */
+bool IsBinaryTaskFile(const std::string &filename);
+
+/**
+ * @brief Writes tasks to a file in the binary format.
+ *
+ * Deleted tasks still waiting in the list as tombstones are skipped.
+ *
+ * @param tasks Tasks to write.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header, or 0 to record none.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksBinary(const TaskList &tasks, const std::string &filename, int NextId = 0);
+
+/**
+ * @brief Reads tasks from a file in the binary format.
+ *
+ * The header magic, version, task count and checksum are all verified before
+ * any task is returned.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks Vector the decoded tasks are appended to.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if none was recorded.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool LoadTasksBinary(const std::string &filename, TaskList &tasks, int &NextId);
+
+#endif // __TASK__BINARY__
@@ -0,0 +1,362 @@
+/**
+ * @file task_body_cache.cpp
+ * @brief Implementation of the TaskBodyCache class.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_body_cache.hpp"
+#include "task_metrics.hpp"
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+/**
+ * @brief Opens a snapshot and reads the stubs of its tasks.
+ *
+ * The block index gives the task count of every block, so the stubs are
+ * sized once and the blocks split into as many runs as there are hardware
+ * threads, each decoding the metadata of its blocks straight into its own
+ * range of stubs. The text sections are not read.
+ *
+ * @param filename Name of the snapshot file.
+ * @param NextId Receives the next task ID recorded in the snapshot, or the one after its last task if higher.
+ * @return true on success; false if the file is not a valid snapshot or its IDs are out of order.
+ */
+bool TaskBodyCache::bOpen(const std::string &filename, int &NextId)
+{
+    vidClose();
+    auto Snapshot = std::make_unique<TaskSnapshotReader>(filename);
+    if (Snapshot->bIsValid() == false)
+    {
+        return false;
+    }
+    const std::vector<TaskSnapshotBlock> &Index = Snapshot->GetBlocks();
+    std::vector<std::size_t> FirstStub(Index.size() + 1, 0);
+    for (std::size_t Block = 0; Block < Index.size(); ++Block)
+    {
+        if (Block > 0 && Index[Block - 1].LastId >= Index[Block].FirstId)
+        {
+            return false;
+        }
+        FirstStub[Block + 1] = FirstStub[Block] + Index[Block].Count;
+    }
+
+    std::vector<TaskStub> Loaded(FirstStub.back());
+    std::size_t RunCount = std::max<std::size_t>(1, std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), Index.size()));
+    std::vector<char> Decoded(RunCount, 1);
+    auto vidDecodeRun = [&](std::size_t Run)
+    {
+        TaskSnapshotMeta Meta;
+        std::size_t Begin = Index.size() * Run / RunCount;
+        std::size_t End = Index.size() * (Run + 1) / RunCount;
+        for (std::size_t Block = Begin; Block < End; ++Block)
+        {
+            if (Snapshot->bReadMeta(Block, Meta) == false || Meta.Ids.size() != Index[Block].Count || Meta.Ids.empty() == true ||
+                Meta.Ids.front() != Index[Block].FirstId || Meta.Ids.back() != Index[Block].LastId ||
+                std::adjacent_find(Meta.Ids.begin(), Meta.Ids.end(), std::greater_equal<std::int32_t>()) != Meta.Ids.end())
+            {
+                Decoded[Run] = 0;
+                return;
+            }
+            for (std::size_t Row = 0; Row < Meta.Ids.size(); ++Row)
+            {
+                TaskStub &Stub = Loaded[FirstStub[Block] + Row];
+                Stub.Id = Meta.Ids[Row];
+                Stub.DueDay = Meta.DueDays[Row];
+                Stub.Block = static_cast<std::uint32_t>(Block);
+                Stub.TitleOffset = Meta.TitleOffsets[Row];
+                Stub.TitleLength = Meta.TitleOffsets[Row + 1] - Meta.TitleOffsets[Row];
+                Stub.DescOffset = Meta.DescOffsets[Row];
+                Stub.DescLength = Meta.DescOffsets[Row + 1] - Meta.DescOffsets[Row];
+                Stub.State = Meta.States[Row];
+                Stub.Priority = Meta.Priorities[Row];
+            }
+        }
+    };
+    std::vector<std::thread> Workers;
+    for (std::size_t Run = 1; Run < RunCount; ++Run)
+    {
+        Workers.emplace_back(vidDecodeRun, Run);
+    }
+    vidDecodeRun(0);
+    for (auto &Worker : Workers)
+    {
+        Worker.join();
+    }
+    if (std::find(Decoded.begin(), Decoded.end(), 0) != Decoded.end())
+    {
+        return false;
+    }
+
+    std::size_t MetaBytes = TASK_SNAPSHOT_HEADER_SIZE + Index.size() * TASK_SNAPSHOT_INDEX_ENTRY_SIZE;
+    for (const TaskSnapshotBlock &Entry : Index)
+    {
+        MetaBytes += Entry.MetaStored;
+    }
+    TASK_METRIC_COUNT(MetricCounter::BytesRead, MetaBytes);
+    NextId = Snapshot->int32GetNextId();
+    if (Loaded.empty() == false)
+    {
+        NextId = std::max(NextId, Loaded.back().Id + 1);
+    }
+    Stubs = std::move(Loaded);
+    Live = Stubs.size();
+    Reader = std::move(Snapshot);
+    Path = filename;
+    return true;
+}
+
+/**
+ * @brief Closes the snapshot and forgets every stub and task.
+ */
+void TaskBodyCache::vidClose(void)
+{
+    Reader.reset();
+    Path.clear();
+    std::vector<TaskStub>().swap(Stubs);
+    Live = 0;
+    Recent.clear();
+    Resident.clear();
+    Results.clear();
+    Blocks.clear();
+}
+
+/**
+ * @brief Tells whether a snapshot is open.
+ *
+ * @return true between a successful bOpen() and vidClose().
+ */
+bool TaskBodyCache::bIsOpen(void) const
+{
+    return Reader != nullptr;
+}
+
+/**
+ * @brief Gets the name of the open snapshot.
+ *
+ * @return File name, or an empty string if none is open.
+ */
+const std::string &TaskBodyCache::GetPath(void) const
+{
+    return Path;
+}
+
+/**
+ * @brief Sets the number of fetched tasks kept in memory before the oldest are dropped.
+ *
+ * @param Bodies Number of tasks, at least one.
+ */
+void TaskBodyCache::vidSetCapacity(std::size_t Bodies)
+{
+    Capacity = std::max<std::size_t>(Bodies, 1);
+}
+
+/**
+ * @brief Gets every stub, detached ones included.
+ *
+ * @return Stubs in ID order.
+ */
+const std::vector<TaskStub> &TaskBodyCache::GetStubs(void) const
+{
+    return Stubs;
+}
+
+/**
+ * @brief Finds the stub of a task that was not detached, by a binary search on its ID.
+ *
+ * @param id ID of the task.
+ * @return The stub, or nullptr if the snapshot does not hold the task or it was detached.
+ */
+const TaskStub *TaskBodyCache::FindStub(int id) const
+{
+    auto Found = std::lower_bound(Stubs.begin(), Stubs.end(), id, [](const TaskStub &Stub, int Id)
+                                  { return Stub.Id < Id; });
+    if (Found == Stubs.end() || Found->Id != id || Found->Live == false)
+    {
+        return nullptr;
+    }
+    return &*Found;
+}
+
+/**
+ * @brief Gets the text section of a block, decompressing it if it is not cached.
+ *
+ * @param Block Index of the block.
+ * @return The text, or nullptr if the block is corrupt.
+ */
+const std::string *TaskBodyCache::FindText(std::size_t Block)
+{
+    if (Reader == nullptr)
+    {
+        return nullptr;
+    }
+    auto Cached = std::find_if(Blocks.begin(), Blocks.end(), [Block](const CachedBlock &Entry)
+                               { return Entry.Index == Block; });
+    if (Cached != Blocks.end())
+    {
+        Blocks.splice(Blocks.begin(), Blocks, Cached);
+        return &Blocks.front().Text;
+    }
+    if (Blocks.size() >= TASK_BODY_CACHE_BLOCKS)
+    {
+        Blocks.splice(Blocks.begin(), Blocks, std::prev(Blocks.end()));
+    }
+    else
+    {
+        Blocks.emplace_front();
+    }
+    CachedBlock &Entry = Blocks.front();
+    Entry.Index = Block;
+    if (Reader->bReadText(Block, Entry.Text) == false)
+    {
+        Blocks.pop_front();
+        return nullptr;
+    }
+    TASK_METRIC_COUNT(MetricCounter::BytesRead, Reader->GetBlocks()[Block].TextStored);
+    return &Entry.Text;
+}
+
+/**
+ * @brief Builds a task from its stub, reusing the storage of the task passed in.
+ *
+ * @param Stub Stub of the task.
+ * @param task Receives the task.
+ * @param WithText false to leave the title and description empty.
+ * @return true on success, false if the block of the task is corrupt; its text is left empty then.
+ */
+bool TaskBodyCache::bLoad(const TaskStub &Stub, Task &task, bool WithText)
+{
+    std::string_view title;
+    std::string_view desc;
+    bool Intact = true;
+    if (WithText == true)
+    {
+        const std::string *Text = FindText(Stub.Block);
+        Intact = (Text != nullptr && std::size_t(Stub.TitleOffset) + Stub.TitleLength <= Text->size() &&
+                  std::size_t(Stub.DescOffset) + Stub.DescLength <= Text->size());
+        if (Intact == true)
+        {
+            title = std::string_view(*Text).substr(Stub.TitleOffset, Stub.TitleLength);
+            desc = std::string_view(*Text).substr(Stub.DescOffset, Stub.DescLength);
+        }
+    }
+    task.vidAssign(Stub.Id, title, desc, Stub.DueDay, Stub.Priority, Stub.State);
+    return Intact;
+}
+
+/**
+ * @brief Gets the task of a stub, built once and ranked as the most recently used.
+ *
+ * When the cache is full, the node of the least recently used task is moved
+ * to the front and the new task built in its storage.
+ *
+ * @param Stub Stub of the task.
+ * @param Intact Set to false if the block of the task is corrupt, in which case its text is empty.
+ * @return The task.
+ */
+const Task *TaskBodyCache::Fetch(const TaskStub &Stub, bool &Intact)
+{
+    Intact = true;
+    auto it = Resident.find(Stub.Id);
+    if (it != Resident.end())
+    {
+        Recent.splice(Recent.begin(), Recent, it->second);
+        return &Recent.front();
+    }
+    if (Recent.size() >= Capacity)
+    {
+        Resident.erase(Recent.back().int32GetTaskID());
+        Recent.splice(Recent.begin(), Recent, std::prev(Recent.end()));
+    }
+    else
+    {
+        Recent.emplace_front();
+    }
+    Intact = bLoad(Stub, Recent.front());
+    Resident.emplace(Stub.Id, Recent.begin());
+    ++Faults;
+    TASK_METRIC_COUNT(MetricCounter::BodyFaults, 1);
+    return &Recent.front();
+}
+
+/**
+ * @brief Builds the task of a stub and keeps it until vidDropResults(), whatever the capacity.
+ *
+ * @param Stub Stub of the task.
+ * @param Intact Set to false if the block of the task is corrupt, in which case its text is empty.
+ * @return The task.
+ */
+const Task *TaskBodyCache::Keep(const TaskStub &Stub, bool &Intact)
+{
+    Results.emplace_back();
+    Intact = bLoad(Stub, Results.back());
+    ++Faults;
+    TASK_METRIC_COUNT(MetricCounter::BodyFaults, 1);
+    return &Results.back();
+}
+
+/**
+ * @brief Drops the tasks built by Keep().
+ */
+void TaskBodyCache::vidDropResults(void)
+{
+    if (Results.empty() == false)
+    {
+        std::deque<Task>().swap(Results);
+    }
+}
+
+/**
+ * @brief Stops using the stub of a task, whose owner took it over.
+ *
+ * @param id ID of the task.
+ */
+void TaskBodyCache::vidDetach(int id)
+{
+    auto Found = std::lower_bound(Stubs.begin(), Stubs.end(), id, [](const TaskStub &Stub, int Id)
+                                  { return Stub.Id < Id; });
+    if (Found == Stubs.end() || Found->Id != id || Found->Live == false)
+    {
+        return;
+    }
+    Found->Live = false;
+    --Live;
+    auto it = Resident.find(id);
+    if (it != Resident.end())
+    {
+        Recent.erase(it->second);
+        Resident.erase(it);
+    }
+}
+
+/**
+ * @brief Gets the number of stubs not detached.
+ *
+ * @return Task count.
+ */
+std::size_t TaskBodyCache::u64GetLive(void) const
+{
+    return Live;
+}
+
+/**
+ * @brief Gets the number of fetched tasks in memory.
+ *
+ * @return Task count, not counting the ones built by Keep().
+ */
+std::size_t TaskBodyCache::u64GetResident(void) const
+{
+    return Resident.size();
+}
+
+/**
+ * @brief Gets the number of tasks built from the snapshot so far.
+ *
+ * @return Fault count.
+ */
+std::size_t TaskBodyCache::u64GetFaults(void) const
+{
+    return Faults;
+}
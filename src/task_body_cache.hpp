@@ -0,0 +1,221 @@
+/**
+ * @file task_body_cache.hpp
+ * @brief Declaration of the TaskBodyCache class, which loads tasks from a snapshot on demand.
+ *
+ * A lazy load reads only the metadata sections of a snapshot file (see
+ * task_snapshot.hpp) and keeps one compact stub per task: its ID, status,
+ * priority and due date, plus the block, offsets and lengths of its title
+ * and description in the text of that block. No Task object is built at
+ * load time. The cache then builds a task from its stub and the text of its
+ * block the first time the task is needed, and keeps the tasks it built in
+ * least recently used order, so their number stays bounded.
+ *
+ * A task that is changed or deleted is detached: its owner takes it over,
+ * and its stub is no longer used.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__BODY__CACHE__
+#define __TASK__BODY__CACHE__
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "task.hpp"
+#include "task_snapshot.hpp"
+
+/**
+ * @brief Number of tasks kept in memory by default in lazy mode.
+ */
+constexpr std::size_t TASK_BODY_CACHE_DEFAULT = 1 << 16;
+
+/**
+ * @brief Number of decompressed blocks kept to serve the next reads.
+ */
+constexpr std::size_t TASK_BODY_CACHE_BLOCKS = 4;
+
+/**
+ * @struct TaskStub
+ * @brief What a lazy load keeps of a task: its indexed fields and where its text is.
+ */
+struct TaskStub
+{
+    std::int32_t Id = 0;                            /**< Task ID. */
+    std::int32_t DueDay = TASK_NO_DUE_DATE;         /**< Due date as a day number, or TASK_NO_DUE_DATE. */
+    std::uint32_t Block = 0;                        /**< Index of the block holding the task. */
+    std::uint32_t TitleOffset = 0;                  /**< Offset of the title in the text section of the block. */
+    std::uint32_t TitleLength = 0;                  /**< Length of the title. */
+    std::uint32_t DescOffset = 0;                   /**< Offset of the description in the text section of the block. */
+    std::uint32_t DescLength = 0;                   /**< Length of the description. */
+    TaskState State = TaskState::Pending;           /**< Task status. */
+    TaskPriority Priority = TaskPriority::Unknown;  /**< Task priority. */
+    bool Live = true;                               /**< false once the task was detached. */
+};
+
+/**
+ * @class TaskBodyCache
+ * @brief Keeps the stubs of a lazily loaded snapshot and builds their tasks on demand.
+ *
+ * Tasks handed out by Fetch() stay valid until more than the capacity of
+ * newer ones were fetched, and tasks handed out by Keep() until the next
+ * vidDropResults(); both until the task is detached or the cache closed.
+ */
+class TaskBodyCache
+{
+private:
+    /**
+     * @struct CachedBlock
+     * @brief The decompressed text section of a block of the snapshot.
+     */
+    struct CachedBlock
+    {
+        std::size_t Index = 0;      /**< Index of the block in the snapshot. */
+        std::string Text;           /**< Titles and descriptions of the block. */
+    };
+
+    std::unique_ptr<TaskSnapshotReader> Reader;                     /**< Open snapshot, or nullptr. */
+    std::string Path;                                               /**< Name of the open snapshot. */
+    std::vector<TaskStub> Stubs;                                    /**< One stub per task of the snapshot, in ID order. */
+    std::size_t Live = 0;                                           /**< Number of stubs not detached. */
+    std::size_t Capacity = TASK_BODY_CACHE_DEFAULT;                 /**< Number of fetched tasks kept before the oldest are dropped. */
+    std::list<Task> Recent;                                         /**< Fetched tasks, most recently used first. */
+    std::unordered_map<int, std::list<Task>::iterator> Resident;    /**< Position of each fetched task in Recent. */
+    std::deque<Task> Results;                                       /**< Tasks built for the last query or search. */
+    std::list<CachedBlock> Blocks;                                  /**< Decompressed blocks, most recently used first. */
+    std::size_t Faults = 0;                                         /**< Number of tasks built from the snapshot. */
+
+    /**
+     * @brief Gets the text section of a block, decompressing it if it is not cached.
+     *
+     * @param Block Index of the block.
+     * @return The text, or nullptr if the block is corrupt.
+     */
+    const std::string *FindText(std::size_t Block);
+
+public:
+    /**
+     * @brief Opens a snapshot and reads the stubs of its tasks.
+     *
+     * Only the metadata sections are read, on several threads for large
+     * files. The task IDs must be in ascending order across the whole file,
+     * as in every snapshot the task managers write, so that a stub can be
+     * found by a binary search on its ID.
+     *
+     * @param filename Name of the snapshot file.
+     * @param NextId Receives the next task ID recorded in the snapshot, or the one after its last task if higher.
+     * @return true on success; false if the file is not a valid snapshot or its IDs are out of order.
+     */
+    bool bOpen(const std::string &filename, int &NextId);
+
+    /**
+     * @brief Closes the snapshot and forgets every stub and task.
+     */
+    void vidClose(void);
+
+    /**
+     * @brief Tells whether a snapshot is open.
+     *
+     * @return true between a successful bOpen() and vidClose().
+     */
+    bool bIsOpen(void) const;
+
+    /**
+     * @brief Gets the name of the open snapshot.
+     *
+     * @return File name, or an empty string if none is open.
+     */
+    const std::string &GetPath(void) const;
+
+    /**
+     * @brief Sets the number of fetched tasks kept in memory before the oldest are dropped.
+     *
+     * @param Bodies Number of tasks, at least one.
+     */
+    void vidSetCapacity(std::size_t Bodies);
+
+    /**
+     * @brief Gets every stub, detached ones included.
+     *
+     * @return Stubs in ID order.
+     */
+    const std::vector<TaskStub> &GetStubs(void) const;
+
+    /**
+     * @brief Finds the stub of a task that was not detached.
+     *
+     * @param id ID of the task.
+     * @return The stub, or nullptr if the snapshot does not hold the task or it was detached.
+     */
+    const TaskStub *FindStub(int id) const;
+
+    /**
+     * @brief Builds a task from its stub, reusing the storage of the task passed in.
+     *
+     * @param Stub Stub of the task.
+     * @param task Receives the task.
+     * @param WithText false to leave the title and description empty.
+     * @return true on success, false if the block of the task is corrupt; its text is left empty then.
+     */
+    bool bLoad(const TaskStub &Stub, Task &task, bool WithText = true);
+
+    /**
+     * @brief Gets the task of a stub, built once and ranked as the most recently used.
+     *
+     * The least recently used tasks beyond the capacity are dropped, never
+     * the one returned.
+     *
+     * @param Stub Stub of the task.
+     * @param Intact Set to false if the block of the task is corrupt, in which case its text is empty.
+     * @return The task.
+     */
+    const Task *Fetch(const TaskStub &Stub, bool &Intact);
+
+    /**
+     * @brief Builds the task of a stub and keeps it until vidDropResults(), whatever the capacity.
+     *
+     * @param Stub Stub of the task.
+     * @param Intact Set to false if the block of the task is corrupt, in which case its text is empty.
+     * @return The task.
+     */
+    const Task *Keep(const TaskStub &Stub, bool &Intact);
+
+    /**
+     * @brief Drops the tasks built by Keep().
+     */
+    void vidDropResults(void);
+
+    /**
+     * @brief Stops using the stub of a task, whose owner took it over.
+     *
+     * @param id ID of the task.
+     */
+    void vidDetach(int id);
+
+    /**
+     * @brief Gets the number of stubs not detached.
+     *
+     * @return Task count.
+     */
+    std::size_t u64GetLive(void) const;
+
+    /**
+     * @brief Gets the number of fetched tasks in memory.
+     *
+     * @return Task count, not counting the ones built by Keep().
+     */
+    std::size_t u64GetResident(void) const;
+
+    /**
+     * @brief Gets the number of tasks built from the snapshot so far.
+     *
+     * @return Fault count.
+     */
+    std::size_t u64GetFaults(void) const;
+};
+
+#endif // __TASK__BODY__CACHE__
@@ -0,0 +1,436 @@
+/**
+ * @file task_column_store.cpp
+ * @brief Implementation of the TaskColumnStore structure-of-arrays task store.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include <algorithm>
+#include "task_column_store.hpp"
+
+/**
+ * @brief Status code of a row whose task was removed; no filter matches it.
+ */
+static constexpr TaskState TASK_COLUMN_REMOVED = static_cast<TaskState>(0xFF);
+
+/**
+ * @brief Bias that maps signed 32-bit values onto unsigned values in the same order.
+ */
+static constexpr std::uint32_t TASK_COLUMN_SIGN_BIAS = 0x80000000u;
+
+/**
+ * @brief Dead text is compacted away once it makes up more than 1/N of the arena.
+ */
+static constexpr std::size_t TASK_COLUMN_DEAD_TEXT_RATIO = 2;
+
+/**
+ * @brief Minimum number of dead bytes before compacting the arena is worth it.
+ */
+static constexpr std::size_t TASK_COLUMN_DEAD_TEXT_MIN = 1 << 16;
+
+/**
+ * @brief Default constructor for TaskColumnStore.
+ */
+TaskColumnStore::TaskColumnStore()
+{
+}
+
+/**
+ * @brief Gets the (status, priority) pair of a row.
+ *
+ * @param State Task status.
+ * @param Priority Task priority.
+ * @return Position of the pair in PairCounts.
+ */
+std::size_t TaskColumnStore::u64PairOf(TaskState State, TaskPriority Priority)
+{
+    return static_cast<std::size_t>(State) * TASK_COLUMN_PRIORITY_COUNT + static_cast<std::size_t>(Priority);
+}
+
+/**
+ * @brief Tells whether the filter needs the due date column.
+ *
+ * @param Filter Filter to inspect.
+ * @return true if the filter restricts the due date.
+ */
+bool TaskColumnStore::bFiltersDueDate(const TaskFilter &Filter)
+{
+    return Filter.DueFrom != std::numeric_limits<std::int32_t>::min() ||
+           Filter.DueTo != std::numeric_limits<std::int32_t>::max();
+}
+
+/**
+ * @brief Calls a function on every live row matching a filter.
+ *
+ * Each condition is checked only when it is set, so an unfiltered column is
+ * never read; without a status condition, the status column is still read
+ * to skip tombstones.
+ *
+ * @param Filter Conditions to match.
+ * @param Visit Function called with each matching row number, in row order.
+ */
+template <typename Visitor>
+void TaskColumnStore::vidScan(const TaskFilter &Filter, Visitor &&Visit) const
+{
+    const bool FilterDue = bFiltersDueDate(Filter);
+    const std::size_t Rows = Ids.size();
+    for (std::size_t Row = 0; Row < Rows; ++Row)
+    {
+        if (((Filter.HasState == true) ? (States[Row] == Filter.State) : (States[Row] != TASK_COLUMN_REMOVED)) &&
+            (Filter.HasPriority == false || Priorities[Row] == Filter.Priority) &&
+            (FilterDue == false || (DueDays[Row] >= Filter.DueFrom && DueDays[Row] <= Filter.DueTo)))
+        {
+            Visit(Row);
+        }
+    }
+}
+
+/**
+ * @brief Tells whether the store has been built.
+ *
+ * @return true if the store has one row per slot of its task list.
+ */
+bool TaskColumnStore::bIsBuilt(void) const
+{
+    return Built;
+}
+
+/**
+ * @brief Fills the store from a task list, replacing its content.
+ *
+ * @param tasks Tasks to copy, one row per slot; tombstones become removed rows.
+ */
+void TaskColumnStore::vidBuild(const TaskList &tasks)
+{
+    vidClear();
+    Built = true;
+    std::size_t TextSize = 0;
+    for (auto &it : tasks)
+    {
+        TextSize += it.int32GetTaskTitle().size() + it.int32GetTaskDescription().size();
+    }
+    Ids.reserve(tasks.size());
+    States.reserve(tasks.size());
+    Priorities.reserve(tasks.size());
+    DueDays.reserve(tasks.size());
+    TextSpans.reserve(tasks.size());
+    TextArena.reserve(TextSize);
+    for (auto &it : tasks)
+    {
+        vidAppend(it);
+    }
+}
+
+/**
+ * @brief Empties the store and marks it as unbuilt.
+ */
+void TaskColumnStore::vidClear(void)
+{
+    Ids = std::vector<int>();
+    States = std::vector<TaskState>();
+    Priorities = std::vector<TaskPriority>();
+    DueDays = std::vector<std::int32_t>();
+    TextArena = std::string();
+    TextSpans = std::vector<TextSpan>();
+    DeadText = 0;
+    PairCounts.fill(0);
+    LiveRows = 0;
+    Built = false;
+}
+
+/**
+ * @brief Appends the text of a row to the arena.
+ *
+ * @param title Task title.
+ * @param desc Task description.
+ * @return Position of the text in the arena.
+ */
+TaskColumnStore::TextSpan TaskColumnStore::AppendText(std::string_view title, std::string_view desc)
+{
+    TextSpan Span;
+    Span.Offset = TextArena.size();
+    Span.TitleSize = static_cast<std::uint32_t>(title.size());
+    Span.DescSize = static_cast<std::uint32_t>(desc.size());
+    TextArena.append(title);
+    TextArena.append(desc);
+    return Span;
+}
+
+/**
+ * @brief Appends a task as a new row, for a task appended to the list.
+ *
+ * @param task Task to append.
+ */
+void TaskColumnStore::vidAppend(const Task &task)
+{
+    if (Built == false)
+    {
+        return;
+    }
+    bool Removed = task.bIsRemoved();
+    Ids.push_back(task.int32GetTaskID());
+    States.push_back((Removed == true) ? TASK_COLUMN_REMOVED : task.GetTaskState());
+    Priorities.push_back(task.GetTaskPriority());
+    DueDays.push_back(task.int32GetDueDay());
+    TextSpans.push_back((Removed == true) ? TextSpan() : AppendText(task.int32GetTaskTitle(), task.int32GetTaskDescription()));
+    if (Removed == false)
+    {
+        ++PairCounts[u64PairOf(task.GetTaskState(), task.GetTaskPriority())];
+        ++LiveRows;
+    }
+}
+
+/**
+ * @brief Copies the status, priority and due date of a task into its row.
+ *
+ * @param Row Row of the task.
+ * @param task Task with its current status, priority and due date.
+ */
+void TaskColumnStore::vidSetFields(std::size_t Row, const Task &task)
+{
+    if (Built == false || States[Row] == TASK_COLUMN_REMOVED)
+    {
+        return;
+    }
+    --PairCounts[u64PairOf(States[Row], Priorities[Row])];
+    States[Row] = task.GetTaskState();
+    Priorities[Row] = task.GetTaskPriority();
+    DueDays[Row] = task.int32GetDueDay();
+    ++PairCounts[u64PairOf(States[Row], Priorities[Row])];
+}
+
+/**
+ * @brief Replaces the title and description of a row.
+ *
+ * The new text is appended to the arena and the old text left behind; the
+ * arena is rewritten once dead text makes up half of it, which keeps the
+ * amortized cost of each change proportional to the text it writes.
+ *
+ * @param Row Row of the task.
+ * @param title New title.
+ * @param desc New description.
+ */
+void TaskColumnStore::vidSetText(std::size_t Row, std::string_view title, std::string_view desc)
+{
+    if (Built == false || States[Row] == TASK_COLUMN_REMOVED)
+    {
+        return;
+    }
+    DeadText += TextSpans[Row].TitleSize + TextSpans[Row].DescSize;
+    TextSpans[Row] = AppendText(title, desc);
+    if (DeadText >= TASK_COLUMN_DEAD_TEXT_MIN && DeadText * TASK_COLUMN_DEAD_TEXT_RATIO > TextArena.size())
+    {
+        vidCompactText();
+    }
+}
+
+/**
+ * @brief Turns a row into a tombstone, for a task removed from the list.
+ *
+ * @param Row Row of the task.
+ */
+void TaskColumnStore::vidRemove(std::size_t Row)
+{
+    if (Built == false || States[Row] == TASK_COLUMN_REMOVED)
+    {
+        return;
+    }
+    --PairCounts[u64PairOf(States[Row], Priorities[Row])];
+    --LiveRows;
+    States[Row] = TASK_COLUMN_REMOVED;
+    DeadText += TextSpans[Row].TitleSize + TextSpans[Row].DescSize;
+    TextSpans[Row] = TextSpan();
+    if (DeadText >= TASK_COLUMN_DEAD_TEXT_MIN && DeadText * TASK_COLUMN_DEAD_TEXT_RATIO > TextArena.size())
+    {
+        vidCompactText();
+    }
+}
+
+/**
+ * @brief Rewrites the arena with only the text rows still point to.
+ */
+void TaskColumnStore::vidCompactText(void)
+{
+    std::string Compacted;
+    Compacted.reserve(TextArena.size() - DeadText);
+    for (auto &Span : TextSpans)
+    {
+        std::uint64_t Offset = Compacted.size();
+        Compacted.append(TextArena, Span.Offset, Span.TitleSize + Span.DescSize);
+        Span.Offset = Offset;
+    }
+    TextArena.swap(Compacted);
+    DeadText = 0;
+}
+
+/**
+ * @brief Gets the number of rows, tombstones included.
+ *
+ * @return Row count.
+ */
+std::size_t TaskColumnStore::size(void) const
+{
+    return Ids.size();
+}
+
+/**
+ * @brief Gets an upper bound on the number of rows a filter matches, without scanning.
+ *
+ * @param Filter Conditions to match.
+ * @return Live rows of the requested status and priority, whatever their due date.
+ */
+std::size_t TaskColumnStore::u64Estimate(const TaskFilter &Filter) const
+{
+    std::size_t Count = 0;
+    for (std::size_t Pair = 0; Pair < PairCounts.size(); ++Pair)
+    {
+        auto State = static_cast<TaskState>(Pair / TASK_COLUMN_PRIORITY_COUNT);
+        auto Priority = static_cast<TaskPriority>(Pair % TASK_COLUMN_PRIORITY_COUNT);
+        if ((Filter.HasState == false || State == Filter.State) && (Filter.HasPriority == false || Priority == Filter.Priority))
+        {
+            Count += PairCounts[Pair];
+        }
+    }
+    return Count;
+}
+
+/**
+ * @brief Gets the number of rows that are not tombstones.
+ *
+ * @return Live row count.
+ */
+std::size_t TaskColumnStore::u64GetLive(void) const
+{
+    return LiveRows;
+}
+
+/**
+ * @brief Counts the rows matching a filter.
+ *
+ * A filter on status and priority alone is answered from the per-pair
+ * counts; any other filter scans only the columns it restricts.
+ *
+ * @param Filter Conditions to match.
+ * @return Number of matching rows.
+ */
+std::size_t TaskColumnStore::u64Count(const TaskFilter &Filter) const
+{
+    if (bFiltersDueDate(Filter) == false)
+    {
+        return u64Estimate(Filter);
+    }
+    std::size_t Count = 0;
+    vidScan(Filter, [&Count](std::size_t)
+            { ++Count; });
+    return Count;
+}
+
+/**
+ * @brief Collects the rows matching a filter.
+ *
+ * @param Filter Conditions to match.
+ * @return Row numbers of the matching rows, in row order.
+ */
+std::vector<std::size_t> TaskColumnStore::Select(const TaskFilter &Filter) const
+{
+    std::vector<std::size_t> Rows;
+    Rows.reserve(u64Estimate(Filter));
+    vidScan(Filter, [&Rows](std::size_t Row)
+            { Rows.push_back(Row); });
+    return Rows;
+}
+
+/**
+ * @brief Collects the rows matching a filter in the order TaskSecondaryIndex returns them.
+ *
+ * Each match is turned into a (due date, ID) key with its row number
+ * alongside, and the keys are sorted once; the text columns are never read.
+ *
+ * @param Filter Conditions to match.
+ * @return Row numbers of the matching rows, ordered by due date and then ID.
+ */
+std::vector<std::size_t> TaskColumnStore::SelectOrdered(const TaskFilter &Filter) const
+{
+    std::vector<std::pair<std::uint64_t, std::size_t>> Keys;
+    Keys.reserve(u64Estimate(Filter));
+    vidScan(Filter, [this, &Keys](std::size_t Row)
+            {
+        std::uint64_t High = static_cast<std::uint32_t>(DueDays[Row]) ^ TASK_COLUMN_SIGN_BIAS;
+        std::uint64_t Low = static_cast<std::uint32_t>(Ids[Row]) ^ TASK_COLUMN_SIGN_BIAS;
+        Keys.emplace_back((High << 32) | Low, Row); });
+    std::sort(Keys.begin(), Keys.end());
+    std::vector<std::size_t> Rows;
+    Rows.reserve(Keys.size());
+    for (auto &Key : Keys)
+    {
+        Rows.push_back(Key.second);
+    }
+    return Rows;
+}
+
+/**
+ * @brief Gets the ID of a row.
+ *
+ * @param Row Row number.
+ * @return Task ID.
+ */
+int TaskColumnStore::int32GetTaskID(std::size_t Row) const
+{
+    return Ids[Row];
+}
+
+/**
+ * @brief Gets the status of a row.
+ *
+ * @param Row Row number.
+ * @return Task status.
+ */
+TaskState TaskColumnStore::GetTaskState(std::size_t Row) const
+{
+    return States[Row];
+}
+
+/**
+ * @brief Gets the priority of a row.
+ *
+ * @param Row Row number.
+ * @return Task priority.
+ */
+TaskPriority TaskColumnStore::GetTaskPriority(std::size_t Row) const
+{
+    return Priorities[Row];
+}
+
+/**
+ * @brief Gets the due date of a row.
+ *
+ * @param Row Row number.
+ * @return Due date as a day number.
+ */
+std::int32_t TaskColumnStore::int32GetDueDay(std::size_t Row) const
+{
+    return DueDays[Row];
+}
+
+/**
+ * @brief Gets the title of a row.
+ *
+ * @param Row Row number.
+ * @return View into the text arena, valid until the store is modified.
+ */
+std::string_view TaskColumnStore::GetTitle(std::size_t Row) const
+{
+    return std::string_view(TextArena).substr(TextSpans[Row].Offset, TextSpans[Row].TitleSize);
+}
+
+/**
+ * @brief Gets the description of a row.
+ *
+ * @param Row Row number.
+ * @return View into the text arena, valid until the store is modified.
+ */
+std::string_view TaskColumnStore::GetDescription(std::size_t Row) const
+{
+    return std::string_view(TextArena).substr(TextSpans[Row].Offset + TextSpans[Row].TitleSize, TextSpans[Row].DescSize);
+}
@@ -0,0 +1,261 @@
+/**
+ * @file task_column_store.hpp
+ * @brief Declaration of the TaskColumnStore class, a structure-of-arrays copy of a task list.
+ *
+ * Each task field lives in its own contiguous column: IDs, one-byte status and
+ * priority codes, and due dates as day numbers. Titles and descriptions are
+ * packed into a single text arena addressed by offsets. Scans such as counting
+ * pending tasks only touch the columns they filter on, instead of pulling every
+ * string header of every task through the cache.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__COLUMN__STORE__
+#define __TASK__COLUMN__STORE__
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "task.hpp"
+#include "task_secondary_index.hpp"
+
+/**
+ * @brief Number of priority levels, and so of (status, priority) pairs per status.
+ */
+constexpr std::size_t TASK_COLUMN_PRIORITY_COUNT = static_cast<std::size_t>(TaskPriority::High) + 1;
+
+/**
+ * @brief Number of (status, priority) pairs a row can hold.
+ */
+constexpr std::size_t TASK_COLUMN_PAIR_COUNT = (static_cast<std::size_t>(TaskState::Done) + 1) * TASK_COLUMN_PRIORITY_COUNT;
+
+/**
+ * @class TaskColumnStore
+ * @brief Columnar copy of a task list, one row per slot of the list.
+ *
+ * Row N always describes slot N of the list it was built from, tombstones
+ * included, so a row number is also the slot of its task. The store starts
+ * out unbuilt, and changes are ignored until vidBuild() fills it, so task
+ * sets that are never scanned pay nothing for it.
+ */
+class TaskColumnStore
+{
+private:
+    /**
+     * @struct TextSpan
+     * @brief Where the title and description of a row are in the text arena.
+     */
+    struct TextSpan
+    {
+        std::uint64_t Offset = 0;       /**< Start of the title; the description follows it. */
+        std::uint32_t TitleSize = 0;    /**< Length of the title. */
+        std::uint32_t DescSize = 0;     /**< Length of the description. */
+    };
+
+    std::vector<int> Ids;                       /**< Task IDs. */
+    std::vector<TaskState> States;              /**< Task statuses, or TASK_COLUMN_REMOVED for a tombstone. */
+    std::vector<TaskPriority> Priorities;       /**< Task priorities. */
+    std::vector<std::int32_t> DueDays;          /**< Due dates as day numbers. */
+    std::string TextArena;                      /**< Titles and descriptions, back to back. */
+    std::vector<TextSpan> TextSpans;            /**< Text of each row in TextArena. */
+    std::size_t DeadText = 0;                   /**< Bytes of TextArena no row points to any more. */
+    std::array<std::size_t, TASK_COLUMN_PAIR_COUNT> PairCounts{};  /**< Live rows per (status, priority) pair. */
+    std::size_t LiveRows = 0;                   /**< Rows that are not tombstones. */
+    bool Built = false;                         /**< true once vidBuild() has run. */
+
+    /**
+     * @brief Gets the (status, priority) pair of a row.
+     *
+     * @param State Task status.
+     * @param Priority Task priority.
+     * @return Position of the pair in PairCounts.
+     */
+    static std::size_t u64PairOf(TaskState State, TaskPriority Priority);
+
+    /**
+     * @brief Tells whether the filter needs the due date column.
+     *
+     * @param Filter Filter to inspect.
+     * @return true if the filter restricts the due date.
+     */
+    static bool bFiltersDueDate(const TaskFilter &Filter);
+
+    /**
+     * @brief Calls a function on every live row matching a filter.
+     *
+     * @param Filter Conditions to match.
+     * @param Visit Function called with each matching row number, in row order.
+     */
+    template <typename Visitor>
+    void vidScan(const TaskFilter &Filter, Visitor &&Visit) const;
+
+    /**
+     * @brief Appends the text of a row to the arena.
+     *
+     * @param title Task title.
+     * @param desc Task description.
+     * @return Position of the text in the arena.
+     */
+    TextSpan AppendText(std::string_view title, std::string_view desc);
+
+    /**
+     * @brief Rewrites the arena with only the text rows still point to.
+     */
+    void vidCompactText(void);
+
+public:
+    /**
+     * @brief Default constructor for TaskColumnStore.
+     */
+    TaskColumnStore();
+
+    /**
+     * @brief Tells whether the store has been built.
+     *
+     * @return true if the store has one row per slot of its task list.
+     */
+    bool bIsBuilt(void) const;
+
+    /**
+     * @brief Fills the store from a task list, replacing its content.
+     *
+     * @param tasks Tasks to copy, one row per slot; tombstones become removed rows.
+     */
+    void vidBuild(const TaskList &tasks);
+
+    /**
+     * @brief Empties the store and marks it as unbuilt.
+     */
+    void vidClear(void);
+
+    /**
+     * @brief Appends a task as a new row, for a task appended to the list.
+     *
+     * @param task Task to append.
+     */
+    void vidAppend(const Task &task);
+
+    /**
+     * @brief Copies the status, priority and due date of a task into its row.
+     *
+     * @param Row Row of the task.
+     * @param task Task with its current status, priority and due date.
+     */
+    void vidSetFields(std::size_t Row, const Task &task);
+
+    /**
+     * @brief Replaces the title and description of a row.
+     *
+     * @param Row Row of the task.
+     * @param title New title.
+     * @param desc New description.
+     */
+    void vidSetText(std::size_t Row, std::string_view title, std::string_view desc);
+
+    /**
+     * @brief Turns a row into a tombstone, for a task removed from the list.
+     *
+     * @param Row Row of the task.
+     */
+    void vidRemove(std::size_t Row);
+
+    /**
+     * @brief Gets the number of rows, tombstones included.
+     *
+     * @return Row count.
+     */
+    std::size_t size(void) const;
+
+    /**
+     * @brief Gets an upper bound on the number of rows a filter matches, without scanning.
+     *
+     * @param Filter Conditions to match.
+     * @return Live rows of the requested status and priority, whatever their due date.
+     */
+    std::size_t u64Estimate(const TaskFilter &Filter) const;
+
+    /**
+     * @brief Gets the number of rows that are not tombstones.
+     *
+     * @return Live row count.
+     */
+    std::size_t u64GetLive(void) const;
+
+    /**
+     * @brief Counts the rows matching a filter.
+     *
+     * @param Filter Conditions to match.
+     * @return Number of matching rows.
+     */
+    std::size_t u64Count(const TaskFilter &Filter) const;
+
+    /**
+     * @brief Collects the rows matching a filter.
+     *
+     * @param Filter Conditions to match.
+     * @return Row numbers of the matching rows, in row order.
+     */
+    std::vector<std::size_t> Select(const TaskFilter &Filter) const;
+
+    /**
+     * @brief Collects the rows matching a filter in the order TaskSecondaryIndex returns them.
+     *
+     * @param Filter Conditions to match.
+     * @return Row numbers of the matching rows, ordered by due date and then ID.
+     */
+    std::vector<std::size_t> SelectOrdered(const TaskFilter &Filter) const;
+
+    /**
+     * @brief Gets the ID of a row.
+     *
+     * @param Row Row number.
+     * @return Task ID.
+     */
+    int int32GetTaskID(std::size_t Row) const;
+
+    /**
+     * @brief Gets the status of a row.
+     *
+     * @param Row Row number.
+     * @return Task status.
+     */
+    TaskState GetTaskState(std::size_t Row) const;
+
+    /**
+     * @brief Gets the priority of a row.
+     *
+     * @param Row Row number.
+     * @return Task priority.
+     */
+    TaskPriority GetTaskPriority(std::size_t Row) const;
+
+    /**
+     * @brief Gets the due date of a row.
+     *
+     * @param Row Row number.
+     * @return Due date as a day number.
+     */
+    std::int32_t int32GetDueDay(std::size_t Row) const;
+
+    /**
+     * @brief Gets the title of a row.
+     *
+     * @param Row Row number.
+     * @return View into the text arena, valid until the store is modified.
+     */
+    std::string_view GetTitle(std::size_t Row) const;
+
+    /**
+     * @brief Gets the description of a row.
+     *
+     * @param Row Row number.
+     * @return View into the text arena, valid until the store is modified.
+     */
+    std::string_view GetDescription(std::size_t Row) const;
+};
+
+#endif // __TASK__COLUMN__STORE__
@@ -0,0 +1,171 @@
+/**
+ * @file task_file.cpp
+ * @brief Implementation of the helpers reading and writing task files in any of their formats.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_file.hpp"
+#include "task_binary.hpp"
+#include "task_journal.hpp"
+#include "task_metrics.hpp"
+#include "task_snapshot.hpp"
+#include "task_text.hpp"
+#include "mapped_file.hpp"
+#include <filesystem>
+
+/**
+ * @brief Gets the format selected by the extension of a file name.
+ *
+ * @param filename Name of the task file.
+ * @return Format of the file.
+ */
+TaskFileFormat GetTaskFileFormat(const std::string &filename)
+{
+    if (IsPagedTaskFile(filename) == true)
+    {
+        return TaskFileFormat::Paged;
+    }
+    if (IsSnapshotTaskFile(filename) == true)
+    {
+        return TaskFileFormat::Snapshot;
+    }
+    return (IsBinaryTaskFile(filename) == true) ? TaskFileFormat::Binary : TaskFileFormat::Text;
+}
+
+/**
+ * @brief Finds a task the format of a file cannot hold.
+ *
+ * @param tasks Tasks to check; tombstones are skipped.
+ * @param filename Name of the file the tasks would be written to.
+ * @param id Receives the ID of the first task the format cannot hold.
+ * @return true if such a task was found, false if the format can hold every task.
+ */
+bool bFindUnencodableTask(const TaskList &tasks, const std::string &filename, int &id)
+{
+    if (GetTaskFileFormat(filename) == TaskFileFormat::Text)
+    {
+        return false;
+    }
+    for (auto &it : tasks)
+    {
+        if (it.bIsRemoved() == false && it.bHasRawFields() == true)
+        {
+            id = it.int32GetTaskID();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Writes tasks to a file atomically, in the format chosen by its extension.
+ *
+ * The tasks are written to "<filename>.tmp", synced to disk, and renamed over
+ * the target file. A paged file is written the same way by its layout, which
+ * then describes the new file. Nothing is written if the format cannot hold
+ * every task.
+ *
+ * @param tasks Tasks to write; tombstones are skipped.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the file.
+ * @param Pages Layout to rebuild when the file is paged, or nullptr to use a throwaway one.
+ * @return true on success, false if the file could not be written or cannot hold every task.
+ */
+bool WriteTaskFile(const TaskList &tasks, const std::string &filename, int NextId, TaskPageFile *Pages)
+{
+    std::error_code Error;
+    int Unencodable = 0;
+    if (bFindUnencodableTask(tasks, filename, Unencodable) == true)
+    {
+        return false;
+    }
+    TaskFileFormat Format = GetTaskFileFormat(filename);
+    if (Format == TaskFileFormat::Paged)
+    {
+        TaskPageFile Throwaway;
+        TaskPageFile &Layout = (Pages != nullptr) ? *Pages : Throwaway;
+        if (Layout.bCreate(tasks, filename, NextId) == false)
+        {
+            return false;
+        }
+        TASK_METRIC_COUNT(MetricCounter::BytesWritten, std::filesystem::file_size(filename, Error));
+        return true;
+    }
+    std::string TempFile = filename + ".tmp";
+    bool Written = (Format == TaskFileFormat::Snapshot) ? SaveTasksSnapshot(tasks, TempFile, NextId)
+                   : (Format == TaskFileFormat::Binary) ? SaveTasksBinary(tasks, TempFile, NextId)
+                                                        : SaveTasksText(tasks, TempFile, NextId);
+    if (Written == true && SyncFileToDisk(TempFile) == true)
+    {
+        std::filesystem::rename(TempFile, filename, Error);
+        if (!Error)
+        {
+            TASK_METRIC_COUNT(MetricCounter::BytesWritten, std::filesystem::file_size(filename, Error));
+            return true;
+        }
+    }
+    std::filesystem::remove(TempFile, Error);
+    return false;
+}
+
+/**
+ * @brief Reads the tasks of a file, in the format chosen by its extension.
+ *
+ * Text files are memory-mapped and parsed in place; the other formats are
+ * read by their own loaders.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the tasks are appended to.
+ * @param NextId Receives the next task ID recorded in the file, or 0 if it holds none.
+ * @param Pages Receives the layout of a paged file, or nullptr to use a throwaway one.
+ * @param MalformedLines Receives the numbers of the text lines that were skipped.
+ * @param NormalizedLines Receives the numbers of the text lines whose due date or priority was kept as text.
+ * @return true if the file was read, false if it could not be opened or is truncated or corrupt.
+ */
+bool ReadTaskFile(const std::string &filename, TaskList &tasks, int &NextId, TaskPageFile *Pages,
+                  std::vector<std::size_t> &MalformedLines, std::vector<std::size_t> &NormalizedLines)
+{
+    std::error_code Error;
+    NextId = 0;
+    switch (GetTaskFileFormat(filename))
+    {
+    case TaskFileFormat::Paged:
+    {
+        TaskPageFile Throwaway;
+        TaskPageFile &Layout = (Pages != nullptr) ? *Pages : Throwaway;
+        if (Layout.bLoad(filename, tasks, NextId) == false)
+        {
+            return false;
+        }
+        break;
+    }
+    case TaskFileFormat::Snapshot:
+        if (LoadTasksSnapshot(filename, tasks, NextId) == false)
+        {
+            return false;
+        }
+        break;
+    case TaskFileFormat::Binary:
+        if (LoadTasksBinary(filename, tasks, NextId) == false)
+        {
+            return false;
+        }
+        break;
+    case TaskFileFormat::Text:
+    {
+        MappedFile Content(filename);
+        if (Content.bIsOpen() == false)
+        {
+            return false;
+        }
+        TASK_METRIC_COUNT(MetricCounter::BytesRead, Content.View().size());
+        ParseTextNextId(Content.View(), NextId);
+        ParseTaskText(Content.View(), tasks, MalformedLines, NormalizedLines);
+        return true;
+    }
+    }
+    TASK_METRIC_COUNT(MetricCounter::BytesRead, std::filesystem::file_size(filename, Error));
+    return true;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file task_file.hpp
+ * @brief Declaration of the helpers reading and writing task files in any of their formats.
+ *
+ * The format of a task file is chosen by its extension: ".tdb" for the paged
+ * format (task_paged.hpp), ".tsnap" for compressed snapshots
+ * (task_snapshot.hpp), ".bin" for the binary format (task_binary.hpp), and
+ * the text format (task_text.hpp) for anything else. TaskManager and
+ * ConcurrentTaskManager both load and save through these helpers.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__FILE__
+#define __TASK__FILE__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "task.hpp"
+#include "task_paged.hpp"
+
+/**
+ * @enum TaskFileFormat
+ * @brief Formats a task file can be stored in.
+ */
+enum class TaskFileFormat : std::uint8_t
+{
+    Text,       /**< One line per task (task_text.hpp). */
+    Binary,     /**< Length-prefixed records (task_binary.hpp). */
+    Snapshot,   /**< Compressed blocks (task_snapshot.hpp). */
+    Paged       /**< Fixed-size pages that can be patched in place (task_paged.hpp). */
+};
+
+/**
+ * @brief Gets the format selected by the extension of a file name.
+ *
+ * @param filename Name of the task file.
+ * @return Format of the file.
+ */
+TaskFileFormat GetTaskFileFormat(const std::string &filename);
+
+/**
+ * @brief Finds a task the format of a file cannot hold.
+ *
+ * Only the text format keeps a due date or priority that was read as
+ * unrecognized text (see Task::bHasRawFields()).
+ *
+ * @param tasks Tasks to check; tombstones are skipped.
+ * @param filename Name of the file the tasks would be written to.
+ * @param id Receives the ID of the first task the format cannot hold.
+ * @return true if such a task was found, false if the format can hold every task.
+ */
+bool bFindUnencodableTask(const TaskList &tasks, const std::string &filename, int &id);
+
+/**
+ * @brief Writes tasks to a file atomically, in the format chosen by its extension.
+ *
+ * Nothing is written if the format cannot hold every task (see
+ * bFindUnencodableTask()), so no due date or priority text is dropped.
+ *
+ * @param tasks Tasks to write; tombstones are skipped.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the file.
+ * @param Pages Layout to rebuild when the file is paged, or nullptr to use a throwaway one.
+ * @return true on success, false if the file could not be written or cannot hold every task.
+ */
+bool WriteTaskFile(const TaskList &tasks, const std::string &filename, int NextId, TaskPageFile *Pages = nullptr);
+
+/**
+ * @brief Reads the tasks of a file, in the format chosen by its extension.
+ *
+ * Lines of a text file that cannot be parsed are skipped and reported rather
+ * than failing the read.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the tasks are appended to.
+ * @param NextId Receives the next task ID recorded in the file, or 0 if it holds none.
+ * @param Pages Receives the layout of a paged file, or nullptr to use a throwaway one.
+ * @param MalformedLines Receives the numbers of the text lines that were skipped.
+ * @param NormalizedLines Receives the numbers of the text lines whose due date or priority was kept as text.
+ * @return true if the file was read, false if it could not be opened or is truncated or corrupt.
+ */
+bool ReadTaskFile(const std::string &filename, TaskList &tasks, int &NextId, TaskPageFile *Pages,
+                  std::vector<std::size_t> &MalformedLines, std::vector<std::size_t> &NormalizedLines);
+
+#endif // __TASK__FILE__
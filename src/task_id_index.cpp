@@ -0,0 +1,202 @@
+/**
+ * @file task_id_index.cpp
+ * @brief Implementation of the TaskIdIndex class.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_id_index.hpp"
+
+/**
+ * @brief Gets the position an ID is looked for from.
+ *
+ * Fibonacci hashing: the ID is multiplied by 2^64 divided by the golden ratio
+ * and the top bits are kept, which spreads consecutive IDs across the table.
+ *
+ * @param id Task ID.
+ * @return Position in Table.
+ */
+std::size_t TaskIdIndex::u64Home(int id) const
+{
+    std::uint64_t Hash = static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(Hash >> Shift);
+}
+
+/**
+ * @brief Gets the position of an ID in the table.
+ *
+ * The table is never full, so the probe always ends.
+ *
+ * @param id Task ID.
+ * @return Position of its entry, or of the free entry where it would go.
+ */
+std::size_t TaskIdIndex::u64Probe(int id) const
+{
+    std::size_t Mask = Table.size() - 1;
+    std::size_t Position = u64Home(id);
+    while (Table[Position].Slot != TASK_ID_INDEX_EMPTY && Table[Position].Id != id)
+    {
+        Position = (Position + 1) & Mask;
+    }
+    return Position;
+}
+
+/**
+ * @brief Moves every entry into a new table.
+ *
+ * @param Capacity Number of entries of the new table, a power of two.
+ */
+void TaskIdIndex::vidRehash(std::size_t Capacity)
+{
+    std::vector<Entry> Old(Capacity);
+    Old.swap(Table);
+    Shift = 64;
+    for (std::size_t Size = Capacity; Size > 1; Size >>= 1)
+    {
+        --Shift;
+    }
+    for (const Entry &it : Old)
+    {
+        if (it.Slot != TASK_ID_INDEX_EMPTY)
+        {
+            Table[u64Probe(it.Id)] = it;
+        }
+    }
+}
+
+/**
+ * @brief Finds the slot of a task.
+ *
+ * @param id Task ID.
+ * @return Pointer to the slot, valid until the next insertion or removal, or nullptr if the ID is not indexed.
+ */
+std::size_t *TaskIdIndex::Find(int id)
+{
+    if (Count == 0)
+    {
+        return nullptr;
+    }
+    Entry &Found = Table[u64Probe(id)];
+    return (Found.Slot == TASK_ID_INDEX_EMPTY) ? nullptr : &Found.Slot;
+}
+
+/**
+ * @brief Finds the slot of a task.
+ *
+ * @param id Task ID.
+ * @return Pointer to the slot, valid until the next insertion or removal, or nullptr if the ID is not indexed.
+ */
+const std::size_t *TaskIdIndex::Find(int id) const
+{
+    if (Count == 0)
+    {
+        return nullptr;
+    }
+    const Entry &Found = Table[u64Probe(id)];
+    return (Found.Slot == TASK_ID_INDEX_EMPTY) ? nullptr : &Found.Slot;
+}
+
+/**
+ * @brief Sets the slot of a task, adding the ID if it is not indexed.
+ *
+ * @param id Task ID.
+ * @param Slot Slot of the task.
+ */
+void TaskIdIndex::vidSet(int id, std::size_t Slot)
+{
+    if ((Count + 1) * 4 > Table.size() * 3)
+    {
+        vidRehash((Table.empty() == true) ? TASK_ID_INDEX_MIN_CAPACITY : Table.size() * 2);
+    }
+    Entry &Found = Table[u64Probe(id)];
+    if (Found.Slot == TASK_ID_INDEX_EMPTY)
+    {
+        Found.Id = id;
+        ++Count;
+    }
+    Found.Slot = Slot;
+}
+
+/**
+ * @brief Removes a task from the index.
+ *
+ * The entries after it in its probe run are shifted back into the hole
+ * unless that would move one before its home position, so every remaining
+ * entry stays reachable from its home without tombstones.
+ *
+ * @param id Task ID.
+ * @return true if the ID was indexed.
+ */
+bool TaskIdIndex::bErase(int id)
+{
+    if (Count == 0)
+    {
+        return false;
+    }
+    std::size_t Mask = Table.size() - 1;
+    std::size_t Hole = u64Probe(id);
+    if (Table[Hole].Slot == TASK_ID_INDEX_EMPTY)
+    {
+        return false;
+    }
+    std::size_t Next = Hole;
+    while (true)
+    {
+        Next = (Next + 1) & Mask;
+        if (Table[Next].Slot == TASK_ID_INDEX_EMPTY)
+        {
+            break;
+        }
+        std::size_t Home = u64Home(Table[Next].Id);
+        bool Stays = (Hole <= Next) ? (Hole < Home && Home <= Next) : (Hole < Home || Home <= Next);
+        if (Stays == false)
+        {
+            Table[Hole] = Table[Next];
+            Hole = Next;
+        }
+    }
+    Table[Hole] = Entry();
+    --Count;
+    return true;
+}
+
+/**
+ * @brief Removes every entry, keeping the table for reuse.
+ */
+void TaskIdIndex::vidClear(void)
+{
+    for (Entry &it : Table)
+    {
+        it = Entry();
+    }
+    Count = 0;
+}
+
+/**
+ * @brief Makes room for a number of entries without growing again.
+ *
+ * @param Entries Number of entries.
+ */
+void TaskIdIndex::vidReserve(std::size_t Entries)
+{
+    std::size_t Capacity = (Table.empty() == true) ? TASK_ID_INDEX_MIN_CAPACITY : Table.size();
+    while (Entries * 4 > Capacity * 3)
+    {
+        Capacity *= 2;
+    }
+    if (Capacity > Table.size())
+    {
+        vidRehash(Capacity);
+    }
+}
+
+/**
+ * @brief Gets the number of indexed tasks.
+ *
+ * @return Entry count.
+ */
+std::size_t TaskIdIndex::u64GetSize(void) const
+{
+    return Count;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file task_id_index.hpp
+ * @brief Declaration of the TaskIdIndex class, an open-addressing map from task IDs to slots.
+ *
+ * Entries are stored inline in one power-of-two table and found by linear
+ * probing from a multiplicative hash of the ID, so a lookup touches one or a
+ * few adjacent cache lines and never follows a pointer. Removals shift the
+ * following entries of the probe run back instead of leaving tombstones,
+ * which keeps probe runs short however many tasks are deleted. The table only
+ * allocates when it grows, so IDs freed by deletions are reused for free.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__ID__INDEX__
+#define __TASK__ID__INDEX__
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * @brief Slot value marking an empty entry of the table.
+ */
+constexpr std::size_t TASK_ID_INDEX_EMPTY = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Smallest number of entries of a non-empty table.
+ */
+constexpr std::size_t TASK_ID_INDEX_MIN_CAPACITY = 16;
+
+/**
+ * @class TaskIdIndex
+ * @brief Maps each task ID to its slot in the task list, with open addressing.
+ *
+ * The table is grown to twice its size once it is three quarters full.
+ */
+class TaskIdIndex
+{
+private:
+    /**
+     * @struct Entry
+     * @brief One entry of the table.
+     */
+    struct Entry
+    {
+        int Id = 0;                                 /**< Task ID. */
+        std::size_t Slot = TASK_ID_INDEX_EMPTY;     /**< Slot of the task, or TASK_ID_INDEX_EMPTY if the entry is free. */
+    };
+
+    std::vector<Entry> Table;   /**< Entries; the size is zero or a power of two. */
+    std::size_t Count = 0;      /**< Number of entries in use. */
+    unsigned Shift = 64;        /**< Right shift turning a 64-bit hash into a position in Table. */
+
+    /**
+     * @brief Gets the position an ID is looked for from.
+     *
+     * @param id Task ID.
+     * @return Position in Table.
+     */
+    std::size_t u64Home(int id) const;
+
+    /**
+     * @brief Gets the position of an ID in the table.
+     *
+     * @param id Task ID.
+     * @return Position of its entry, or of the free entry where it would go.
+     */
+    std::size_t u64Probe(int id) const;
+
+    /**
+     * @brief Moves every entry into a new table.
+     *
+     * @param Capacity Number of entries of the new table, a power of two.
+     */
+    void vidRehash(std::size_t Capacity);
+
+public:
+    /**
+     * @brief Finds the slot of a task.
+     *
+     * @param id Task ID.
+     * @return Pointer to the slot, valid until the next insertion or removal, or nullptr if the ID is not indexed.
+     */
+    std::size_t *Find(int id);
+
+    /**
+     * @brief Finds the slot of a task.
+     *
+     * @param id Task ID.
+     * @return Pointer to the slot, valid until the next insertion or removal, or nullptr if the ID is not indexed.
+     */
+    const std::size_t *Find(int id) const;
+
+    /**
+     * @brief Sets the slot of a task, adding the ID if it is not indexed.
+     *
+     * @param id Task ID.
+     * @param Slot Slot of the task.
+     */
+    void vidSet(int id, std::size_t Slot);
+
+    /**
+     * @brief Removes a task from the index.
+     *
+     * @param id Task ID.
+     * @return true if the ID was indexed.
+     */
+    bool bErase(int id);
+
+    /**
+     * @brief Removes every entry, keeping the table for reuse.
+     */
+    void vidClear(void);
+
+    /**
+     * @brief Makes room for a number of entries without growing again.
+     *
+     * @param Entries Number of entries.
+     */
+    void vidReserve(std::size_t Entries);
+
+    /**
+     * @brief Gets the number of indexed tasks.
+     *
+     * @return Entry count.
+     */
+    std::size_t u64GetSize(void) const;
+};
+
+#endif // __TASK__ID__INDEX__
@@ -0,0 +1,454 @@
+/**
+ * @file task_journal.cpp
+ * @brief Implementation of the TaskJournal write-ahead log.
+ *
+ * Each record is framed as a 32-bit payload length and a 64-bit checksum of the
+ * payload, followed by the payload itself. The payload starts with a record type
+ * byte; put records continue with the binary task record used by binary task
+ * files, delete records with the 32-bit task ID, and status records with the
+ * new status byte, a 32-bit ID count and the 32-bit task IDs. Put records of
+ * a task holding unrecognized due date or priority text have a type of their
+ * own and end with the two texts.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_journal.hpp"
+#include "task_binary.hpp"
+#include "mapped_file.hpp"
+#include "task_metrics.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define TASK_HAS_FSYNC 1
+#else
+#define TASK_HAS_FSYNC 0
+#endif
+
+/**
+ * @brief Size in bytes of the frame in front of each record payload.
+ */
+static constexpr std::size_t TASK_JOURNAL_FRAME_SIZE = 12;
+
+/**
+ * @brief Payload type of a record holding the full state of a task in the version 1 layout.
+ */
+static constexpr std::uint8_t TASK_JOURNAL_PUT_V1 = 1;
+
+/**
+ * @brief Payload type of a record deleting a task.
+ */
+static constexpr std::uint8_t TASK_JOURNAL_DELETE = 2;
+
+/**
+ * @brief Payload type of a record holding the full state of a task.
+ */
+static constexpr std::uint8_t TASK_JOURNAL_PUT = 3;
+
+/**
+ * @brief Payload type of a record setting the status of a batch of tasks.
+ */
+static constexpr std::uint8_t TASK_JOURNAL_STATUS = 4;
+
+/**
+ * @brief Payload type of a put record followed by the unrecognized due date and priority text of the task.
+ */
+static constexpr std::uint8_t TASK_JOURNAL_PUT_RAW = 5;
+
+/**
+ * @brief Size of the file buffer that holds records between flushes.
+ */
+static constexpr std::size_t TASK_JOURNAL_BUFFER_SIZE = 1 << 20;
+
+/**
+ * @brief Default constructor for TaskJournal.
+ */
+TaskJournal::TaskJournal() = default;
+
+/**
+ * @brief Opens a journal file for appending, creating it if needed.
+ *
+ * @param path Name of the journal file.
+ * @return true if the journal is open, false otherwise.
+ */
+bool TaskJournal::bOpen(const std::string &path)
+{
+    vidClose();
+    File = std::fopen(path.c_str(), "ab");
+    if (File != nullptr)
+    {
+        std::setvbuf(File, nullptr, _IOFBF, TASK_JOURNAL_BUFFER_SIZE);
+    }
+    RecordCount = 0;
+    UnsyncedRecords = 0;
+    return File != nullptr;
+}
+
+/**
+ * @brief Closes the journal.
+ *
+ * A background fsync still running keeps its own descriptor, so closing never
+ * waits for it.
+ *
+ * @param Sync true to fsync the journal before closing it; false leaves it
+ *        to the caller, which must then sync the file by name.
+ */
+void TaskJournal::vidClose(bool Sync)
+{
+    if (File != nullptr)
+    {
+        if (Sync == true)
+        {
+            vidSync();
+        }
+        else
+        {
+            std::fflush(File);
+        }
+        std::fclose(File);
+        File = nullptr;
+    }
+}
+
+/**
+ * @brief Tells whether the journal is open.
+ *
+ * @return true if records can be appended.
+ */
+bool TaskJournal::bIsOpen(void) const
+{
+    return File != nullptr;
+}
+
+/**
+ * @brief Frames the encoded payload in Record and writes it to the journal.
+ *
+ * The frame is filled into the space reserved at the front of Record, so the
+ * whole record reaches the operating system in a single write. An fsync is
+ * issued once TASK_JOURNAL_SYNC_BATCH records have accumulated. While batching,
+ * the record stays in the file buffer until the next vidSync().
+ */
+void TaskJournal::vidWriteRecord(void)
+{
+    const char *Payload = Record.data() + TASK_JOURNAL_FRAME_SIZE;
+    std::size_t PayloadSize = Record.size() - TASK_JOURNAL_FRAME_SIZE;
+    std::string Frame;
+    BinaryWriter Writer(Frame);
+    Writer.vidWriteU32(static_cast<std::uint32_t>(PayloadSize));
+    Writer.vidWriteU64(u64Checksum(Payload, PayloadSize));
+    Record.replace(0, TASK_JOURNAL_FRAME_SIZE, Frame);
+
+    std::fwrite(Record.data(), 1, Record.size(), File);
+    TASK_METRIC_COUNT(MetricCounter::BytesWritten, Record.size());
+    ++RecordCount;
+    ++UnsyncedRecords;
+    if (Batching == true)
+    {
+        return;
+    }
+    std::fflush(File);
+    if (UnsyncedRecords >= TASK_JOURNAL_SYNC_BATCH)
+    {
+        vidRequestSync();
+    }
+}
+
+/**
+ * @brief Asks the sync thread to fsync everything written so far, without waiting for it.
+ *
+ * The thread gets a duplicate of the journal descriptor, so it can finish even
+ * if the journal is closed or reopened in the meantime. A request still
+ * waiting to start already covers the records written since, so it is not
+ * repeated.
+ */
+void TaskJournal::vidRequestSync(void)
+{
+#if TASK_HAS_FSYNC
+    std::lock_guard<std::mutex> Guard(SyncLock);
+    if (SyncThread.joinable() == false)
+    {
+        SyncThread = std::thread(&TaskJournal::vidRunSync, this);
+    }
+    if (PendingSync < 0)
+    {
+        PendingSync = ::dup(::fileno(File));
+        SyncSignal.notify_one();
+    }
+#endif
+    UnsyncedRecords = 0;
+}
+
+/**
+ * @brief Body of the sync thread.
+ *
+ * A pending request is always served before the thread exits.
+ */
+void TaskJournal::vidRunSync(void)
+{
+#if TASK_HAS_FSYNC
+    std::unique_lock<std::mutex> Guard(SyncLock);
+    while (true)
+    {
+        SyncSignal.wait(Guard, [this]()
+        {
+            return PendingSync >= 0 || StopSync == true;
+        });
+        if (PendingSync < 0)
+        {
+            return;
+        }
+        int Descriptor = PendingSync;
+        PendingSync = -1;
+        Guard.unlock();
+        ::fsync(Descriptor);
+        ::close(Descriptor);
+        Guard.lock();
+    }
+#endif
+}
+
+/**
+ * @brief Appends a record holding the full state of a task.
+ *
+ * @param task Task that was added or modified.
+ */
+void TaskJournal::vidAppendPut(const Task &task)
+{
+    if (File == nullptr)
+    {
+        return;
+    }
+    Record.assign(TASK_JOURNAL_FRAME_SIZE, '\0');
+    BinaryWriter Writer(Record);
+    Writer.vidWriteU8((task.bHasRawFields() == true) ? TASK_JOURNAL_PUT_RAW : TASK_JOURNAL_PUT);
+    Writer.vidWriteTask(task);
+    if (task.bHasRawFields() == true)
+    {
+        Writer.vidWriteString(task.GetRawDueDate());
+        Writer.vidWriteString(task.GetRawPriority());
+    }
+    vidWriteRecord();
+}
+
+/**
+ * @brief Appends a record deleting a task.
+ *
+ * @param id ID of the deleted task.
+ */
+void TaskJournal::vidAppendDelete(int id)
+{
+    if (File == nullptr)
+    {
+        return;
+    }
+    Record.assign(TASK_JOURNAL_FRAME_SIZE, '\0');
+    BinaryWriter Writer(Record);
+    Writer.vidWriteU8(TASK_JOURNAL_DELETE);
+    Writer.vidWriteU32(static_cast<std::uint32_t>(id));
+    vidWriteRecord();
+}
+
+/**
+ * @brief Appends one record setting the status of a batch of tasks.
+ *
+ * @param ids IDs of the updated tasks.
+ * @param state New status of the tasks.
+ */
+void TaskJournal::vidAppendStatus(const std::vector<int> &ids, TaskState state)
+{
+    if (File == nullptr || ids.empty() == true)
+    {
+        return;
+    }
+    Record.assign(TASK_JOURNAL_FRAME_SIZE, '\0');
+    BinaryWriter Writer(Record);
+    Writer.vidWriteU8(TASK_JOURNAL_STATUS);
+    Writer.vidWriteU8(static_cast<std::uint8_t>(state));
+    Writer.vidWriteU32(static_cast<std::uint32_t>(ids.size()));
+    for (int id : ids)
+    {
+        Writer.vidWriteU32(static_cast<std::uint32_t>(id));
+    }
+    vidWriteRecord();
+}
+
+/**
+ * @brief Forces all appended records to disk.
+ */
+void TaskJournal::vidSync(void)
+{
+    if (File == nullptr || UnsyncedRecords == 0)
+    {
+        return;
+    }
+    std::fflush(File);
+#if TASK_HAS_FSYNC
+    ::fsync(::fileno(File));
+#endif
+    UnsyncedRecords = 0;
+}
+
+/**
+ * @brief Turns batching of appended records on or off.
+ *
+ * @param Enabled true to start batching, false to stop.
+ */
+void TaskJournal::vidSetBatching(bool Enabled)
+{
+    Batching = Enabled;
+    if (Enabled == false)
+    {
+        vidSync();
+    }
+}
+
+/**
+ * @brief Gets the number of records appended since the journal was opened.
+ *
+ * @return Record count.
+ */
+std::size_t TaskJournal::u64RecordCount(void) const
+{
+    return RecordCount;
+}
+
+/**
+ * @brief Replays the records of a journal file in order.
+ *
+ * @param path Name of the journal file.
+ * @param OnPut Called with the task held by each put record.
+ * @param OnDelete Called with the task ID held by each delete record.
+ * @param OnStatus Called with the task IDs and new status held by each status record.
+ * @param ValidLength Receives the length in bytes of the valid prefix of the journal.
+ * @return Number of records replayed.
+ */
+std::size_t TaskJournal::u64Replay(const std::string &path, const std::function<void(const Task &)> &OnPut,
+                                   const std::function<void(int)> &OnDelete,
+                                   const std::function<void(const std::vector<int> &, TaskState)> &OnStatus,
+                                   std::size_t &ValidLength)
+{
+    ValidLength = 0;
+    MappedFile File(path);
+    std::string_view Content = File.View();
+    TASK_METRIC_COUNT(MetricCounter::BytesRead, Content.size());
+    std::size_t Replayed = 0;
+    Task temp;
+    std::vector<int> ids;
+    while (Content.size() >= TASK_JOURNAL_FRAME_SIZE)
+    {
+        BinaryReader Frame(Content.data(), TASK_JOURNAL_FRAME_SIZE);
+        std::size_t PayloadSize = Frame.u32Read();
+        std::uint64_t Checksum = Frame.u64Read();
+        if (Content.size() - TASK_JOURNAL_FRAME_SIZE < PayloadSize)
+        {
+            break;
+        }
+        const char *Payload = Content.data() + TASK_JOURNAL_FRAME_SIZE;
+        if (u64Checksum(Payload, PayloadSize) != Checksum)
+        {
+            break;
+        }
+
+        BinaryReader Reader(Payload, PayloadSize);
+        std::uint8_t Type = Reader.u8Read();
+        if (Type == TASK_JOURNAL_PUT || Type == TASK_JOURNAL_PUT_V1)
+        {
+            if (Reader.bReadTask(temp, (Type == TASK_JOURNAL_PUT_V1) ? 1 : TASK_BINARY_VERSION) == false)
+            {
+                break;
+            }
+            OnPut(temp);
+        }
+        else if (Type == TASK_JOURNAL_PUT_RAW)
+        {
+            if (Reader.bReadTask(temp) == false)
+            {
+                break;
+            }
+            std::string_view RawDueDate = Reader.svRead();
+            std::string_view RawPriority = Reader.svRead();
+            if (Reader.bFailed() == true)
+            {
+                break;
+            }
+            temp.vidKeepRawFields(RawDueDate, RawPriority);
+            OnPut(temp);
+        }
+        else if (Type == TASK_JOURNAL_DELETE)
+        {
+            int id = static_cast<int>(Reader.u32Read());
+            if (Reader.bFailed() == true)
+            {
+                break;
+            }
+            OnDelete(id);
+        }
+        else if (Type == TASK_JOURNAL_STATUS)
+        {
+            std::uint8_t State = Reader.u8Read();
+            std::size_t Count = Reader.u32Read();
+            if (Reader.bFailed() == true || State > static_cast<std::uint8_t>(TaskState::Done) ||
+                Count != Reader.u64Remaining() / sizeof(std::uint32_t))
+            {
+                break;
+            }
+            ids.resize(Count);
+            for (auto &id : ids)
+            {
+                id = static_cast<int>(Reader.u32Read());
+            }
+            OnStatus(ids, static_cast<TaskState>(State));
+        }
+        else
+        {
+            break;
+        }
+
+        ++Replayed;
+        ValidLength += TASK_JOURNAL_FRAME_SIZE + PayloadSize;
+        Content.remove_prefix(TASK_JOURNAL_FRAME_SIZE + PayloadSize);
+    }
+    return Replayed;
+}
+
+/**
+ * @brief Syncs and closes the journal, and stops the sync thread.
+ */
+TaskJournal::~TaskJournal()
+{
+    vidClose();
+    if (SyncThread.joinable() == true)
+    {
+        {
+            std::lock_guard<std::mutex> Guard(SyncLock);
+            StopSync = true;
+        }
+        SyncSignal.notify_one();
+        SyncThread.join();
+    }
+}
+
+/**
+ * @brief Forces the content of a file that was written and closed to disk.
+ *
+ * @param path Name of the file.
+ * @return true on success, false if the file could not be synced.
+ */
+bool SyncFileToDisk(const std::string &path)
+{
+#if TASK_HAS_FSYNC
+    int Descriptor = ::open(path.c_str(), O_RDONLY);
+    if (Descriptor < 0)
+    {
+        return false;
+    }
+    bool Synced = (::fsync(Descriptor) == 0);
+    ::close(Descriptor);
+    return Synced;
+#else
+    (void)path;
+    return true;
+#endif
+}
@@ -0,0 +1,184 @@
+/**
+ * @file task_journal.hpp
+ * @brief Declaration of the TaskJournal class, an append-only write-ahead log of task mutations.
+ *
+ * Every mutation is appended to the journal as one small, checksummed record:
+ * a "put" record holding the full new state of a task, a "delete" record
+ * holding a task ID, or a "status" record holding the new status of a batch
+ * of task IDs. All kinds are idempotent, so replaying a journal
+ * on top of a snapshot that already contains some of its records is harmless.
+ *
+ * Records are handed to the operating system as soon as they are appended, so
+ * they survive the process being killed, and are fsynced to disk in batches by
+ * a background thread, so appending never waits for the disk. vidSync() is the
+ * barrier for callers that need every record on disk before going on.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__JOURNAL__
+#define __TASK__JOURNAL__
+
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "task.hpp"
+
+/**
+ * @brief Number of appended records after which a background fsync of the journal is requested.
+ */
+constexpr std::size_t TASK_JOURNAL_SYNC_BATCH = 64;
+
+/**
+ * @brief Minimum number of journal records before a compaction is considered.
+ */
+constexpr std::size_t TASK_JOURNAL_COMPACT_MIN = 4096;
+
+/**
+ * @class TaskJournal
+ * @brief Append-only log of task mutations.
+ */
+class TaskJournal
+{
+private:
+    std::FILE *File = nullptr;          /**< Journal file opened for appending. */
+    std::string Record;                 /**< Reusable buffer for encoding a record. */
+    std::size_t UnsyncedRecords = 0;    /**< Records written since the last fsync. */
+    std::size_t RecordCount = 0;        /**< Records appended since the journal was opened. */
+    bool Batching = false;              /**< true while records are held back until the next vidSync(). */
+    std::thread SyncThread;             /**< Background thread fsyncing the journal, started on the first request. */
+    std::mutex SyncLock;                /**< Guards PendingSync and StopSync. */
+    std::condition_variable SyncSignal; /**< Wakes the sync thread up. */
+    int PendingSync = -1;               /**< Duplicate of the journal descriptor waiting to be fsynced, or -1. */
+    bool StopSync = false;              /**< true once the sync thread must exit. */
+
+    /**
+     * @brief Frames the encoded payload in Record and writes it to the journal.
+     */
+    void vidWriteRecord(void);
+
+    /**
+     * @brief Asks the sync thread to fsync everything written so far, without waiting for it.
+     */
+    void vidRequestSync(void);
+
+    /**
+     * @brief Body of the sync thread.
+     */
+    void vidRunSync(void);
+
+public:
+    /**
+     * @brief Default constructor for TaskJournal.
+     */
+    TaskJournal();
+
+    TaskJournal(const TaskJournal &) = delete;
+    TaskJournal &operator=(const TaskJournal &) = delete;
+
+    /**
+     * @brief Opens a journal file for appending, creating it if needed.
+     *
+     * @param path Name of the journal file.
+     * @return true if the journal is open, false otherwise.
+     */
+    bool bOpen(const std::string &path);
+
+    /**
+     * @brief Closes the journal.
+     *
+     * @param Sync true to fsync the journal before closing it; false leaves it
+     *        to the caller, which must then sync the file by name.
+     */
+    void vidClose(bool Sync = true);
+
+    /**
+     * @brief Tells whether the journal is open.
+     *
+     * @return true if records can be appended.
+     */
+    bool bIsOpen(void) const;
+
+    /**
+     * @brief Appends a record holding the full state of a task.
+     *
+     * @param task Task that was added or modified.
+     */
+    void vidAppendPut(const Task &task);
+
+    /**
+     * @brief Appends a record deleting a task.
+     *
+     * @param id ID of the deleted task.
+     */
+    void vidAppendDelete(int id);
+
+    /**
+     * @brief Appends one record setting the status of a batch of tasks.
+     *
+     * @param ids IDs of the updated tasks.
+     * @param state New status of the tasks.
+     */
+    void vidAppendStatus(const std::vector<int> &ids, TaskState state);
+
+    /**
+     * @brief Forces all appended records to disk.
+     */
+    void vidSync(void);
+
+    /**
+     * @brief Turns batching of appended records on or off.
+     *
+     * While batching, records collect in the file buffer and are neither flushed
+     * nor synced until vidSync() is called, which makes vidSync() a commit point
+     * for every record appended before it. Turning batching off syncs.
+     *
+     * @param Enabled true to start batching, false to stop.
+     */
+    void vidSetBatching(bool Enabled);
+
+    /**
+     * @brief Gets the number of records appended since the journal was opened.
+     *
+     * @return Record count.
+     */
+    std::size_t u64RecordCount(void) const;
+
+    /**
+     * @brief Replays the records of a journal file in order.
+     *
+     * Replay stops at the first incomplete or corrupt record, which is what a
+     * crash in the middle of an append leaves behind.
+     *
+     * @param path Name of the journal file.
+     * @param OnPut Called with the task held by each put record.
+     * @param OnDelete Called with the task ID held by each delete record.
+     * @param OnStatus Called with the task IDs and new status held by each status record.
+     * @param ValidLength Receives the length in bytes of the valid prefix of the journal.
+     * @return Number of records replayed.
+     */
+    static std::size_t u64Replay(const std::string &path, const std::function<void(const Task &)> &OnPut,
+                                 const std::function<void(int)> &OnDelete,
+                                 const std::function<void(const std::vector<int> &, TaskState)> &OnStatus,
+                                 std::size_t &ValidLength);
+
+    /**
+     * @brief Syncs and closes the journal, and stops the sync thread.
+     */
+    ~TaskJournal();
+};
+
+/**
+ * @brief Forces the content of a file that was written and closed to disk.
+ *
+ * @param path Name of the file.
+ * @return true on success, false if the file could not be synced.
+ */
+bool SyncFileToDisk(const std::string &path);
+
+#endif // __TASK__JOURNAL__
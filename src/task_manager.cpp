@@ -10,6 +10,38 @@
  */
 
 #include "task_manager.hpp"
+#include "task_file.hpp"
+#include "task_metrics.hpp"
+#include "task_paged.hpp"
+#include "task_snapshot.hpp"
+#include <charconv>
+
+/**
+ * @brief Maximum number of individual line numbers reported by vidReportLines().
+ */
+static constexpr std::size_t MAX_REPORTED_LINES = 10;
+
+/**
+ * @brief Reports problem lines of a loaded file to stderr.
+ *
+ * Only the first MAX_REPORTED_LINES lines are listed one by one; the rest are
+ * summarized in a single count.
+ *
+ * @param Lines Line numbers to report.
+ * @param Prefix Text printed before each line number.
+ * @param Suffix Text printed after each line number.
+ */
+static void vidReportLines(const std::vector<std::size_t> &Lines, const char *Prefix, const char *Suffix)
+{
+    for (std::size_t Index = 0; Index < Lines.size() && Index < MAX_REPORTED_LINES; ++Index)
+    {
+        std::cerr << Prefix << Lines[Index] << Suffix << std::endl;
+    }
+    if (Lines.size() > MAX_REPORTED_LINES)
+    {
+        std::cerr << "... And " << (Lines.size() - MAX_REPORTED_LINES) << " More Lines Like This" << std::endl;
+    }
+}
 
 /**
  * @brief Constructor for TaskManager.
@@ -18,7 +50,7 @@
  */
 TaskManager::TaskManager()
 {
-    nextId = 0;
+    nextId = 1;
 }
 
 /**
@@ -26,37 +58,299 @@ TaskManager::TaskManager()
  * 
  * @param title Title of the new task.
  * @param desc Description of the new task.
- * @param dueDate Due date of the new task.
- * @param priority Priority level of the new task.
+ * @param dueDate Due date of the new task ("YYYY-MM-DD", or empty for none).
+ * @param priority Priority level of the new task ("Low", "Medium", "High", or empty).
+ * @return ID of the new task, or 0 if the due date or priority is invalid.
+ */
+int TaskManager::addTask(const std::string &title, const std::string &desc, const std::string &dueDate, const std::string &priority)
+{
+    std::int32_t DueDay = TASK_NO_DUE_DATE;
+    TaskPriority Priority = TaskPriority::Unknown;
+    if (ParseDueDate(dueDate, DueDay) == false)
+    {
+        std::cout << "Invalid Due Date, Please Use The YYYY-MM-DD Format" << std::endl;
+        return 0;
+    }
+    if (ParseTaskPriority(priority, Priority) == false)
+    {
+        std::cout << "Invalid Priority, Please Use Low, Medium Or High" << std::endl;
+        return 0;
+    }
+    return addTask(std::string_view(title), std::string_view(desc), DueDay, Priority);
+}
+
+/**
+ * @brief Adds a new task whose due date and priority are already parsed.
+ *
+ * @param title Title of the new task.
+ * @param desc Description of the new task.
+ * @param DueDay Due date of the new task as a day number, or TASK_NO_DUE_DATE.
+ * @param Priority Priority level of the new task.
+ * @return ID of the new task.
  */
-void TaskManager::addTask(const std::string &title, const std::string &desc, const std::string &dueDate, const std::string &priority)
+int TaskManager::addTask(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority)
 {
-    nextId = (tasks.size() > 0) ? (tasks.back().int32GetTaskID()) : 0 ;
-    Task CreateNewTask(++nextId, title, desc, dueDate, priority);
-    tasks.push_back(CreateNewTask);
+    TASK_METRIC_TIMER(MetricOp::Add);
+    int id = nextId++;
+    tasks.emplace_back(id, title, desc, DueDay, Priority);
+    TaskIndex.vidSet(id, tasks.size() - 1);
+    FieldIndex.vidInsert(tasks.back());
+    Columns.vidAppend(tasks.back());
+    TextIndex.vidInsert(id, title, desc);
+    Journal.vidAppendPut(tasks.back());
+    vidMarkDirty(id);
+    vidCompactIfNeeded();
+    return id;
+}
+
+/**
+ * @brief Finds a task by its ID using the ID index.
+ *
+ * After a lazy load, a task missing from the index is looked for in the
+ * snapshot. One found there is read into tasks and detached from the
+ * snapshot, since the caller may change it.
+ *
+ * @param id ID of the task to look up.
+ * @return Pointer to the task, or nullptr if no task has this ID.
+ */
+Task *TaskManager::findTask(int id)
+{
+    const std::size_t *Slot = TaskIndex.Find(id);
+    if (Slot != nullptr)
+    {
+        return &tasks[*Slot];
+    }
+    if (Bodies.bIsOpen() == false)
+    {
+        return nullptr;
+    }
+    Bodies.vidDropResults();
+    const TaskStub *Stub = Bodies.FindStub(id);
+    if (Stub == nullptr)
+    {
+        return nullptr;
+    }
+    tasks.emplace_back();
+    if (Bodies.bLoad(*Stub, tasks.back()) == false)
+    {
+        vidReportBodyError(id);
+    }
+    Bodies.vidDetach(id);
+    TaskIndex.vidSet(id, tasks.size() - 1);
+    Columns.vidAppend(tasks.back());
+    return &tasks.back();
+}
+
+/**
+ * @brief Finds a task by its ID using the ID index.
+ *
+ * After a lazy load, a task missing from the index is read from the snapshot
+ * through the body cache, which never drops the task it just returned.
+ *
+ * @param id ID of the task to look up.
+ * @return Pointer to the task, or nullptr if no task has this ID.
+ */
+const Task *TaskManager::findTask(int id) const
+{
+    const std::size_t *Slot = TaskIndex.Find(id);
+    if (Slot != nullptr)
+    {
+        return &tasks[*Slot];
+    }
+    if (Bodies.bIsOpen() == false)
+    {
+        return nullptr;
+    }
+    Bodies.vidDropResults();
+    return ReadStub(id, false);
+}
+
+/**
+ * @brief Removes a task by ID without printing anything.
+ *
+ * The slot is resolved through the ID index and turned into a tombstone, so
+ * no other task moves and the removal costs constant time.
+ *
+ * @param id ID of the task to remove.
+ * @return true if the task existed and was removed, false otherwise.
+ */
+bool TaskManager::removeTask(int id)
+{
+    TASK_METRIC_TIMER(MetricOp::Delete);
+    const std::size_t *Found = TaskIndex.Find(id);
+    if (Found == nullptr && Bodies.bIsOpen() == true && findTask(id) != nullptr)
+    {
+        Found = TaskIndex.Find(id);    /*Detached From The Snapshot By findTask()*/
+    }
+    if (Found == nullptr)
+    {
+        return false;
+    }
+    std::size_t Slot = *Found;
+    TaskIndex.bErase(id);
+    FieldIndex.vidErase(tasks[Slot]);
+    Columns.vidRemove(Slot);
+    TextIndex.vidErase(id, tasks[Slot].int32GetTaskTitle(), tasks[Slot].int32GetTaskDescription());
+    tasks[Slot].vidMarkRemoved();
+    ++Tombstones;
+    Journal.vidAppendDelete(id);
+    vidMarkRemoved(id);
+    vidCompactTombstonesIfNeeded();
+    vidCompactIfNeeded();
+    return true;
+}
+
+/**
+ * @brief Gets the number of tasks currently stored.
+ *
+ * After a lazy load, the tasks still in the snapshot are counted from their stubs.
+ *
+ * @return Number of tasks.
+ */
+std::size_t TaskManager::size(void) const
+{
+    return tasks.size() - Tombstones + Bodies.u64GetLive();
+}
+
+/**
+ * @brief Re-indexes the slots of all tasks starting at the given slot.
+ *
+ * @param FirstSlot First slot in tasks whose index entry must be refreshed.
+ */
+void TaskManager::vidReindexFrom(std::size_t FirstSlot)
+{
+    TaskIndex.vidReserve(tasks.size());
+    for (std::size_t Slot = FirstSlot; Slot < tasks.size(); ++Slot)
+    {
+        TaskIndex.vidSet(tasks[Slot].int32GetTaskID(), Slot);
+    }
+}
+
+/**
+ * @brief Moves nextId past the IDs of newly loaded tasks and the ID recorded in their file.
+ *
+ * @param FirstSlot First slot in tasks holding a loaded task.
+ * @param SavedNextId Next ID recorded in the file, or 0 if none was recorded.
+ */
+void TaskManager::vidAdvanceNextId(std::size_t FirstSlot, int SavedNextId)
+{
+    nextId = std::max(nextId, SavedNextId);
+    for (std::size_t Slot = FirstSlot; Slot < tasks.size(); ++Slot)
+    {
+        nextId = std::max(nextId, tasks[Slot].int32GetTaskID() + 1);
+    }
+}
+
+/**
+ * @brief Tombstones are compacted once they make up more than 1/N of the task slots.
+ */
+static constexpr std::size_t TASK_TOMBSTONE_RATIO = 4;
+
+/**
+ * @brief Minimum number of tombstones before a compaction is worth running.
+ */
+static constexpr std::size_t TASK_TOMBSTONE_COMPACT_MIN = 1024;
+
+/**
+ * @brief Drops every tombstone from tasks and re-indexes the tasks that moved.
+ *
+ * The live tasks keep their order. Only the slots from the first tombstone on
+ * are touched, and moving a task within the list never copies its text.
+ * The column store is dropped, as its rows follow the slots, and rebuilt by
+ * the next scan.
+ */
+void TaskManager::vidCompactTombstones(void)
+{
+    if (Tombstones == 0)
+    {
+        return;
+    }
+    auto IsRemoved = [](const Task &task)
+    { return task.bIsRemoved(); };
+    auto FirstTombstone = std::find_if(tasks.begin(), tasks.end(), IsRemoved);
+    std::size_t FirstSlot = static_cast<std::size_t>(FirstTombstone - tasks.begin());
+    tasks.erase(std::remove_if(FirstTombstone, tasks.end(), IsRemoved), tasks.end());
+    Tombstones = 0;
+    Columns.vidClear();
+    vidReindexFrom(FirstSlot);
+}
+
+/**
+ * @brief Compacts the tombstones once they make up a large enough share of tasks.
+ *
+ * Waiting for a fixed share of the list keeps the amortized cost of each
+ * removal constant, however many tasks are deleted in a row.
+ */
+void TaskManager::vidCompactTombstonesIfNeeded(void)
+{
+    if (Tombstones >= TASK_TOMBSTONE_COMPACT_MIN && Tombstones * TASK_TOMBSTONE_RATIO > tasks.size())
+    {
+        vidCompactTombstones();
+    }
+}
+
+/**
+ * @brief Size after which the listing buffer is written to the output stream.
+ */
+static constexpr std::size_t TASK_LIST_FLUSH_SIZE = 1 << 16;
+
+/**
+ * @brief Writes the string representation of every task to a stream.
+ *
+ * The tasks are formatted into one reused buffer that is handed to the stream
+ * in large blocks, and the stream is flushed only once at the end. After a
+ * lazy load, the tasks still in the snapshot are built one at a time in the
+ * same storage, so a listing never holds more than one of them.
+ *
+ * @param Out Stream to write to.
+ * @param Numbered true to put a "Task N Data ==>" heading and a separator line around each task.
+ */
+void TaskManager::vidWriteTasks(std::ostream &Out, bool Numbered) const
+{
+    std::string Buffer;
+    Buffer.reserve(TASK_LIST_FLUSH_SIZE + 4096);
+    std::size_t TaskCounter = 0;
+    char CounterText[24];
+    vidForEachTask([&](const Task &ref)
+                   {
+        if (Numbered == true)
+        {
+            auto CounterEnd = std::to_chars(CounterText, CounterText + sizeof(CounterText), ++TaskCounter).ptr;
+            Buffer.append("Task ").append(CounterText, static_cast<std::size_t>(CounterEnd - CounterText));
+            Buffer.append(" Data ==>\n");
+        }
+        ref.vidAppendTo(Buffer);
+        Buffer.push_back('\n');
+        if (Numbered == true)
+        {
+            Buffer.append("------------------------------------------------------\n");
+        }
+        if (Buffer.size() >= TASK_LIST_FLUSH_SIZE)
+        {
+            Out.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        } });
+    Out.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    Out.flush();
 }
 
 /**
  * @brief Lists all existing tasks in the system.
  * 
  * Displays each task's information using its string representation.
+ *
+ * @param Out Stream to write the listing to.
  */
-void TaskManager::listTasks(void) const
+void TaskManager::listTasks(std::ostream &Out) const
 {
-    int TaskCounter = 0;
-    if (tasks.size() > 0)
+    if (size() > 0)
     {
-        std::cout << "\n------------------- List Of Tasks -------------------" << std::endl;
-        for (auto &ref : tasks)
-        {
-            std::cout << "Task " << ++TaskCounter << " Data ==>" << std::endl;
-            std::cout << ref.toString() << std::endl;
-            std::cout<<"------------------------------------------------------"<<std::endl;
-        }
+        Out << "\n------------------- List Of Tasks -------------------\n";
+        vidWriteTasks(Out, true);
     }
     else
     {
-        std::cout << "\nNo Tasks Found !!" << std::endl;
+        Out << "\nNo Tasks Found !!" << std::endl;
     }
 }
 
@@ -69,75 +363,83 @@ void TaskManager::listTasks(void) const
  */
 void TaskManager::updateTask(int id)
 {
-    bool TaskIdExistance = false;
     std::string Update = "1- Title\n2- Description\n3- Due Date\n4- Priority\n5- Exit";
-    for (auto &it : tasks)
+    Task *it = findTask(id);
+    if (it != nullptr)
     {
-        if (it.int32GetTaskID() == id)
+        std::cout << "PLease Select The Item You Want To Upgrade " << std::endl;
+        std::cout << Update << std::endl;
+        int Option;
+        while (true)
         {
-            TaskIdExistance = true;
-            std::cout << "PLease Select The Item You Want To Upgrade " << std::endl;
-            std::cout << Update << std::endl;
-            int Option;
-            while (true)
+            std::cin >> Option;
+            if (ValidateUserInput() == true)
             {
-                std::cin >> Option;
-                if (ValidateUserInput() == true)
+                if (Option == 5)
                 {
-                    if (Option == 5)
-                    {
-                        std::cout << "You Choosed To Leave " << std::endl;
-                        break;
-                    }
-                    switch (Option)
-                    {
-                    case 1:
-                    {
-                        std::string title;
-                        std::cout << "Enter The New Title" << std::endl;
-                        std::cin >> title;
-                        it.vidSetTitle(title);
-                        std::cout << "Title Is Upgraded Successfully" << std::endl;
-                        break;
-                    }
-                    case 2:
-                    {
-                        std::string Description;
-                        std::cout << "Enter The New Description" << std::endl;
-                        std::cin >> Description;
-                        it.vidSetDescription(Description);
-                        std::cout << "Description Is Upgraded Successfully" << std::endl;
-                        break;
-                    }
-                    case 3:
+                    std::cout << "You Choosed To Leave " << std::endl;
+                    break;
+                }
+                switch (Option)
+                {
+                case 1:
+                {
+                    std::string title;
+                    std::cout << "Enter The New Title" << std::endl;
+                    std::cin >> title;
+                    setTitle(id, title);
+                    std::cout << "Title Is Upgraded Successfully" << std::endl;
+                    break;
+                }
+                case 2:
+                {
+                    std::string Description;
+                    std::cout << "Enter The New Description" << std::endl;
+                    std::cin >> Description;
+                    setDescription(id, Description);
+                    std::cout << "Description Is Upgraded Successfully" << std::endl;
+                    break;
+                }
+                case 3:
+                {
+                    std::string DueDate;
+                    std::int32_t DueDay = TASK_NO_DUE_DATE;
+                    std::cout << "Enter The New DueDate (YYYY-MM-DD)" << std::endl;
+                    std::cin >> DueDate;
+                    if (ParseDueDate(DueDate, DueDay) == false)
                     {
-                        std::string DueDate;
-                        std::cout << "Enter The New DueDate" << std::endl;
-                        std::cin >> DueDate;
-                        it.vidSetDueDate(DueDate);
-                        std::cout << "Due Date Is Upgraded Successfully" << std::endl;
+                        std::cout << "Invalid Due Date, Please Use The YYYY-MM-DD Format" << std::endl;
                         break;
                     }
-                    case 4:
+                    setDueDate(id, DueDay);
+                    std::cout << "Due Date Is Upgraded Successfully" << std::endl;
+                    break;
+                }
+                case 4:
+                {
+                    std::string Priority;
+                    TaskPriority NewPriority = TaskPriority::Unknown;
+                    std::cout << "Enter The New Priority (Low, Medium Or High)" << std::endl;
+                    std::cin >> Priority;
+                    if (ParseTaskPriority(Priority, NewPriority) == false)
                     {
-                        std::string Priority;
-                        std::cout << "Enter The New Priority" << std::endl;
-                        std::cin >> Priority;
-                        it.vidSetPriority(Priority);
-                        std::cout << "Priority Is Upgraded Successfully" << std::endl;
-                        break;
-                    }
-                    default:
-                        std::cout << "Undefined Choice !!!" << std::endl;
+                        std::cout << "Invalid Priority, Please Use Low, Medium Or High" << std::endl;
                         break;
                     }
+                    setPriority(id, NewPriority);
+                    std::cout << "Priority Is Upgraded Successfully" << std::endl;
+                    break;
+                }
+                default:
+                    std::cout << "Undefined Choice !!!" << std::endl;
+                    break;
                 }
-                std::cout << "PLease Select The Item You Want To Upgrade " << std::endl;
-                std::cout << Update << std::endl;
             }
+            std::cout << "PLease Select The Item You Want To Upgrade " << std::endl;
+            std::cout << Update << std::endl;
         }
     }
-    if (TaskIdExistance == false)
+    else
     {
         std::cout << "Task Id Is Not Exist" << std::endl;
     }
@@ -150,22 +452,13 @@ void TaskManager::updateTask(int id)
  */
 void TaskManager::deleteTask(int id)
 {
-    auto it = std::find_if(tasks.begin(), tasks.end(), [id](auto &it)
-                           { return it.int32GetTaskID() == id; });
-    if (it == tasks.end())
+    if (removeTask(id) == false)
     {
         std::cout << "NO Task With ID = " << id << " Exists" << std::endl;
     }
     else
     {
-        tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [id](auto &it)
-                                   { return it.int32GetTaskID() == id; }),
-                    tasks.end());
-
-        for (auto &it : tasks)
-        {
-            std::cout << it.toString() << std::endl;
-        }
+        vidWriteTasks(std::cout, false);
 
         std::cout << "Task With ID = " << id << " Has Been Deleted Successfully" << std::endl;
     }
@@ -180,10 +473,9 @@ void TaskManager::deleteTask(int id)
  */
 void TaskManager::ChangeTaskStatus(int id)
 {
-    int TaskID = id - 1;
-    if (TaskID < 0)
+    if (findTask(id) == nullptr)
     {
-        std::cout << "NO Task With ID = Exists" << id << std::endl;
+        std::cout << "NO Task With ID = " << id << " Exists" << std::endl;
     }
     else
     {
@@ -196,12 +488,12 @@ void TaskManager::ChangeTaskStatus(int id)
         {
             if (TaskStatus == 1)
             {
-                tasks[TaskID].markDone();
+                setStatus(id, TaskState::Done);
                 std::cout << "Task Status For Task ID = " << id << " Marked As Done Successfully" << std::endl;
             }
             else if (TaskStatus == 2)
             {
-                tasks[TaskID].markPending();
+                setStatus(id, TaskState::Pending);
                 std::cout << "Task Status For Task ID = " << id << " Marked As Pending Successfully" << std::endl;
             }
             else
@@ -212,16 +504,386 @@ void TaskManager::ChangeTaskStatus(int id)
     }
 }
 
+/**
+ * @brief Sets the status of a task without prompting.
+ *
+ * The task is resolved through the ID index, so this works for any ID
+ * regardless of deletions or gaps in the ID sequence.
+ *
+ * @param id ID of the task whose status to set.
+ * @param state New status of the task.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool TaskManager::setStatus(int id, TaskState state)
+{
+    TASK_METRIC_TIMER(MetricOp::Status);
+    Task *it = findTask(id);
+    if (it == nullptr)
+    {
+        return false;
+    }
+    FieldIndex.vidErase(*it);
+    if (state == TaskState::Done)
+    {
+        it->markDone();
+    }
+    else
+    {
+        it->markPending();
+    }
+    FieldIndex.vidInsert(*it);
+    Columns.vidSetFields(static_cast<std::size_t>(it - tasks.data()), *it);
+    Journal.vidAppendPut(*it);
+    vidMarkDirty(id);
+    vidCompactIfNeeded();
+    return true;
+}
+
+/**
+ * @brief Sets the status of many tasks in one pass without prompting.
+ *
+ * Unknown IDs are skipped. The secondary index is updated in one batch and
+ * the change is journaled as a single status record.
+ *
+ * @param ids IDs of the tasks whose status to set.
+ * @param state New status of the tasks.
+ * @return Number of tasks that were updated.
+ */
+std::size_t TaskManager::setStatus(const std::vector<int> &ids, TaskState state)
+{
+    TASK_METRIC_TIMER(MetricOp::Status);
+    std::vector<std::size_t> Slots;
+    std::vector<int> Found;
+    Slots.reserve(ids.size());
+    Found.reserve(ids.size());
+    for (int id : ids)
+    {
+        Task *it = findTask(id);
+        if (it != nullptr)
+        {
+            Slots.push_back(static_cast<std::size_t>(it - tasks.data()));
+            Found.push_back(id);
+        }
+    }
+    if (Found.empty() == true)
+    {
+        return 0;
+    }
+
+    /*Slots Stay Valid While findTask Detaches Lazy Tasks, Pointers Do Not*/
+    std::vector<const Task *> Changed;
+    Changed.reserve(Slots.size());
+    for (std::size_t Slot : Slots)
+    {
+        Changed.push_back(&tasks[Slot]);
+    }
+    FieldIndex.vidMoveToState(Changed, state);
+    for (std::size_t Slot : Slots)
+    {
+        if (state == TaskState::Done)
+        {
+            tasks[Slot].markDone();
+        }
+        else
+        {
+            tasks[Slot].markPending();
+        }
+        Columns.vidSetFields(Slot, tasks[Slot]);
+    }
+    Journal.vidAppendStatus(Found, state);
+    for (int id : Found)
+    {
+        vidMarkDirty(id);
+    }
+    vidCompactIfNeeded();
+    return Found.size();
+}
+
+/**
+ * @brief Sets the title of a task without prompting.
+ *
+ * @param id ID of the task to update.
+ * @param title New title.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool TaskManager::setTitle(int id, std::string_view title)
+{
+    TASK_METRIC_TIMER(MetricOp::Update);
+    Task *it = findTask(id);
+    if (it == nullptr)
+    {
+        return false;
+    }
+    TextIndex.vidErase(id, it->int32GetTaskTitle(), it->int32GetTaskDescription());
+    it->vidSetTitle(title);
+    TextIndex.vidInsert(id, it->int32GetTaskTitle(), it->int32GetTaskDescription());
+    Columns.vidSetText(static_cast<std::size_t>(it - tasks.data()), it->int32GetTaskTitle(), it->int32GetTaskDescription());
+    Journal.vidAppendPut(*it);
+    vidMarkDirty(id);
+    vidCompactIfNeeded();
+    return true;
+}
+
+/**
+ * @brief Sets the description of a task without prompting.
+ *
+ * @param id ID of the task to update.
+ * @param desc New description.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool TaskManager::setDescription(int id, std::string_view desc)
+{
+    TASK_METRIC_TIMER(MetricOp::Update);
+    Task *it = findTask(id);
+    if (it == nullptr)
+    {
+        return false;
+    }
+    TextIndex.vidErase(id, it->int32GetTaskTitle(), it->int32GetTaskDescription());
+    it->vidSetDescription(desc);
+    TextIndex.vidInsert(id, it->int32GetTaskTitle(), it->int32GetTaskDescription());
+    Columns.vidSetText(static_cast<std::size_t>(it - tasks.data()), it->int32GetTaskTitle(), it->int32GetTaskDescription());
+    Journal.vidAppendPut(*it);
+    vidMarkDirty(id);
+    vidCompactIfNeeded();
+    return true;
+}
+
+/**
+ * @brief Sets the due date of a task without prompting.
+ *
+ * @param id ID of the task to update.
+ * @param DueDay New due date as a day number, or TASK_NO_DUE_DATE.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool TaskManager::setDueDate(int id, std::int32_t DueDay)
+{
+    TASK_METRIC_TIMER(MetricOp::Update);
+    Task *it = findTask(id);
+    if (it == nullptr)
+    {
+        return false;
+    }
+    FieldIndex.vidErase(*it);
+    it->vidSetDueDate(DueDay);
+    FieldIndex.vidInsert(*it);
+    Columns.vidSetFields(static_cast<std::size_t>(it - tasks.data()), *it);
+    Journal.vidAppendPut(*it);
+    vidMarkDirty(id);
+    vidCompactIfNeeded();
+    return true;
+}
+
+/**
+ * @brief Sets the priority of a task without prompting.
+ *
+ * @param id ID of the task to update.
+ * @param Priority New priority.
+ * @return true if the task exists and was updated, false otherwise.
+ */
+bool TaskManager::setPriority(int id, TaskPriority Priority)
+{
+    TASK_METRIC_TIMER(MetricOp::Update);
+    Task *it = findTask(id);
+    if (it == nullptr)
+    {
+        return false;
+    }
+    FieldIndex.vidErase(*it);
+    it->vidSetPriority(Priority);
+    FieldIndex.vidInsert(*it);
+    Columns.vidSetFields(static_cast<std::size_t>(it - tasks.data()), *it);
+    Journal.vidAppendPut(*it);
+    vidMarkDirty(id);
+    vidCompactIfNeeded();
+    return true;
+}
+
+/**
+ * @brief Builds the secondary index if no query built it yet.
+ *
+ * After a lazy load, it is built from the stubs, without reading any text.
+ */
+void TaskManager::vidBuildFieldIndex(void) const
+{
+    if (FieldIndex.bIsBuilt() == true)
+    {
+        return;
+    }
+    if (Bodies.bIsOpen() == true)
+    {
+        FieldIndex.vidBuild(TaskList());
+        vidForEachTask([this](const Task &task)
+                       { FieldIndex.vidInsert(task); }, false);
+    }
+    else
+    {
+        FieldIndex.vidBuild(tasks);
+    }
+}
+
+/**
+ * @brief A filter without a due date range is answered by a column scan once it matches at least 1/N of the tasks.
+ *
+ * Below that share, walking the matching entries of the secondary index is
+ * cheaper than reading every row; above it, the sequential scan wins.
+ */
+static constexpr std::size_t TASK_QUERY_SCAN_SHARE = 8;
+
+/**
+ * @brief Collects the tasks matching a filter.
+ *
+ * A filter on status and priority alone knows its result size from the
+ * column store's per-pair counts. When it matches a large share of the
+ * tasks, as listing every task does, the status, priority and due date
+ * columns are scanned and the matches sorted, without touching the tasks
+ * themselves. Narrower filters and due date ranges go through the secondary
+ * index, which is built on the first such query and kept up to date by every
+ * mutation after that, so each of them costs time proportional to its result.
+ *
+ * After a lazy load, only the index is used, as the column store would need
+ * the text of every task.
+ *
+ * @param Filter Conditions to match.
+ * @return Pointers to the matching tasks ordered by due date and then ID, valid until the next mutation.
+ */
+std::vector<const Task *> TaskManager::Query(const TaskFilter &Filter) const
+{
+    bool FiltersDueDate = (Filter.DueFrom != std::numeric_limits<std::int32_t>::min() ||
+                           Filter.DueTo != std::numeric_limits<std::int32_t>::max());
+    if (Bodies.bIsOpen() == false && FiltersDueDate == false)
+    {
+        if (Columns.bIsBuilt() == false)
+        {
+            Columns.vidBuild(tasks);
+        }
+        if (Columns.u64Estimate(Filter) * TASK_QUERY_SCAN_SHARE >= Columns.u64GetLive())
+        {
+            std::vector<std::size_t> Rows = Columns.SelectOrdered(Filter);
+            std::vector<const Task *> Matches;
+            Matches.reserve(Rows.size());
+            for (std::size_t Row : Rows)
+            {
+                Matches.push_back(&tasks[Row]);
+            }
+            return Matches;
+        }
+    }
+    vidBuildFieldIndex();
+    std::vector<int> Ids = FieldIndex.Select(Filter);
+    std::vector<const Task *> Matches;
+    Matches.reserve(Ids.size());
+    Bodies.vidDropResults();
+    for (int id : Ids)
+    {
+        Matches.push_back(FindMatch(id));
+    }
+    return Matches;
+}
+
+/**
+ * @brief Counts the tasks matching a filter without collecting them.
+ *
+ * The column store is built on the first count and kept up to date by every
+ * mutation after that. After a lazy load, the matches are counted through
+ * the secondary index instead.
+ *
+ * @param Filter Conditions to match.
+ * @return Number of matching tasks.
+ */
+std::size_t TaskManager::Count(const TaskFilter &Filter) const
+{
+    if (Bodies.bIsOpen() == true)
+    {
+        vidBuildFieldIndex();
+        return FieldIndex.Select(Filter).size();
+    }
+    if (Columns.bIsBuilt() == false)
+    {
+        Columns.vidBuild(tasks);
+    }
+    return Columns.u64Count(Filter);
+}
+
+/**
+ * @brief Finds the tasks whose title or description match a keyword query.
+ *
+ * The inverted index is loaded with the journal or built on the first search,
+ * and kept up to date by every mutation after that. After a lazy load, it is
+ * built from the text in the snapshot, one task at a time.
+ *
+ * @param Query Terms to match; see TaskTextIndex for the syntax.
+ * @return Pointers to the matching tasks in ID order, valid until the next mutation.
+ */
+std::vector<const Task *> TaskManager::Search(std::string_view Query) const
+{
+    if (TextIndex.bIsBuilt() == false && Bodies.bIsOpen() == true)
+    {
+        TextIndex.vidBuild(TaskList());
+        vidForEachTask([this](const Task &task)
+                       { TextIndex.vidInsert(task.int32GetTaskID(), task.int32GetTaskTitle(), task.int32GetTaskDescription()); });
+    }
+    else if (TextIndex.bIsBuilt() == false)
+    {
+        TextIndex.vidBuild(tasks);
+    }
+    std::vector<int> Ids = TextIndex.Search(Query);
+    std::vector<const Task *> Matches;
+    Matches.reserve(Ids.size());
+    Bodies.vidDropResults();
+    for (int id : Ids)
+    {
+        Matches.push_back(FindMatch(id));
+    }
+    return Matches;
+}
+
+/**
+ * @brief Gets the files whose state the saved text index of a task file reflects.
+ *
+ * @param filename Name of the task file.
+ * @return The task file and its live and old journals.
+ */
+static std::vector<std::string> TextIndexSources(const std::string &filename)
+{
+    return {filename, filename + ".journal", filename + ".journal.old"};
+}
+
 /**
  * @brief Saves all tasks to a file.
  * 
  * If the file does not exist, it will be created.
- * Content is overwritten using truncation mode.
+ * The tasks are written to a temporary file that then replaces the original,
+ * so a crash in the middle of a save never leaves a half-written file.
+ * Saving to the file last loaded or saved writes nothing if no task changed
+ * since, and only patches the pages of changed tasks if the file is paged;
+ * a patch that fails falls back to writing the whole file.
+ * After a lazy load, the tasks still in the snapshot are copied out of it for
+ * the time of the write; the snapshot stays mapped even if it is replaced.
+ * A background journal compaction is waited for first, so the two never
+ * write the same file, its temporary file or its page layout at once.
+ * Nothing is written to a binary, paged or snapshot file while a task holds a
+ * due date or priority kept as unrecognized text, which only text files keep.
  * 
  * @param filename Name of the file to save tasks.
  */
 void TaskManager::SaveTasksToFile(const std::string &filename) const
 {
+    TASK_METRIC_TIMER(MetricOp::Save);
+    vidWaitForCompaction();
+    bool Current = (filename == SnapshotFile);
+    std::error_code Error;
+    if (Current == true && Changes == 0 && std::filesystem::exists(filename, Error) == true)
+    {
+        std::cout << "No Changes Since The Last Save, Nothing To Write" << std::endl;
+        return;
+    }
+    int Unencodable = 0;
+    if (bFindUnencodableTask(tasks, filename, Unencodable) == true)
+    {
+        std::cerr << "Task " << Unencodable << " Has A Due Date Or Priority Only A Text File Can Keep, Fix It Or Save As Text" << std::endl;
+        return;
+    }
     bool FileStatus = true;
     if (std::filesystem::exists(filename) != true)
     {
@@ -240,21 +902,27 @@ void TaskManager::SaveTasksToFile(const std::string &filename) const
 
     if (FileStatus == true)
     {
-        std::fstream FileHandler(filename, std::ios::in | std::ios::out | std::ios::trunc);
-        if (!FileHandler)
+        if (Current == true && TrackPages == true && PageFile.bIsValid() == true && PageFile.GetPath() == filename)
+        {
+            std::vector<int> Removed(RemovedIds.begin(), RemovedIds.end());
+            if (PageFile.bPatch(CollectChangedTasks(), Removed, nextId) == true)
+            {
+                std::cout << "Changed Tasks Saved Successfully, " << PageFile.u64GetPagesWritten() << " Pages Rewritten" << std::endl;
+                vidResetChanges(filename, true);
+                return;
+            }
+        }
+        bool Paged = IsPagedTaskFile(filename);
+        bool Written = (Bodies.bIsOpen() == true) ? WriteTaskFile(CollectAllTasks(), filename, nextId, Paged ? &PageFile : nullptr)
+                                                  : WriteTaskFile(tasks, filename, nextId, Paged ? &PageFile : nullptr);
+        if (Written == false)
         {
-            std::cerr << "Error While Opening The File" << std::endl;
+            std::cerr << "Error While Writing The File" << std::endl;
         }
         else
         {
-            for (auto &it : tasks)
-            {
-                std::string TaskDetails;
-                TaskDetails = "ID: " + std::to_string(it.int32GetTaskID()) + '|' + "Title: " + it.int32GetTaskTitle() + '|' + "Description: " + it.int32GetTaskDescription() + '|' + "Due Date: " + it.int32GetTaskdueDate() + '|' + "Priority: " + it.int32GetTaskpriority() + '|' + "Status: " + it.GetTaskStatus() + "\n";
-                FileHandler << TaskDetails;
-            }
             std::cout << "Tasks Contenet Saved Successfully" << std::endl;
-            FileHandler.close();
+            vidResetChanges(filename, Paged);
         }
     }
 }
@@ -263,12 +931,48 @@ void TaskManager::SaveTasksToFile(const std::string &filename) const
  * @brief Loads tasks from a file and reconstructs them into memory.
  * 
  * If the file does not exist, it will be created.
+ * Text files are memory-mapped and parsed in place, split into chunks that are
+ * parsed in parallel. The other chunks are parsed into fields that still point
+ * into the mapping and copied into the task list, whose pool is not
+ * thread-safe, once every thread is done, so the text is copied exactly once.
+ * Snapshot files are decompressed block by block, also in parallel; with lazy
+ * loading on (see SetLazyLoading()), only their metadata is decoded into one
+ * stub per task, and each task is built from the snapshot when it is needed.
+ * A snapshot whose IDs are out of order cannot be read lazily and is loaded
+ * in full instead. Loading into a manager that still has a snapshot open
+ * first copies the tasks left in it into memory.
+ * Malformed lines are skipped and reported with their line numbers instead of
+ * aborting the load.
+ * When the manager was empty, the file then holds exactly its tasks, so
+ * changes are tracked from there on for SaveTasksToFile(); a paged file also
+ * keeps its layout so it can be patched.
  * 
  * @param filename Name of the file to load tasks from.
+ * @return true if the file was read or created, false if it could not be created or is unreadable, truncated or corrupt.
  */
-void TaskManager::LoadTasksFrom(const std::string &filename)
+bool TaskManager::LoadTasksFrom(const std::string &filename)
 {
+    TASK_METRIC_TIMER(MetricOp::Load);
+    vidWaitForCompaction();
+    if (Bodies.bIsOpen() == true)
+    {
+        TaskList Merged = CollectAllTasks();
+        Bodies.vidClose();
+        tasks.clear();
+        TaskIndex.vidClear();
+        Columns.vidClear();
+        Tombstones = 0;
+        tasks.insert(tasks.end(), Merged.begin(), Merged.end());
+        vidReindexFrom(0);
+    }
+    bool Fresh = (tasks.empty() == true && nextId == 1);
+    bool Loaded = false;
+    bool Paged = false;
     bool FileStatus = true;
+    if (LazyBodies > 0 && Fresh == true && IsSnapshotTaskFile(filename) == false)
+    {
+        std::cout << "Only Snapshot (.tsnap) Files Can Be Loaded Lazily, Loading Every Task" << std::endl;
+    }
     if (!std::filesystem::exists(filename))
     {
         std::cout << "File isn't exist so we will create it " << std::endl;
@@ -282,45 +986,606 @@ void TaskManager::LoadTasksFrom(const std::string &filename)
         {
             std::cout << "File Has Been Created Successfully" << std::endl;
             CreateFile.close();
+            Loaded = true;
         }
     }
     else
     {
-        std::cout << "Opening File In Progress ... " << std::endl;
-        std::fstream Content(filename, std::ios::in | std::ios::out);
-        if (!Content)
+        TaskFileFormat Format = GetTaskFileFormat(filename);
+        const char *Kind = (Format == TaskFileFormat::Paged)      ? "Paged "
+                           : (Format == TaskFileFormat::Snapshot) ? "Snapshot "
+                           : (Format == TaskFileFormat::Binary)   ? "Binary "
+                                                                  : "";
+        std::cout << "Loading Tasks From The Provided " << Kind << "File In Progress ... " << std::endl;
+        std::size_t FirstNew = tasks.size();
+        std::vector<std::size_t> MalformedLines;
+        std::vector<std::size_t> NormalizedLines;
+        int SavedNextId = 0;
+        TaskPageFile Throwaway;
+        TaskPageFile &Layout = (Fresh == true) ? PageFile : Throwaway;
+        bool Lazy = (Format == TaskFileFormat::Snapshot && LazyBodies > 0 && Fresh == true &&
+                     Bodies.bOpen(filename, SavedNextId) == true);
+        BodyErrors = 0;
+        if (Lazy == false && ReadTaskFile(filename, tasks, SavedNextId, &Layout, MalformedLines, NormalizedLines) == false)
         {
-            std::cerr << "Error While Opening The File" << std::endl;
+            std::cerr << "Error While Reading The " << Kind << "File, It Is Unreadable, Truncated Or Corrupted" << std::endl;
+            FileStatus = false;
         }
         else
         {
-            std::cout << "Loading Tasks From The Provided File In Progress ... " << std::endl;
-            std::string Data;
-            while (std::getline(Content, Data))
+            vidReindexFrom(FirstNew);
+            vidAdvanceNextId(FirstNew, SavedNextId);
+            FieldIndex.vidClear();
+            Columns.vidClear();
+            TextIndex.vidClear();
+            vidReportLines(MalformedLines, "Malformed Task At Line ", " Was Skipped");
+            vidReportLines(NormalizedLines, "Unrecognized Due Date Or Priority At Line ", " Was Kept As Written");
+            Loaded = (MalformedLines.empty() == true);    /*Kept Text Is Written Back As Read*/
+            Paged = (Format == TaskFileFormat::Paged && Layout.bIsValid() == true);
+            std::cout << "Tasks Loaded Successfully" << std::endl;
+        }
+    }
+
+    if (Fresh == true && Loaded == true)
+    {
+        vidResetChanges(filename, Paged);
+    }
+    else
+    {
+        vidResetChanges(std::string(), false);
+        ++Changes;
+    }
+    return FileStatus;
+}
+
+/**
+ * @brief Selects whether the next load of a snapshot file leaves the task text on disk.
+ *
+ * @param CachedBodies Number of task bodies to keep in memory, or 0 to load every task in full.
+ */
+void TaskManager::SetLazyLoading(std::size_t CachedBodies)
+{
+    LazyBodies = CachedBodies;
+    if (CachedBodies > 0)
+    {
+        Bodies.vidSetCapacity(CachedBodies);
+    }
+}
+
+/**
+ * @brief Inserts a task or replaces the task with the same ID.
+ *
+ * @param task Full state of the task.
+ */
+void TaskManager::vidApplyPut(const Task &task)
+{
+    Task *it = findTask(task.int32GetTaskID());
+    if (it != nullptr)
+    {
+        FieldIndex.vidErase(*it);
+        TextIndex.vidErase(it->int32GetTaskID(), it->int32GetTaskTitle(), it->int32GetTaskDescription());
+        *it = task;
+        Columns.vidSetFields(static_cast<std::size_t>(it - tasks.data()), task);
+        Columns.vidSetText(static_cast<std::size_t>(it - tasks.data()), task.int32GetTaskTitle(), task.int32GetTaskDescription());
+    }
+    else
+    {
+        tasks.push_back(task);
+        TaskIndex.vidSet(task.int32GetTaskID(), tasks.size() - 1);
+        Columns.vidAppend(tasks.back());
+        nextId = std::max(nextId, task.int32GetTaskID() + 1);
+    }
+    FieldIndex.vidInsert(task);
+    TextIndex.vidInsert(task.int32GetTaskID(), task.int32GetTaskTitle(), task.int32GetTaskDescription());
+    vidMarkDirty(task.int32GetTaskID());
+}
+
+/**
+ * @brief Notes that a task was added or changed since the last snapshot.
+ *
+ * Individual IDs are only kept while the snapshot is a paged file that can
+ * be patched; new tasks need no entry, as their IDs are all at or above
+ * SnapshotNextId.
+ *
+ * @param id ID of the task.
+ */
+void TaskManager::vidMarkDirty(int id)
+{
+    ++Changes;
+    if (TrackPages == true && id < SnapshotNextId)
+    {
+        DirtyIds.insert(id);
+    }
+}
+
+/**
+ * @brief Notes that a task was removed since the last snapshot.
+ *
+ * @param id ID of the task.
+ */
+void TaskManager::vidMarkRemoved(int id)
+{
+    ++Changes;
+    if (TrackPages == true && id < SnapshotNextId)
+    {
+        DirtyIds.erase(id);
+        RemovedIds.insert(id);
+    }
+}
+
+/**
+ * @brief Records that a file now holds every task, and starts tracking changes from there.
+ *
+ * @param filename File holding the tasks, or an empty string if none does.
+ * @param Paged true if PageFile describes the file, so changes are tracked per task.
+ */
+void TaskManager::vidResetChanges(const std::string &filename, bool Paged) const
+{
+    SnapshotFile = filename;
+    SnapshotNextId = nextId;
+    Changes = 0;
+    TrackPages = Paged;
+    DirtyIds.clear();
+    RemovedIds.clear();
+}
+
+/**
+ * @brief Collects the tasks added or changed since the last snapshot.
+ *
+ * Tasks added since then are exactly the ones with an ID at or above
+ * SnapshotNextId, as IDs are handed out in sequence.
+ *
+ * @return Copies of the tasks, in no particular order.
+ */
+TaskList TaskManager::CollectChangedTasks(void) const
+{
+    TaskList Changed;
+    for (int id : DirtyIds)
+    {
+        const Task *task = findTask(id);
+        if (task != nullptr)
+        {
+            Changed.push_back(*task);
+        }
+    }
+    for (int id = SnapshotNextId; id < nextId; ++id)
+    {
+        const Task *task = findTask(id);
+        if (task != nullptr)
+        {
+            Changed.push_back(*task);
+        }
+    }
+    return Changed;
+}
+
+/**
+ * @brief Replays the journal of a task file on top of the loaded tasks.
+ *
+ * A journal left behind by an interrupted compaction ("<filename>.journal.old")
+ * is replayed first, then the live journal ("<filename>.journal"). A torn
+ * record at the end of the live journal is cut off so new records can follow it.
+ * Nothing is replayed while the journal is open for writing.
+ *
+ * @param filename Name of the task file whose journal to replay.
+ * @return Number of journal records replayed.
+ */
+std::size_t TaskManager::ReplayJournal(const std::string &filename)
+{
+    if (Journal.bIsOpen() == true)
+    {
+        return 0;
+    }
+    std::string JournalFile = filename + ".journal";
+    std::string Journals[] = {JournalFile + ".old", JournalFile};
+    std::size_t Replayed = 0;
+    for (auto &Path : Journals)
+    {
+        std::error_code Error;
+        if (std::filesystem::exists(Path, Error) == false)
+        {
+            continue;
+        }
+        std::size_t ValidLength = 0;
+        Replayed += TaskJournal::u64Replay(
+            Path, [this](const Task &task)
+            { vidApplyPut(task); },
+            [this](int id)
+            { removeTask(id); },
+            [this](const std::vector<int> &ids, TaskState state)
+            { setStatus(ids, state); },
+            ValidLength);
+        if (ValidLength < std::filesystem::file_size(Path, Error))
+        {
+            std::cerr << "Journal " << Path << " Ends With An Incomplete Record, It Was Cut Off" << std::endl;
+            std::filesystem::resize_file(Path, ValidLength, Error);
+        }
+    }
+    return Replayed;
+}
+
+/**
+ * @brief Replays and then opens the journal of a task file for writing.
+ *
+ * If an interrupted compaction left an old journal behind, a synchronous
+ * compaction runs right away so that journal is folded into the snapshot.
+ * The saved text index ("<filename>.idx") is loaded if none of the task file
+ * and its journals changed since it was saved.
+ *
+ * @param filename Name of the task file the journal applies to.
+ * @return true if the journal is open, false otherwise.
+ */
+bool TaskManager::OpenJournal(const std::string &filename)
+{
+    CloseJournal();
+    std::uint64_t Stamp = u64FilesStamp(TextIndexSources(filename));
+    std::size_t Replayed = ReplayJournal(filename);
+    if (Replayed > 0)
+    {
+        std::cout << Replayed << " Journal Records Replayed" << std::endl;
+    }
+    TextIndex.bLoad(filename + ".idx", Stamp);
+
+    JournalTarget = filename;
+    if (Journal.bOpen(filename + ".journal") == false)
+    {
+        std::cerr << "Error While Opening The Journal File" << std::endl;
+        return false;
+    }
+    std::error_code Error;
+    if (std::filesystem::exists(filename + ".journal.old", Error) == true)
+    {
+        CompactJournal(false);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the current tasks as the new snapshot and empties the journal.
+ *
+ * In the background mode the live journal is renamed to "<filename>.journal.old"
+ * and a fresh journal is started, so new mutations never wait for the snapshot.
+ * The background thread syncs the old journal, writes a copy of the tasks as
+ * the new snapshot and only then removes the old journal; the only work left
+ * on the calling thread is the copy, which never touches the disk. A crash at any point therefore leaves a snapshot
+ * plus journals that replay to the latest state. If an old journal is still
+ * present, the compaction runs synchronously instead so it is never overwritten.
+ * When the snapshot is a paged file whose layout is known, only the tasks
+ * changed since the last snapshot are copied, and only their pages rewritten.
+ * After a lazy load, the tasks still in the snapshot are copied out of it for
+ * the copy or the write only.
+ *
+ * @param Background If true, the snapshot is written on a background thread.
+ */
+void TaskManager::CompactJournal(bool Background)
+{
+    if (Journal.bIsOpen() == false)
+    {
+        return;
+    }
+    vidWaitForCompaction();
+
+    std::string JournalFile = JournalTarget + ".journal";
+    std::string OldJournalFile = JournalFile + ".old";
+    bool Paged = IsPagedTaskFile(JournalTarget);
+    bool Patch = (TrackPages == true && SnapshotFile == JournalTarget && PageFile.bIsValid() == true && PageFile.GetPath() == JournalTarget);
+    std::error_code Error;
+    if (Background == true && std::filesystem::exists(OldJournalFile, Error) == false)
+    {
+        Journal.vidClose(false);
+        std::filesystem::rename(JournalFile, OldJournalFile, Error);
+        Journal.bOpen(JournalFile);
+        std::string Target = JournalTarget;
+        vidCompactTombstones();
+        Compacting = true;
+        TaskList Snapshot = (Patch == true)              ? CollectChangedTasks()
+                            : (Bodies.bIsOpen() == true) ? CollectAllTasks()
+                                                         : TaskList(tasks);
+        std::vector<int> Removed(RemovedIds.begin(), RemovedIds.end());
+        vidResetChanges(Target, Paged);
+        CompactionThread = std::thread([this, Snapshot = std::move(Snapshot), Removed = std::move(Removed), Patch, Paged, Target,
+                                        OldJournalFile, NextId = nextId]()
+                                       {
+            std::error_code Error;
+            bool Written = SyncFileToDisk(OldJournalFile) == true &&
+                           ((Patch == true) ? PageFile.bPatch(Snapshot, Removed, NextId)
+                                            : WriteTaskFile(Snapshot, Target, NextId, (Paged == true) ? &PageFile : nullptr));
+            if (Written == true)
             {
-                std::stringstream stream(Data);
-                std::vector<std::string> ParsedData;
-                std::string buffer;
-                std::string key, value;
-                while (std::getline(stream, buffer, '|'))
-                {
-                    std::stringstream str(buffer);
-                    if (std::getline(str, key, ':') && std::getline(str, value))
-                    {
-                        ParsedData.push_back(&value[1]);
-                    }
-                }
-                Task temp(std::stoi(ParsedData[0]), ParsedData[1], ParsedData[2], ParsedData[3], ParsedData[4]);
-                temp.vidSetTaskStatus(ParsedData[5]);
-                tasks.push_back(temp);
-                ParsedData.clear();
+                std::filesystem::remove(OldJournalFile, Error);
             }
-            Content.close();
-            std::cout << "Tasks Loaded Successfully" << std::endl;
+            else
+            {
+                std::cerr << "Error While Compacting The Journal" << std::endl;
+                CompactionFailed = true;
+            }
+            Compacting = false; });
+    }
+    else
+    {
+        Journal.vidSync();
+        std::vector<int> Removed(RemovedIds.begin(), RemovedIds.end());
+        bool Written = (Patch == true && PageFile.bPatch(CollectChangedTasks(), Removed, nextId) == true);
+        if (Written == false)
+        {
+            Written = (Bodies.bIsOpen() == true) ? WriteTaskFile(CollectAllTasks(), JournalTarget, nextId, (Paged == true) ? &PageFile : nullptr)
+                                                 : WriteTaskFile(tasks, JournalTarget, nextId, (Paged == true) ? &PageFile : nullptr);
+        }
+        if (Written == true)
+        {
+            Journal.vidClose();
+            std::filesystem::remove(OldJournalFile, Error);
+            std::filesystem::remove(JournalFile, Error);
+            Journal.bOpen(JournalFile);
+            vidResetChanges(JournalTarget, Paged);
+        }
+        else
+        {
+            std::cerr << "Error While Compacting The Journal" << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief Reports a task whose body could not be read back from the lazily loaded snapshot.
+ *
+ * A corrupt block fails every lookup of its tasks, so only the first
+ * MAX_REPORTED_LINES failures are reported one by one.
+ *
+ * @param id ID of the task.
+ */
+void TaskManager::vidReportBodyError(int id) const
+{
+    if (BodyErrors < MAX_REPORTED_LINES)
+    {
+        std::cerr << "Error While Reading Task " << id << " From " << Bodies.GetPath() << ", It Is Truncated Or Corrupted" << std::endl;
+    }
+    else if (BodyErrors == MAX_REPORTED_LINES)
+    {
+        std::cerr << "... Further Tasks That Cannot Be Read Are Not Reported" << std::endl;
+    }
+    ++BodyErrors;
+}
+
+/**
+ * @brief Gets a task still in the lazily loaded snapshot.
+ *
+ * A task whose text cannot be read back is reported and returned with an
+ * empty title and description.
+ *
+ * @param id ID of the task.
+ * @param Kept true to keep the task until the next lookup, query or search, false to rank it in the body cache.
+ * @return The task, or nullptr if the snapshot holds no such task or it was detached.
+ */
+const Task *TaskManager::ReadStub(int id, bool Kept) const
+{
+    const TaskStub *Stub = Bodies.FindStub(id);
+    if (Stub == nullptr)
+    {
+        return nullptr;
+    }
+    bool Intact = true;
+    const Task *task = (Kept == true) ? Bodies.Keep(*Stub, Intact) : Bodies.Fetch(*Stub, Intact);
+    if (Intact == false)
+    {
+        vidReportBodyError(id);
+    }
+    return task;
+}
+
+/**
+ * @brief Gets a task by ID for a query or search result.
+ *
+ * A task still in the snapshot is kept apart from the body cache, so a
+ * result larger than the cache never drops its own first tasks.
+ *
+ * @param id ID of a task known to exist.
+ * @return The task.
+ */
+const Task *TaskManager::FindMatch(int id) const
+{
+    const std::size_t *Slot = TaskIndex.Find(id);
+    if (Slot != nullptr)
+    {
+        return &tasks[*Slot];
+    }
+    return ReadStub(id, true);
+}
+
+/**
+ * @brief Calls a function on every task, in ID order after a lazy load.
+ *
+ * Without a lazy load, this is a plain pass over tasks. Otherwise the live
+ * stubs, already in ID order, are merged with the slots of tasks sorted by
+ * ID; each stub is built in one reused Task, and its block stays cached
+ * while the next stubs are read from it.
+ *
+ * @param Visit Function to call; a task built from the snapshot is only valid during the call.
+ * @param WithText false if Visit does not need the text of the tasks still in the snapshot.
+ */
+void TaskManager::vidForEachTask(const std::function<void(const Task &)> &Visit, bool WithText) const
+{
+    if (Bodies.bIsOpen() == false)
+    {
+        for (auto &it : tasks)
+        {
+            if (it.bIsRemoved() == false)
+            {
+                Visit(it);
+            }
+        }
+        return;
+    }
+    std::vector<std::size_t> Slots;
+    Slots.reserve(tasks.size() - Tombstones);
+    for (std::size_t Slot = 0; Slot < tasks.size(); ++Slot)
+    {
+        if (tasks[Slot].bIsRemoved() == false)
+        {
+            Slots.push_back(Slot);
+        }
+    }
+    std::sort(Slots.begin(), Slots.end(), [this](std::size_t Left, std::size_t Right)
+              { return tasks[Left].int32GetTaskID() < tasks[Right].int32GetTaskID(); });
+    auto Next = Slots.begin();
+    Task Scratch;
+    for (const TaskStub &Stub : Bodies.GetStubs())
+    {
+        if (Stub.Live == false)
+        {
+            continue;
+        }
+        while (Next != Slots.end() && tasks[*Next].int32GetTaskID() < Stub.Id)
+        {
+            Visit(tasks[*Next++]);
+        }
+        if (Bodies.bLoad(Stub, Scratch, WithText) == false)
+        {
+            vidReportBodyError(Stub.Id);
+        }
+        Visit(Scratch);
+    }
+    while (Next != Slots.end())
+    {
+        Visit(tasks[*Next++]);
+    }
+}
+
+/**
+ * @brief Copies every task, the ones still in the lazily loaded snapshot included.
+ *
+ * @return Copies of the tasks, in ID order.
+ */
+TaskList TaskManager::CollectAllTasks(void) const
+{
+    TaskList All;
+    All.reserve(size());
+    vidForEachTask([&All](const Task &task)
+                   { All.push_back(task); });
+    return All;
+}
+
+/**
+ * @brief Compacts the journal once it holds more records than there are tasks.
+ *
+ * Compacting only after at least max(TASK_JOURNAL_COMPACT_MIN, N) records keeps
+ * the amortized cost of each mutation constant.
+ */
+void TaskManager::vidCompactIfNeeded(void)
+{
+    if (Journal.bIsOpen() == true && Compacting == false &&
+        Journal.u64RecordCount() >= std::max(TASK_JOURNAL_COMPACT_MIN, size()))
+    {
+        CompactJournal(true);
+    }
+}
+
+/**
+ * @brief Waits for a running background compaction to finish.
+ *
+ * If it failed, the snapshot it was to write is unknown, so changes are no
+ * longer tracked against any file and the next save writes every task.
+ */
+void TaskManager::vidWaitForCompaction(void) const
+{
+    if (CompactionThread.joinable() == true)
+    {
+        CompactionThread.join();
+    }
+    if (CompactionFailed == true)
+    {
+        CompactionFailed = false;
+        vidResetChanges(std::string(), false);
+        ++Changes;
+    }
+}
+
+/**
+ * @brief Syncs and closes the journal, waiting for any running compaction.
+ *
+ * A text index that changed since it was loaded is then saved next to the
+ * task file, stamped with the files it now reflects.
+ */
+void TaskManager::CloseJournal(void)
+{
+    vidWaitForCompaction();
+    Journal.vidClose();
+    if (JournalTarget.empty() == false && TextIndex.bIsDirty() == true)
+    {
+        if (TextIndex.bSave(JournalTarget + ".idx", u64FilesStamp(TextIndexSources(JournalTarget))) == false)
+        {
+            std::cerr << "Error While Saving The Text Index" << std::endl;
         }
     }
 }
 
+/**
+ * @brief Starts grouping mutations so they are persisted only at commit points.
+ *
+ * Journal records of the batch are buffered instead of being flushed one by
+ * one, so a bulk import costs a few large writes and one fsync per commit.
+ */
+void TaskManager::BeginBatch(void)
+{
+    Journal.vidSetBatching(true);
+}
+
+/**
+ * @brief Persists every mutation made so far in the current batch.
+ */
+void TaskManager::Commit(void)
+{
+    Journal.vidSync();
+}
+
+/**
+ * @brief Commits and stops grouping mutations.
+ */
+void TaskManager::EndBatch(void)
+{
+    Journal.vidSetBatching(false);
+}
+
+/**
+ * @brief Waits until every mutation so far and any background snapshot are on disk.
+ *
+ * Mutations only hand their journal records to the operating system and leave
+ * the fsync to a background thread; this is the barrier for callers that need
+ * durability before going on.
+ */
+void TaskManager::Flush(void)
+{
+    Journal.vidSync();
+    vidWaitForCompaction();
+}
+
+/**
+ * @brief Converts a task file between the text, binary, paged and snapshot formats.
+ *
+ * The format of each file is chosen by its extension (".bin", ".tdb",
+ * ".tsnap", or text for any other name), so this converts in any direction.
+ *
+ * @param from Name of the file to read tasks from.
+ * @param to Name of the file to write tasks to.
+ * @return true if the source file exists and was converted, false if it is missing or unreadable.
+ */
+bool ConvertTaskFile(const std::string &from, const std::string &to)
+{
+    if (std::filesystem::exists(from) == false)
+    {
+        std::cerr << "File " << from << " Does Not Exist" << std::endl;
+        return false;
+    }
+    TaskManager Converter;
+    if (Converter.LoadTasksFrom(from) == false)
+    {
+        return false;    /*Never Overwrite The Target With A Partial Read*/
+    }
+    Converter.ReplayJournal(from);
+    Converter.SaveTasksToFile(to);
+    return true;
+}
+
 /**
  * @brief Validates the current user input from std::cin.
  * 
@@ -348,4 +1613,7 @@ bool ValidateUserInput(void)
 /**
  * @brief Destructor for TaskManager.
  */
-TaskManager::~TaskManager() = default;
+TaskManager::~TaskManager()
+{
+    CloseJournal();
+}
@@ -14,6 +14,7 @@
 #define __TASK__MANAGER__
 
 #include <iostream>
+#include <memory_resource>
 #include <vector>
 #include "task.hpp"
 #include <functional>
@@ -22,6 +23,17 @@
 #include <filesystem>
 #include <fstream>
 #include <regex>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include "task_journal.hpp"
+#include "task_paged.hpp"
+#include "task_secondary_index.hpp"
+#include "task_column_store.hpp"
+#include "task_text_index.hpp"
+#include "task_body_cache.hpp"
+#include "task_id_index.hpp"
 
 /**
  * @class TaskManager
@@ -31,8 +43,155 @@
  */
 class TaskManager {
 private:
-    std::vector<Task> tasks;  /**< List of all tasks. */
-    int nextId;               /**< Tracks the next available task ID. */
+    std::pmr::unsynchronized_pool_resource TaskArena; /**< Pool serving the text of every task in tasks. */
+    TaskList tasks{&TaskArena}; /**< List of all tasks, including tombstones of deleted tasks until compaction; after a lazy load, only the tasks detached from Bodies. */
+    std::size_t Tombstones = 0; /**< Number of tombstones in tasks. */
+    TaskIdIndex TaskIndex;    /**< Maps each task ID to its slot in tasks; it only allocates when it grows, so IDs freed by deletions are reused without allocating. */
+    mutable TaskSecondaryIndex FieldIndex; /**< Tasks by status, priority and due date, built on the first selective query. */
+    mutable TaskColumnStore Columns;       /**< Columnar copy of tasks, one row per slot, built on the first scan and dropped when tombstones are compacted. */
+    mutable TaskTextIndex TextIndex;    /**< Tasks by title and description tokens, loaded or built on the first search. */
+    int nextId;               /**< Next task ID to hand out; it never decreases, so IDs are never reused. */
+    TaskJournal Journal;      /**< Write-ahead journal of mutations, when enabled. */
+    std::string JournalTarget;      /**< Task file the journal applies to. */
+    mutable std::thread CompactionThread;   /**< Background thread writing the latest snapshot; saves wait for it. */
+    std::atomic<bool> Compacting{false};    /**< true while CompactionThread is still writing. */
+    mutable std::atomic<bool> CompactionFailed{false};  /**< Set by CompactionThread if the snapshot could not be written. */
+    mutable TaskPageFile PageFile;          /**< Page layout of SnapshotFile when it is a paged file. */
+    mutable std::string SnapshotFile;       /**< File holding the tasks as of the last load, save or compaction, or empty if none does. */
+    mutable int SnapshotNextId = 0;         /**< nextId when SnapshotFile was written; tasks with higher IDs were added since. */
+    mutable std::size_t Changes = 0;        /**< Number of mutations since SnapshotFile was written. */
+    mutable bool TrackPages = false;        /**< true while DirtyIds and RemovedIds are kept for patching PageFile. */
+    mutable std::unordered_set<int> DirtyIds;   /**< IDs below SnapshotNextId changed since SnapshotFile was written. */
+    mutable std::unordered_set<int> RemovedIds; /**< IDs below SnapshotNextId removed since SnapshotFile was written. */
+    mutable TaskBodyCache Bodies;           /**< Stubs of the tasks left in the snapshot after a lazy load. */
+    std::size_t LazyBodies = 0;             /**< Tasks a lazy load keeps in memory, or 0 to load every task in full. */
+    mutable std::size_t BodyErrors = 0;     /**< Number of tasks whose text could not be read back from Bodies. */
+
+    /**
+     * @brief Re-indexes the slots of all tasks starting at the given slot.
+     *
+     * @param FirstSlot First slot in tasks whose index entry must be refreshed.
+     */
+    void vidReindexFrom(std::size_t FirstSlot);
+
+    /**
+     * @brief Drops every tombstone from tasks and re-indexes the tasks that moved.
+     */
+    void vidCompactTombstones(void);
+
+    /**
+     * @brief Compacts the tombstones once they make up a large enough share of tasks.
+     */
+    void vidCompactTombstonesIfNeeded(void);
+
+    /**
+     * @brief Moves nextId past the IDs of newly loaded tasks and the ID recorded in their file.
+     *
+     * @param FirstSlot First slot in tasks holding a loaded task.
+     * @param SavedNextId Next ID recorded in the file, or 0 if none was recorded.
+     */
+    void vidAdvanceNextId(std::size_t FirstSlot, int SavedNextId);
+
+    /**
+     * @brief Writes the string representation of every task to a stream.
+     *
+     * @param Out Stream to write to.
+     * @param Numbered true to put a "Task N Data ==>" heading and a separator line around each task.
+     */
+    void vidWriteTasks(std::ostream &Out, bool Numbered) const;
+
+    /**
+     * @brief Inserts a task or replaces the task with the same ID.
+     *
+     * @param task Full state of the task.
+     */
+    void vidApplyPut(const Task &task);
+
+    /**
+     * @brief Notes that a task was added or changed since the last snapshot.
+     *
+     * @param id ID of the task.
+     */
+    void vidMarkDirty(int id);
+
+    /**
+     * @brief Notes that a task was removed since the last snapshot.
+     *
+     * @param id ID of the task.
+     */
+    void vidMarkRemoved(int id);
+
+    /**
+     * @brief Records that a file now holds every task, and starts tracking changes from there.
+     *
+     * @param filename File holding the tasks, or an empty string if none does.
+     * @param Paged true if PageFile describes the file, so changes are tracked per task.
+     */
+    void vidResetChanges(const std::string &filename, bool Paged) const;
+
+    /**
+     * @brief Collects the tasks added or changed since the last snapshot.
+     *
+     * @return Copies of the tasks, in no particular order.
+     */
+    TaskList CollectChangedTasks(void) const;
+
+    /**
+     * @brief Reports a task whose body could not be read back from the lazily loaded snapshot.
+     *
+     * @param id ID of the task.
+     */
+    void vidReportBodyError(int id) const;
+
+    /**
+     * @brief Gets a task still in the lazily loaded snapshot.
+     *
+     * @param id ID of the task.
+     * @param Kept true to keep the task until the next lookup, query or search, false to rank it in the body cache.
+     * @return The task, or nullptr if the snapshot holds no such task or it was detached.
+     */
+    const Task *ReadStub(int id, bool Kept) const;
+
+    /**
+     * @brief Gets a task by ID for a query or search result.
+     *
+     * @param id ID of a task known to exist.
+     * @return The task.
+     */
+    const Task *FindMatch(int id) const;
+
+    /**
+     * @brief Builds the secondary index if no query built it yet.
+     */
+    void vidBuildFieldIndex(void) const;
+
+    /**
+     * @brief Calls a function on every task, in ID order after a lazy load.
+     *
+     * @param Visit Function to call; a task built from the snapshot is only valid during the call.
+     * @param WithText false if Visit does not need the text of the tasks still in the snapshot.
+     */
+    void vidForEachTask(const std::function<void(const Task &)> &Visit, bool WithText = true) const;
+
+    /**
+     * @brief Copies every task, the ones still in the lazily loaded snapshot included.
+     *
+     * @return Copies of the tasks, in ID order.
+     */
+    TaskList CollectAllTasks(void) const;
+
+    /**
+     * @brief Compacts the journal once it holds more records than there are tasks.
+     *
+     * Nothing happens while a background compaction is still writing, so a
+     * mutation never waits for the disk.
+     */
+    void vidCompactIfNeeded(void);
+
+    /**
+     * @brief Waits for a running background compaction to finish.
+     */
+    void vidWaitForCompaction(void) const;
 
 public:
     /**
@@ -43,17 +202,76 @@ public:
     /**
      * @brief Adds a new task to the list.
      *
+     * The due date and priority are parsed and validated here, once, and stored
+     * in their typed forms.
+     *
      * @param title Title of the task.
      * @param desc Description of the task.
-     * @param dueDate Due date of the task.
-     * @param priority Priority level of the task.
+     * @param dueDate Due date of the task ("YYYY-MM-DD", or empty for none).
+     * @param priority Priority level of the task ("Low", "Medium", "High", or empty).
+     * @return ID of the new task, or 0 if the due date or priority is invalid.
+     */
+    int addTask(const std::string& title, const std::string& desc, const std::string& dueDate, const std::string& priority);
+
+    /**
+     * @brief Adds a new task whose due date and priority are already parsed.
+     *
+     * @param title Title of the task.
+     * @param desc Description of the task.
+     * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+     * @param Priority Priority level of the task.
+     * @return ID of the new task.
+     */
+    int addTask(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority);
+
+    /**
+     * @brief Finds a task by its ID in constant time.
+     *
+     * After a lazy load, a task still in the snapshot is found by a binary
+     * search of its stub and read in; as the caller may change it, it is
+     * detached from the snapshot and stays in memory from then on.
+     *
+     * @param id ID of the task to look up.
+     * @return Pointer to the task, or nullptr if no task has this ID.
+     */
+    Task* findTask(int id);
+
+    /**
+     * @brief Finds a task by its ID in constant time.
+     *
+     * After a lazy load, a task still in the snapshot is found by a binary
+     * search of its stub and read through the body cache; it stays valid at
+     * least until the next lookup.
+     *
+     * @param id ID of the task to look up.
+     * @return Pointer to the task, or nullptr if no task has this ID.
+     */
+    const Task* findTask(int id) const;
+
+    /**
+     * @brief Removes a task by ID without printing anything.
+     *
+     * The task is turned into a tombstone in constant time; tombstones are
+     * compacted away in bulk once they make up a quarter of the list.
+     *
+     * @param id ID of the task to remove.
+     * @return true if the task existed and was removed, false otherwise.
      */
-    void addTask(const std::string& title, const std::string& desc, const std::string& dueDate, const std::string& priority);
+    bool removeTask(int id);
+
+    /**
+     * @brief Gets the number of tasks currently stored.
+     *
+     * @return Number of tasks.
+     */
+    std::size_t size(void) const;
 
     /**
      * @brief Lists all current tasks.
+     *
+     * @param Out Stream to write the listing to.
      */
-    void listTasks() const;
+    void listTasks(std::ostream &Out = std::cout) const;
 
     /**
      * @brief Updates task fields based on task ID.
@@ -76,9 +294,104 @@ public:
      */
     void ChangeTaskStatus(int id);
 
+    /**
+     * @brief Sets the status of a task without prompting.
+     *
+     * @param id ID of the task whose status to set.
+     * @param state New status of the task.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setStatus(int id, TaskState state);
+
+    /**
+     * @brief Sets the status of many tasks in one pass without prompting.
+     *
+     * Unknown IDs are skipped. The secondary index is updated in one batch and
+     * the change is journaled as a single status record.
+     *
+     * @param ids IDs of the tasks whose status to set.
+     * @param state New status of the tasks.
+     * @return Number of tasks that were updated.
+     */
+    std::size_t setStatus(const std::vector<int>& ids, TaskState state);
+
+    /**
+     * @brief Sets the title of a task without prompting.
+     *
+     * @param id ID of the task to update.
+     * @param title New title.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setTitle(int id, std::string_view title);
+
+    /**
+     * @brief Sets the description of a task without prompting.
+     *
+     * @param id ID of the task to update.
+     * @param desc New description.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setDescription(int id, std::string_view desc);
+
+    /**
+     * @brief Sets the due date of a task without prompting.
+     *
+     * @param id ID of the task to update.
+     * @param DueDay New due date as a day number, or TASK_NO_DUE_DATE.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setDueDate(int id, std::int32_t DueDay);
+
+    /**
+     * @brief Sets the priority of a task without prompting.
+     *
+     * @param id ID of the task to update.
+     * @param Priority New priority.
+     * @return true if the task exists and was updated, false otherwise.
+     */
+    bool setPriority(int id, TaskPriority Priority);
+
+    /**
+     * @brief Collects the tasks matching a filter.
+     *
+     * Broad filters scan the status, priority and due date columns; narrow
+     * ones and due date ranges are answered by the secondary index.
+     *
+     * @param Filter Conditions to match.
+     * @return Pointers to the matching tasks ordered by due date and then ID, valid until the next mutation;
+     *         after a lazy load, the ones read from the snapshot only until the next lookup, query or search.
+     */
+    std::vector<const Task*> Query(const TaskFilter& Filter) const;
+
+    /**
+     * @brief Counts the tasks matching a filter without collecting them.
+     *
+     * Only the columns the filter restricts are read, and a filter on status
+     * and priority alone is answered from per-pair counts.
+     *
+     * @param Filter Conditions to match.
+     * @return Number of matching tasks.
+     */
+    std::size_t Count(const TaskFilter& Filter) const;
+
+    /**
+     * @brief Finds the tasks whose title or description match a keyword query.
+     *
+     * @param Query Terms to match; see TaskTextIndex for the syntax.
+     * @return Pointers to the matching tasks in ID order, valid until the next mutation;
+     *         after a lazy load, the ones read from the snapshot only until the next lookup, query or search.
+     */
+    std::vector<const Task*> Search(std::string_view Query) const;
+
     /**
      * @brief Saves the current task list to a file.
      *
+     * Files ending in ".bin" are written in the binary format, files ending in
+     * ".tdb" in the paged format, files ending in ".tsnap" as a compressed
+     * snapshot, and all others in the pipe-delimited text format.
+     * Nothing is written if no task changed since the file was last loaded or
+     * saved, and a paged file only has the pages holding changed tasks rewritten.
+     *
      * @param filename Name of the file to save tasks.
      */
     void SaveTasksToFile(const std::string& filename) const;
@@ -86,9 +399,84 @@ public:
     /**
      * @brief Loads tasks from a file into memory.
      *
+     * The file format is chosen by extension, as for SaveTasksToFile().
+     *
      * @param filename Name of the file to load tasks from.
+     * @return true if the file was read or created, false if it could not be created or is unreadable, truncated or corrupt.
+     */
+    bool LoadTasksFrom(const std::string& filename);
+
+    /**
+     * @brief Selects whether the next load of a snapshot file leaves the task text on disk.
+     *
+     * A lazy load builds no task: it only keeps a compact stub of each one,
+     * with its ID, status, priority and due date and where its title and
+     * description are in the file. A task is read in the first time a lookup,
+     * listing, update or search needs it, and only the most recently used
+     * ones are kept in memory; a task that is changed or deleted is kept in
+     * full from then on. It applies to ".tsnap" files loaded into an empty
+     * manager; other loads read every task in full.
+     *
+     * @param CachedBodies Number of tasks read from the file to keep in memory, or 0 to load every task in full.
      */
-    void LoadTasksFrom(const std::string& filename);
+    void SetLazyLoading(std::size_t CachedBodies);
+
+    /**
+     * @brief Replays the journal of a task file on top of the loaded tasks.
+     *
+     * Both the live journal and a journal left behind by an interrupted
+     * compaction are replayed. Nothing is replayed while the journal is open.
+     *
+     * @param filename Name of the task file whose journal to replay.
+     * @return Number of journal records replayed.
+     */
+    std::size_t ReplayJournal(const std::string& filename);
+
+    /**
+     * @brief Replays and then opens the journal of a task file for writing.
+     *
+     * Once the journal is open, every mutation is appended to it instead of
+     * requiring a full save. A saved text index that still matches the task
+     * file and its journals is loaded as well.
+     *
+     * @param filename Name of the task file the journal applies to.
+     * @return true if the journal is open, false otherwise.
+     */
+    bool OpenJournal(const std::string& filename);
+
+    /**
+     * @brief Writes the current tasks as the new snapshot and empties the journal.
+     *
+     * @param Background If true, the snapshot is written on a background thread.
+     */
+    void CompactJournal(bool Background = true);
+
+    /**
+     * @brief Syncs and closes the journal, waiting for any running compaction.
+     *
+     * A text index that changed since it was loaded is saved next to the task file.
+     */
+    void CloseJournal(void);
+
+    /**
+     * @brief Starts grouping mutations so they are persisted only at commit points.
+     */
+    void BeginBatch(void);
+
+    /**
+     * @brief Persists every mutation made so far in the current batch.
+     */
+    void Commit(void);
+
+    /**
+     * @brief Commits and stops grouping mutations.
+     */
+    void EndBatch(void);
+
+    /**
+     * @brief Waits until every mutation so far and any background snapshot are on disk.
+     */
+    void Flush(void);
 
     /**
      * @brief Destructor for TaskManager.
@@ -105,4 +493,16 @@ public:
  */
 bool ValidateUserInput(void);
 
+/**
+ * @brief Converts a task file between the text, binary, paged and snapshot formats.
+ *
+ * The format of each file is chosen by its extension: ".bin", ".tdb",
+ * ".tsnap", or text for any other name.
+ *
+ * @param from Name of the file to read tasks from.
+ * @param to Name of the file to write tasks to.
+ * @return true if the source file exists and was converted, false if it is missing or unreadable.
+ */
+bool ConvertTaskFile(const std::string& from, const std::string& to);
+
 #endif // __TASK__MANAGER__
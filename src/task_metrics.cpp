@@ -0,0 +1,666 @@
+/**
+ * @file task_metrics.cpp
+ * @brief Implementation of the operation counters and latency histograms of the task manager.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_metrics.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Number of stripes the allocation counter is spread over, so threads rarely share a cache line.
+ */
+static constexpr unsigned TASK_METRICS_STRIPES = 16;
+
+/**
+ * @brief Smallest histogram bound exported to Prometheus, as a power of two in nanoseconds (about 1 us).
+ */
+static constexpr unsigned TASK_METRICS_FIRST_BOUND = 10;
+
+/**
+ * @brief Largest histogram bound exported to Prometheus, as a power of two in nanoseconds (about 69 s).
+ */
+static constexpr unsigned TASK_METRICS_LAST_BOUND = 36;
+
+/**
+ * @brief Gets the bucket holding a value.
+ *
+ * Values below twice TASK_METRICS_SUB_BUCKETS get a bucket each. Above that,
+ * the bucket is given by the position of the highest set bit and the three
+ * bits below it.
+ *
+ * @param Value Value to place.
+ * @return Index of its bucket.
+ */
+unsigned LatencyHistogram::u32BucketOf(std::uint64_t Value)
+{
+    if (Value < 2 * TASK_METRICS_SUB_BUCKETS)
+    {
+        return static_cast<unsigned>(Value);
+    }
+    unsigned Exponent = 63 - static_cast<unsigned>(__builtin_clzll(Value));
+    unsigned Sub = static_cast<unsigned>(Value >> (Exponent - 3)) - TASK_METRICS_SUB_BUCKETS;
+    return (Exponent - 2) * TASK_METRICS_SUB_BUCKETS + Sub;
+}
+
+/**
+ * @brief Gets the largest value a bucket holds.
+ *
+ * @param Bucket Index of the bucket.
+ * @return Inclusive upper bound of the bucket.
+ */
+std::uint64_t LatencyHistogram::u64BucketTop(unsigned Bucket)
+{
+    if (Bucket < 2 * TASK_METRICS_SUB_BUCKETS)
+    {
+        return Bucket;
+    }
+    unsigned Shift = Bucket / TASK_METRICS_SUB_BUCKETS - 1;
+    std::uint64_t Lower = static_cast<std::uint64_t>(TASK_METRICS_SUB_BUCKETS + Bucket % TASK_METRICS_SUB_BUCKETS) << Shift;
+    return Lower + ((std::uint64_t{1} << Shift) - 1);
+}
+
+/**
+ * @brief Records one value.
+ *
+ * @param Value Latency in nanoseconds.
+ */
+void LatencyHistogram::vidRecord(std::uint64_t Value)
+{
+    std::atomic<std::uint64_t> &Bucket = Buckets[u32BucketOf(Value)];
+    Bucket.store(Bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    Total.store(Total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    Sum.store(Sum.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+    if (Value > Max.load(std::memory_order_relaxed))
+    {
+        Max.store(Value, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Adds every value of another histogram to this one.
+ *
+ * @param Other Histogram to add.
+ */
+void LatencyHistogram::vidAdd(const LatencyHistogram &Other)
+{
+    for (unsigned Bucket = 0; Bucket < TASK_METRICS_BUCKETS; ++Bucket)
+    {
+        Buckets[Bucket].store(u64GetBucket(Bucket) + Other.u64GetBucket(Bucket), std::memory_order_relaxed);
+    }
+    Total.store(u64GetCount() + Other.u64GetCount(), std::memory_order_relaxed);
+    Sum.store(u64GetSum() + Other.u64GetSum(), std::memory_order_relaxed);
+    Max.store(std::max(u64GetMax(), Other.u64GetMax()), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of values in a bucket.
+ *
+ * @param Bucket Index of the bucket.
+ * @return Number of values.
+ */
+std::uint64_t LatencyHistogram::u64GetBucket(unsigned Bucket) const
+{
+    return Buckets[Bucket].load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of recorded values.
+ *
+ * @return Number of values.
+ */
+std::uint64_t LatencyHistogram::u64GetCount(void) const
+{
+    return Total.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the sum of the recorded values.
+ *
+ * @return Sum in nanoseconds.
+ */
+std::uint64_t LatencyHistogram::u64GetSum(void) const
+{
+    return Sum.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the largest recorded value.
+ *
+ * @return Largest value in nanoseconds, or 0 if none was recorded.
+ */
+std::uint64_t LatencyHistogram::u64GetMax(void) const
+{
+    return Max.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets a percentile of the recorded values.
+ *
+ * The buckets are read while other threads may still record, so the result
+ * is only as consistent as a snapshot taken at that moment.
+ *
+ * @param Percentile Percentile to get, from 0 to 100.
+ * @return Upper bound of the bucket holding it, capped by the largest value, or 0 if none was recorded.
+ */
+std::uint64_t LatencyHistogram::u64GetPercentile(double Percentile) const
+{
+    std::uint64_t Count = u64GetCount();
+    if (Count == 0)
+    {
+        return 0;
+    }
+    std::uint64_t Rank = static_cast<std::uint64_t>(Percentile / 100.0 * static_cast<double>(Count) + 0.5);
+    Rank = (Rank == 0) ? 1 : Rank;
+    std::uint64_t Seen = 0;
+    for (unsigned Bucket = 0; Bucket < TASK_METRICS_BUCKETS; ++Bucket)
+    {
+        Seen += u64GetBucket(Bucket);
+        if (Seen >= Rank)
+        {
+            return std::min(u64BucketTop(Bucket), u64GetMax());
+        }
+    }
+    return u64GetMax();
+}
+
+/**
+ * @brief Gets the name of an operation, as used in metric labels.
+ *
+ * @param Op Operation.
+ * @return Lowercase name, such as "add".
+ */
+const char *GetMetricOpName(MetricOp Op)
+{
+    static const char *const Names[] = {"add", "delete", "update", "status", "load", "save"};
+    return Names[static_cast<std::size_t>(Op)];
+}
+
+#if TASKMANAGER_METRICS
+
+/**
+ * @brief Number of operation kinds.
+ */
+static constexpr std::size_t TASK_METRICS_OPS = static_cast<std::size_t>(MetricOp::Count);
+
+/**
+ * @struct MetricStripe
+ * @brief One stripe of the allocation counter, alone on its cache line.
+ */
+struct alignas(64) MetricStripe
+{
+    std::atomic<std::uint64_t> Value{0};    /**< Allocations counted on this stripe. */
+};
+
+/**
+ * @struct MetricBlock
+ * @brief Figures recorded by one thread; only that thread writes them.
+ */
+struct MetricBlock
+{
+    LatencyHistogram Histograms[TASK_METRICS_OPS];                                      /**< Sampled latencies per operation. */
+    std::atomic<std::uint64_t> Calls[TASK_METRICS_OPS] = {};                            /**< Calls per operation. */
+    std::atomic<std::uint64_t> Counters[static_cast<std::size_t>(MetricCounter::Count)] = {};  /**< Counters but Allocations. */
+    std::uint32_t Countdown[TASK_METRICS_OPS] = {};                                     /**< Calls left until the next sample. */
+    bool InUse = true;                                                                  /**< false once its thread exited; guarded by the registry lock. */
+};
+
+/**
+ * @class MetricThreadSlot
+ * @brief Block of the current thread, handed back to the registry when the thread exits.
+ */
+class MetricThreadSlot
+{
+public:
+    MetricBlock *Block = nullptr;   /**< Block of the thread, or nullptr before its first operation. */
+
+    /**
+     * @brief Releases the block so a later thread can carry on recording into it.
+     */
+    ~MetricThreadSlot();
+};
+
+/**
+ * @brief Block of the current thread, or nullptr before its first operation.
+ *
+ * It duplicates ThreadSlot.Block because a constant-initialized pointer is
+ * read directly, while ThreadSlot, which has a destructor, is reached through
+ * a call that checks its initialization on every access.
+ */
+static thread_local MetricBlock *ThreadBlock = nullptr;
+
+/**
+ * @brief Guards the block registry and the InUse flags.
+ *
+ * @return Registry lock.
+ */
+static std::mutex &GetRegistryLock(void)
+{
+    static std::mutex Lock;
+    return Lock;
+}
+
+/**
+ * @brief Gets every block ever handed out; blocks live until the process exits.
+ *
+ * @return Registry of blocks.
+ */
+static std::vector<std::unique_ptr<MetricBlock>> &GetRegistry(void)
+{
+    static std::vector<std::unique_ptr<MetricBlock>> Blocks;
+    return Blocks;
+}
+
+/**
+ * @brief Releases the block so a later thread can carry on recording into it.
+ */
+MetricThreadSlot::~MetricThreadSlot()
+{
+    ThreadBlock = nullptr;
+    if (Block != nullptr)
+    {
+        std::lock_guard<std::mutex> Guard(GetRegistryLock());
+        Block->InUse = false;
+    }
+}
+
+/**
+ * @brief Block slot of the current thread.
+ */
+static thread_local MetricThreadSlot ThreadSlot;
+
+/**
+ * @brief Stripes of the allocation counter.
+ */
+static MetricStripe AllocationStripes[TASK_METRICS_STRIPES];
+
+/**
+ * @brief Stripe handed out to the next thread that allocates.
+ */
+static std::atomic<unsigned> NextStripe{0};
+
+/**
+ * @brief Stripe of the current thread, or TASK_METRICS_STRIPES before its first allocation.
+ */
+static thread_local unsigned ThreadStripe = TASK_METRICS_STRIPES;
+
+/**
+ * @brief Gives the current thread a released or new block.
+ *
+ * @return Block of the thread.
+ */
+static MetricBlock &GetNewThreadBlock(void)
+{
+    if (ThreadSlot.Block == nullptr)
+    {
+        std::lock_guard<std::mutex> Guard(GetRegistryLock());
+        for (std::unique_ptr<MetricBlock> &Block : GetRegistry())
+        {
+            if (Block->InUse == false)
+            {
+                Block->InUse = true;
+                ThreadSlot.Block = Block.get();
+                break;
+            }
+        }
+        if (ThreadSlot.Block == nullptr)
+        {
+            GetRegistry().push_back(std::make_unique<MetricBlock>());
+            ThreadSlot.Block = GetRegistry().back().get();
+        }
+    }
+    ThreadBlock = ThreadSlot.Block;
+    return *ThreadBlock;
+}
+
+/**
+ * @brief Gets the block of the current thread, taking one on first use.
+ *
+ * @return Block of the thread.
+ */
+static inline MetricBlock &GetThreadBlock(void)
+{
+    return (ThreadBlock != nullptr) ? *ThreadBlock : GetNewThreadBlock();
+}
+
+/**
+ * @brief Adds one to a value only the current thread writes.
+ *
+ * @param Value Value to increase.
+ * @param Amount Amount to add.
+ */
+static void vidBump(std::atomic<std::uint64_t> &Value, std::uint64_t Amount)
+{
+    Value.store(Value.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Counts one call of an operation and tells whether to time it.
+ *
+ * Loads and saves are always timed; the other operations are timed once
+ * every TASK_METRICS_SAMPLE_PERIOD calls of each thread, starting with the
+ * first.
+ *
+ * @param Op Operation.
+ * @return true if this call is one of the sampled ones.
+ */
+bool bCountOperation(MetricOp Op)
+{
+    MetricBlock &Block = GetThreadBlock();
+    std::size_t Index = static_cast<std::size_t>(Op);
+    vidBump(Block.Calls[Index], 1);
+    if (Op == MetricOp::Load || Op == MetricOp::Save)
+    {
+        return true;
+    }
+    if (Block.Countdown[Index] == 0)
+    {
+        Block.Countdown[Index] = TASK_METRICS_SAMPLE_PERIOD - 1;
+        return true;
+    }
+    --Block.Countdown[Index];
+    return false;
+}
+
+/**
+ * @brief Records the latency of one sampled operation.
+ *
+ * @param Op Operation.
+ * @param Nanos Latency in nanoseconds.
+ */
+void vidRecordLatency(MetricOp Op, std::uint64_t Nanos)
+{
+    GetThreadBlock().Histograms[static_cast<std::size_t>(Op)].vidRecord(Nanos);
+}
+
+/**
+ * @brief Adds to a counter.
+ *
+ * Allocations go to a shared striped counter instead of the thread's block,
+ * because operator new runs before and after the block of a thread exists.
+ *
+ * @param Counter Counter to increase.
+ * @param Value Amount to add.
+ */
+void vidAddToCounter(MetricCounter Counter, std::uint64_t Value)
+{
+    if (Counter == MetricCounter::Allocations)
+    {
+        if (ThreadStripe == TASK_METRICS_STRIPES)
+        {
+            ThreadStripe = NextStripe.fetch_add(1, std::memory_order_relaxed) % TASK_METRICS_STRIPES;
+        }
+        AllocationStripes[ThreadStripe].Value.fetch_add(Value, std::memory_order_relaxed);
+        return;
+    }
+    vidBump(GetThreadBlock().Counters[static_cast<std::size_t>(Counter)], Value);
+}
+
+/**
+ * @struct MetricSnapshot
+ * @brief Figures of every thread added up.
+ */
+struct MetricSnapshot
+{
+    LatencyHistogram Histograms[TASK_METRICS_OPS];                                  /**< Sampled latencies per operation. */
+    std::uint64_t Calls[TASK_METRICS_OPS] = {};                                     /**< Calls per operation. */
+    std::uint64_t Counters[static_cast<std::size_t>(MetricCounter::Count)] = {};    /**< Value of each counter. */
+};
+
+/**
+ * @brief Adds up the figures of every thread.
+ *
+ * @param Snapshot Receives the totals; it must start empty.
+ */
+static void vidTakeSnapshot(MetricSnapshot &Snapshot)
+{
+    std::lock_guard<std::mutex> Guard(GetRegistryLock());
+    for (const std::unique_ptr<MetricBlock> &Block : GetRegistry())
+    {
+        for (std::size_t Index = 0; Index < TASK_METRICS_OPS; ++Index)
+        {
+            Snapshot.Histograms[Index].vidAdd(Block->Histograms[Index]);
+            Snapshot.Calls[Index] += Block->Calls[Index].load(std::memory_order_relaxed);
+        }
+        for (std::size_t Index = 0; Index < static_cast<std::size_t>(MetricCounter::Count); ++Index)
+        {
+            Snapshot.Counters[Index] += Block->Counters[Index].load(std::memory_order_relaxed);
+        }
+    }
+    for (const MetricStripe &Stripe : AllocationStripes)
+    {
+        Snapshot.Counters[static_cast<std::size_t>(MetricCounter::Allocations)] += Stripe.Value.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Formats a duration with a unit that keeps it short.
+ *
+ * @param Nanos Duration in nanoseconds.
+ * @return Text such as "850ns", "12.3us" or "4.56ms".
+ */
+static std::string FormatNanos(std::uint64_t Nanos)
+{
+    char Text[32];
+    double Value = static_cast<double>(Nanos);
+    if (Nanos < 1000)
+    {
+        std::snprintf(Text, sizeof(Text), "%lluns", static_cast<unsigned long long>(Nanos));
+    }
+    else if (Nanos < 1000000)
+    {
+        std::snprintf(Text, sizeof(Text), "%.3gus", Value / 1e3);
+    }
+    else if (Nanos < 1000000000)
+    {
+        std::snprintf(Text, sizeof(Text), "%.3gms", Value / 1e6);
+    }
+    else
+    {
+        std::snprintf(Text, sizeof(Text), "%.3gs", Value / 1e9);
+    }
+    return Text;
+}
+
+/**
+ * @brief Writes a human-readable summary of every operation and counter.
+ *
+ * Each line starts with "# ", so the summary can sit in a batch response or
+ * be fed back as a batch without being taken for commands. "count" is the
+ * exact number of calls; the latencies come from the sampled calls.
+ *
+ * @param Out Stream to write to.
+ */
+void vidWriteMetricsSummary(std::ostream &Out)
+{
+    auto Snapshot = std::make_unique<MetricSnapshot>();
+    vidTakeSnapshot(*Snapshot);
+    for (std::size_t Index = 0; Index < TASK_METRICS_OPS; ++Index)
+    {
+        const LatencyHistogram &Histogram = Snapshot->Histograms[Index];
+        Out << "# " << GetMetricOpName(static_cast<MetricOp>(Index)) << " count=" << Snapshot->Calls[Index];
+        if (Histogram.u64GetCount() != 0)
+        {
+            Out << " timed=" << Histogram.u64GetCount()
+                << " mean=" << FormatNanos(Histogram.u64GetSum() / Histogram.u64GetCount())
+                << " p50=" << FormatNanos(Histogram.u64GetPercentile(50))
+                << " p90=" << FormatNanos(Histogram.u64GetPercentile(90))
+                << " p99=" << FormatNanos(Histogram.u64GetPercentile(99))
+                << " p99.9=" << FormatNanos(Histogram.u64GetPercentile(99.9))
+                << " max=" << FormatNanos(Histogram.u64GetMax());
+        }
+        Out << '\n';
+    }
+    Out << "# bytes_read=" << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::BytesRead)]
+        << " bytes_written=" << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::BytesWritten)]
+        << " allocations=" << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::Allocations)]
+        << " body_faults=" << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::BodyFaults)] << '\n';
+}
+
+/**
+ * @brief Writes every operation and counter in the Prometheus text exposition format.
+ *
+ * Calls are exported as one counter labelled by operation. Latencies are
+ * exported as one histogram labelled by operation, over the sampled calls,
+ * with a bound at each power of two nanoseconds from about 1 us to about
+ * 69 s; each bound is an exact sum of the finer internal buckets.
+ *
+ * @param Out Stream to write to.
+ */
+void vidWritePrometheusMetrics(std::ostream &Out)
+{
+    auto Snapshot = std::make_unique<MetricSnapshot>();
+    vidTakeSnapshot(*Snapshot);
+    char Number[32];
+    Out << "# HELP taskmanager_operations_total Calls of task manager operations.\n"
+        << "# TYPE taskmanager_operations_total counter\n";
+    for (std::size_t Index = 0; Index < TASK_METRICS_OPS; ++Index)
+    {
+        Out << "taskmanager_operations_total{op=\"" << GetMetricOpName(static_cast<MetricOp>(Index)) << "\"} "
+            << Snapshot->Calls[Index] << '\n';
+    }
+    Out << "# HELP taskmanager_operation_duration_seconds Latency of sampled task manager operations.\n"
+        << "# TYPE taskmanager_operation_duration_seconds histogram\n";
+    for (std::size_t Index = 0; Index < TASK_METRICS_OPS; ++Index)
+    {
+        const LatencyHistogram &Histogram = Snapshot->Histograms[Index];
+        const char *Name = GetMetricOpName(static_cast<MetricOp>(Index));
+        std::uint64_t Count = Histogram.u64GetCount();
+        std::uint64_t Seen = 0;
+        unsigned Bucket = 0;
+        for (unsigned Bound = TASK_METRICS_FIRST_BOUND; Bound <= TASK_METRICS_LAST_BOUND; ++Bound)
+        {
+            std::uint64_t Limit = (std::uint64_t{1} << Bound) - 1;
+            while (Bucket < TASK_METRICS_BUCKETS && LatencyHistogram::u64BucketTop(Bucket) <= Limit)
+            {
+                Seen += Histogram.u64GetBucket(Bucket++);
+            }
+            std::snprintf(Number, sizeof(Number), "%.6g", static_cast<double>(std::uint64_t{1} << Bound) / 1e9);
+            Out << "taskmanager_operation_duration_seconds_bucket{op=\"" << Name << "\",le=\"" << Number << "\"} "
+                << Seen << '\n';
+        }
+        std::snprintf(Number, sizeof(Number), "%.9f", static_cast<double>(Histogram.u64GetSum()) / 1e9);
+        Out << "taskmanager_operation_duration_seconds_bucket{op=\"" << Name << "\",le=\"+Inf\"} " << Count << '\n'
+            << "taskmanager_operation_duration_seconds_sum{op=\"" << Name << "\"} " << Number << '\n'
+            << "taskmanager_operation_duration_seconds_count{op=\"" << Name << "\"} " << Count << '\n';
+    }
+    Out << "# HELP taskmanager_bytes_read_total Bytes read from task files and journals.\n"
+        << "# TYPE taskmanager_bytes_read_total counter\n"
+        << "taskmanager_bytes_read_total " << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::BytesRead)] << '\n'
+        << "# HELP taskmanager_bytes_written_total Bytes written to task files and journals.\n"
+        << "# TYPE taskmanager_bytes_written_total counter\n"
+        << "taskmanager_bytes_written_total " << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::BytesWritten)] << '\n'
+        << "# HELP taskmanager_allocations_total Heap allocations made by the process.\n"
+        << "# TYPE taskmanager_allocations_total counter\n"
+        << "taskmanager_allocations_total " << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::Allocations)] << '\n'
+        << "# HELP taskmanager_body_faults_total Task bodies read from disk by lazy loading.\n"
+        << "# TYPE taskmanager_body_faults_total counter\n"
+        << "taskmanager_body_faults_total " << Snapshot->Counters[static_cast<std::size_t>(MetricCounter::BodyFaults)] << '\n';
+}
+
+#else
+
+/**
+ * @brief Writes a note that metrics are compiled out.
+ *
+ * @param Out Stream to write to.
+ */
+void vidWriteMetricsSummary(std::ostream &Out)
+{
+    Out << "# Metrics Are Disabled In This Build\n";
+}
+
+/**
+ * @brief Writes a note that metrics are compiled out.
+ *
+ * @param Out Stream to write to.
+ */
+void vidWritePrometheusMetrics(std::ostream &Out)
+{
+    Out << "# Metrics are disabled in this build.\n";
+}
+
+#endif // TASKMANAGER_METRICS
+
+/**
+ * @brief Writes the Prometheus metrics to a file, replacing it atomically.
+ *
+ * The metrics are written to "<filename>.tmp" and renamed over the target,
+ * so a scraper never reads a half-written file.
+ *
+ * @param filename Name of the file to write.
+ * @return true on success, false if the file could not be written.
+ */
+bool bDumpMetricsToFile(const std::string &filename)
+{
+    std::string TempFile = filename + ".tmp";
+    {
+        std::ofstream Out(TempFile, std::ios::trunc);
+        if (!Out)
+        {
+            return false;
+        }
+        vidWritePrometheusMetrics(Out);
+        if (!Out.flush())
+        {
+            return false;
+        }
+    }
+    std::error_code Error;
+    std::filesystem::rename(TempFile, filename, Error);
+    return !Error;
+}
+
+/**
+ * @brief Starts dumping.
+ *
+ * @param filename File to write the metrics to.
+ * @param Period Time between two dumps.
+ */
+MetricsDumper::MetricsDumper(const std::string &filename, std::chrono::milliseconds Period)
+    : Path(filename), Interval(Period), Worker(&MetricsDumper::vidRun, this)
+{
+}
+
+/**
+ * @brief Writes the file every Interval until stopped.
+ */
+void MetricsDumper::vidRun(void)
+{
+    std::unique_lock<std::mutex> Guard(Lock);
+    while (Wake.wait_for(Guard, Interval, [this]() { return Stopping; }) == false)
+    {
+        Guard.unlock();
+        if (bDumpMetricsToFile(Path) == false)
+        {
+            std::cerr << "Error While Writing The Metrics File" << std::endl;
+        }
+        Guard.lock();
+    }
+}
+
+/**
+ * @brief Stops the thread and writes the file a last time.
+ */
+MetricsDumper::~MetricsDumper()
+{
+    {
+        std::lock_guard<std::mutex> Guard(Lock);
+        Stopping = true;
+    }
+    Wake.notify_one();
+    Worker.join();
+    if (bDumpMetricsToFile(Path) == false)
+    {
+        std::cerr << "Error While Writing The Metrics File" << std::endl;
+    }
+}
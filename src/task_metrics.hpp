@@ -0,0 +1,332 @@
+/**
+ * @file task_metrics.hpp
+ * @brief Declaration of the operation counters and latency histograms of the task manager.
+ *
+ * Every add, delete, update, status change, load and save is counted, and
+ * timed into a histogram of its own. Bytes read from and written to task
+ * files and journals, and heap allocations, are counted too. The figures can be printed
+ * as a summary ("stats" batch command) or written in the Prometheus text
+ * format, once or periodically, for a scraper such as the node exporter's
+ * textfile collector.
+ *
+ * Heap allocations are counted by a replacement of the global operator new
+ * that lives apart, in task_alloc_counter.cpp: only the programs that link it
+ * in, such as the command-line application, count them, and libraries and
+ * benchmarks built on the task manager keep the standard allocator.
+ *
+ * Histograms are log-linear, as in HdrHistogram: each power of two is split
+ * into TASK_METRICS_SUB_BUCKETS equal buckets, so any latency from 1 ns to
+ * hours is kept within 12.5% using a fixed, small array of counters.
+ *
+ * Reading the clock stops the processor from overlapping the cache misses of
+ * consecutive operations, which costs far more than the read itself, so only
+ * one in TASK_METRICS_SAMPLE_PERIOD adds, deletes, updates and status changes
+ * is timed; loads and saves are always timed. Each thread records into a
+ * block of its own with plain stores, and readers add the blocks up, so the
+ * hot path never executes a locked instruction.
+ *
+ * Building with TASKMANAGER_METRICS set to 0 turns every hook into nothing,
+ * so the instrumentation then costs no time at all; the reporting functions
+ * remain and only say that metrics are disabled.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__METRICS__
+#define __TASK__METRICS__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#ifndef TASKMANAGER_METRICS
+#define TASKMANAGER_METRICS 1
+#endif
+
+/**
+ * @brief Operations whose latency is recorded.
+ */
+enum class MetricOp : std::uint8_t
+{
+    Add,        /**< addTask(). */
+    Delete,     /**< removeTask(). */
+    Update,     /**< Changing a title, description, due date or priority. */
+    Status,     /**< setStatus(). */
+    Load,       /**< LoadTasksFrom(). */
+    Save,       /**< SaveTasksToFile(). */
+    Count       /**< Number of operations, not an operation. */
+};
+
+/**
+ * @brief Quantities that are counted.
+ */
+enum class MetricCounter : std::uint8_t
+{
+    BytesRead,      /**< Bytes read from task files and journals. */
+    BytesWritten,   /**< Bytes written to task files and journals. */
+    Allocations,    /**< Calls to the global operator new, in programs linking task_alloc_counter.cpp. */
+    BodyFaults,     /**< Task bodies read from disk by lazy loading. */
+    Count           /**< Number of counters, not a counter. */
+};
+
+/**
+ * @brief Number of buckets each power of two is split into; 8 keeps every value within 12.5%.
+ */
+static constexpr unsigned TASK_METRICS_SUB_BUCKETS = 8;
+
+/**
+ * @brief Number of buckets of a histogram, enough for any 64-bit value.
+ */
+static constexpr unsigned TASK_METRICS_BUCKETS = (64 - 2) * TASK_METRICS_SUB_BUCKETS;
+
+/**
+ * @brief One add, delete, update or status change in this many is timed.
+ */
+static constexpr std::uint32_t TASK_METRICS_SAMPLE_PERIOD = 64;
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of latencies in nanoseconds.
+ *
+ * Only one thread may record into a histogram, but any thread may read it or
+ * add it to another histogram it owns.
+ */
+class LatencyHistogram
+{
+private:
+    std::atomic<std::uint64_t> Buckets[TASK_METRICS_BUCKETS] = {};   /**< Number of values per bucket. */
+    std::atomic<std::uint64_t> Total{0};                            /**< Number of values. */
+    std::atomic<std::uint64_t> Sum{0};                              /**< Sum of the values. */
+    std::atomic<std::uint64_t> Max{0};                              /**< Largest value. */
+
+public:
+    /**
+     * @brief Gets the bucket holding a value.
+     *
+     * @param Value Value to place.
+     * @return Index of its bucket.
+     */
+    static unsigned u32BucketOf(std::uint64_t Value);
+
+    /**
+     * @brief Gets the largest value a bucket holds.
+     *
+     * @param Bucket Index of the bucket.
+     * @return Inclusive upper bound of the bucket.
+     */
+    static std::uint64_t u64BucketTop(unsigned Bucket);
+
+    /**
+     * @brief Records one value.
+     *
+     * @param Value Latency in nanoseconds.
+     */
+    void vidRecord(std::uint64_t Value);
+
+    /**
+     * @brief Adds every value of another histogram to this one.
+     *
+     * @param Other Histogram to add.
+     */
+    void vidAdd(const LatencyHistogram &Other);
+
+    /**
+     * @brief Gets the number of values in a bucket.
+     *
+     * @param Bucket Index of the bucket.
+     * @return Number of values.
+     */
+    std::uint64_t u64GetBucket(unsigned Bucket) const;
+
+    /**
+     * @brief Gets the number of recorded values.
+     *
+     * @return Number of values.
+     */
+    std::uint64_t u64GetCount(void) const;
+
+    /**
+     * @brief Gets the sum of the recorded values.
+     *
+     * @return Sum in nanoseconds.
+     */
+    std::uint64_t u64GetSum(void) const;
+
+    /**
+     * @brief Gets the largest recorded value.
+     *
+     * @return Largest value in nanoseconds, or 0 if none was recorded.
+     */
+    std::uint64_t u64GetMax(void) const;
+
+    /**
+     * @brief Gets a percentile of the recorded values.
+     *
+     * @param Percentile Percentile to get, from 0 to 100.
+     * @return Upper bound of the bucket holding it, capped by the largest value, or 0 if none was recorded.
+     */
+    std::uint64_t u64GetPercentile(double Percentile) const;
+};
+
+/**
+ * @brief Gets the name of an operation, as used in metric labels.
+ *
+ * @param Op Operation.
+ * @return Lowercase name, such as "add".
+ */
+const char *GetMetricOpName(MetricOp Op);
+
+#if TASKMANAGER_METRICS
+
+/**
+ * @brief Counts one call of an operation and tells whether to time it.
+ *
+ * @param Op Operation.
+ * @return true if this call is one of the sampled ones.
+ */
+bool bCountOperation(MetricOp Op);
+
+/**
+ * @brief Records the latency of one sampled operation.
+ *
+ * @param Op Operation.
+ * @param Nanos Latency in nanoseconds.
+ */
+void vidRecordLatency(MetricOp Op, std::uint64_t Nanos);
+
+/**
+ * @brief Adds to a counter.
+ *
+ * @param Counter Counter to increase.
+ * @param Value Amount to add.
+ */
+void vidAddToCounter(MetricCounter Counter, std::uint64_t Value);
+
+/**
+ * @class MetricTimer
+ * @brief Counts the scope it lives in as one operation, and times it if the call is sampled.
+ */
+class MetricTimer
+{
+private:
+    MetricOp Op;                                        /**< Operation being timed. */
+    bool Sampled;                                       /**< true if this call is timed. */
+    std::chrono::steady_clock::time_point Start;        /**< Time the scope was entered, if sampled. */
+
+public:
+    /**
+     * @brief Counts the operation and starts timing it if sampled.
+     *
+     * @param Operation Operation being timed.
+     */
+    explicit MetricTimer(MetricOp Operation) : Op(Operation), Sampled(bCountOperation(Operation))
+    {
+        if (Sampled == true)
+        {
+            Start = std::chrono::steady_clock::now();
+        }
+    }
+
+    MetricTimer(const MetricTimer &) = delete;
+    MetricTimer &operator=(const MetricTimer &) = delete;
+
+    /**
+     * @brief Records the time spent since construction, if sampled.
+     */
+    ~MetricTimer()
+    {
+        if (Sampled == false)
+        {
+            return;
+        }
+        auto Elapsed = std::chrono::steady_clock::now() - Start;
+        vidRecordLatency(Op, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed).count()));
+    }
+};
+
+/**
+ * @brief Counts the enclosing scope as one operation of the given kind, and times the rest of it if sampled.
+ */
+#define TASK_METRIC_TIMER(Op) MetricTimer TaskMetricTimer(Op)
+
+/**
+ * @brief Adds a value to a counter.
+ */
+#define TASK_METRIC_COUNT(Counter, Value) vidAddToCounter((Counter), static_cast<std::uint64_t>(Value))
+
+#else
+
+#define TASK_METRIC_TIMER(Op) ((void)0)
+#define TASK_METRIC_COUNT(Counter, Value) ((void)0)
+
+#endif // TASKMANAGER_METRICS
+
+/**
+ * @brief Writes a human-readable summary of every operation and counter.
+ *
+ * @param Out Stream to write to.
+ */
+void vidWriteMetricsSummary(std::ostream &Out);
+
+/**
+ * @brief Writes every operation and counter in the Prometheus text exposition format.
+ *
+ * @param Out Stream to write to.
+ */
+void vidWritePrometheusMetrics(std::ostream &Out);
+
+/**
+ * @brief Writes the Prometheus metrics to a file, replacing it atomically.
+ *
+ * @param filename Name of the file to write.
+ * @return true on success, false if the file could not be written.
+ */
+bool bDumpMetricsToFile(const std::string &filename);
+
+/**
+ * @class MetricsDumper
+ * @brief Background thread writing the Prometheus metrics to a file at a fixed interval.
+ *
+ * The file is written one last time when the dumper is destroyed, so it
+ * always ends with the figures of the whole session.
+ */
+class MetricsDumper
+{
+private:
+    std::string Path;                   /**< File the metrics are written to. */
+    std::chrono::milliseconds Interval; /**< Time between two dumps. */
+    std::mutex Lock;                    /**< Guards Stopping. */
+    std::condition_variable Wake;       /**< Signalled to stop the thread early. */
+    bool Stopping = false;              /**< true once the dumper is being destroyed. */
+    std::thread Worker;                 /**< Thread writing the file, started last. */
+
+    /**
+     * @brief Writes the file every Interval until stopped.
+     */
+    void vidRun(void);
+
+public:
+    /**
+     * @brief Starts dumping.
+     *
+     * @param filename File to write the metrics to.
+     * @param Period Time between two dumps.
+     */
+    MetricsDumper(const std::string &filename, std::chrono::milliseconds Period);
+
+    MetricsDumper(const MetricsDumper &) = delete;
+    MetricsDumper &operator=(const MetricsDumper &) = delete;
+
+    /**
+     * @brief Stops the thread and writes the file a last time.
+     */
+    ~MetricsDumper();
+};
+
+#endif // __TASK__METRICS__
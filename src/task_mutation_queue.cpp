@@ -0,0 +1,390 @@
+/**
+ * @file task_mutation_queue.cpp
+ * @brief Implementation of the TaskMutationQueue class.
+ *
+ * The pending list is a lock-free stack: producers link a record in front of
+ * the current head with a compare-and-swap, and the apply thread detaches the
+ * whole stack with one exchange and reverses it to get submission order back.
+ * Each record is touched by exactly one producer before the push and by the
+ * apply thread after the exchange, so records need no further synchronization.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_mutation_queue.hpp"
+
+/**
+ * @brief Creates the record of a task addition.
+ *
+ * @param title Title of the task.
+ * @param desc Description of the task.
+ * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+ * @param Priority Priority level of the task.
+ * @return New record, owned by the caller.
+ */
+TaskMutationQueue::MutationRecord *TaskMutationQueue::pMakeAdd(std::string_view title, std::string_view desc,
+                                                               std::int32_t DueDay, TaskPriority Priority)
+{
+    MutationRecord *Record = new MutationRecord;
+    Record->Kind = MutationKind::Add;
+    Record->Title.assign(title);
+    Record->Description.assign(desc);
+    Record->DueDay = DueDay;
+    Record->Priority = Priority;
+    return Record;
+}
+
+/**
+ * @brief Creates the record of a status change.
+ *
+ * @param id ID of the task to update.
+ * @param state New status.
+ * @return New record, owned by the caller.
+ */
+TaskMutationQueue::MutationRecord *TaskMutationQueue::pMakeStatus(int id, TaskState state)
+{
+    MutationRecord *Record = new MutationRecord;
+    Record->Kind = MutationKind::SetStatus;
+    Record->id = id;
+    Record->State = state;
+    return Record;
+}
+
+/**
+ * @brief Creates the record of a task removal.
+ *
+ * @param id ID of the task to remove.
+ * @return New record, owned by the caller.
+ */
+TaskMutationQueue::MutationRecord *TaskMutationQueue::pMakeRemove(int id)
+{
+    MutationRecord *Record = new MutationRecord;
+    Record->Kind = MutationKind::Remove;
+    Record->id = id;
+    return Record;
+}
+
+/**
+ * @brief Starts the apply thread in front of a task manager.
+ *
+ * @param manager Task manager the mutations are applied to.
+ */
+TaskMutationQueue::TaskMutationQueue(TaskManager &manager) : Manager(manager)
+{
+    ApplyThread = std::thread(&TaskMutationQueue::vidRun, this);
+}
+
+/**
+ * @brief Pushes a record onto the pending list and wakes the apply thread if it sleeps.
+ *
+ * The sleeping flag is read after the push, and the apply thread sets it
+ * before its last look at the list, so either the apply thread sees the
+ * record or this thread sees the flag and wakes it.
+ *
+ * The producer count is raised before the stop flag is checked and lowered
+ * after the push, and vidStop() sets the flag before it waits for the count
+ * to drop to zero, so a record that passed the check is always in the list
+ * by the time vidStop() takes it for the last time.
+ *
+ * @param Record Record to push; the queue takes ownership of it.
+ * @return true if the record was queued, false if the queue is stopping and the record was dropped.
+ */
+bool TaskMutationQueue::bPush(MutationRecord *Record)
+{
+    Producers.fetch_add(1);
+    if (Stopping.load() == true)
+    {
+        Producers.fetch_sub(1);
+        delete Record;
+        return false;
+    }
+    Record->Next = Pending.load(std::memory_order_relaxed);
+    while (Pending.compare_exchange_weak(Record->Next, Record) == false)
+    {
+    }
+    if (Sleeping.load() == true)
+    {
+        std::lock_guard<std::mutex> Guard(WakeLock);
+        WakeSignal.notify_one();
+    }
+    Producers.fetch_sub(1);
+    return true;
+}
+
+/**
+ * @brief Pushes a record whose result is handed back through a future.
+ *
+ * @param Record Record to push; the queue takes ownership of it.
+ * @return Future receiving the result of the record.
+ */
+std::future<int> TaskMutationQueue::SubmitWithFuture(MutationRecord *Record)
+{
+    std::future<int> Result = Record->Result.emplace().get_future();
+    bPush(Record);
+    return Result;
+}
+
+/**
+ * @brief Pushes a record whose result is handed back through a callback.
+ *
+ * @param Record Record to push; the queue takes ownership of it.
+ * @param Callback Callback receiving the result of the record.
+ * @return true if the record was queued, false if the queue is stopping.
+ */
+bool TaskMutationQueue::bSubmitWithCallback(MutationRecord *Record, MutationCallback Callback)
+{
+    Record->Callback = std::move(Callback);
+    return bPush(Record);
+}
+
+/**
+ * @brief Submits the addition of a new task.
+ *
+ * @param title Title of the task.
+ * @param desc Description of the task.
+ * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+ * @param Priority Priority level of the task.
+ * @return Future receiving the ID of the new task.
+ */
+std::future<int> TaskMutationQueue::SubmitAdd(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority)
+{
+    return SubmitWithFuture(pMakeAdd(title, desc, DueDay, Priority));
+}
+
+/**
+ * @brief Submits a status change.
+ *
+ * @param id ID of the task to update.
+ * @param state New status.
+ * @return Future receiving 1 if the task existed and was updated, 0 otherwise.
+ */
+std::future<int> TaskMutationQueue::SubmitStatus(int id, TaskState state)
+{
+    return SubmitWithFuture(pMakeStatus(id, state));
+}
+
+/**
+ * @brief Submits the removal of a task.
+ *
+ * @param id ID of the task to remove.
+ * @return Future receiving 1 if the task existed and was removed, 0 otherwise.
+ */
+std::future<int> TaskMutationQueue::SubmitRemove(int id)
+{
+    return SubmitWithFuture(pMakeRemove(id));
+}
+
+/**
+ * @brief Submits the addition of a new task, handing the new ID to a callback.
+ *
+ * @param title Title of the task.
+ * @param desc Description of the task.
+ * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+ * @param Priority Priority level of the task.
+ * @param Callback Callback receiving the ID of the new task, or empty to ignore it.
+ * @return true if the mutation was queued, false if the queue is stopping.
+ */
+bool TaskMutationQueue::bSubmitAdd(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority,
+                                   MutationCallback Callback)
+{
+    return bSubmitWithCallback(pMakeAdd(title, desc, DueDay, Priority), std::move(Callback));
+}
+
+/**
+ * @brief Submits a status change, handing the result to a callback.
+ *
+ * @param id ID of the task to update.
+ * @param state New status.
+ * @param Callback Callback receiving 1 if the task was updated and 0 otherwise, or empty to ignore it.
+ * @return true if the mutation was queued, false if the queue is stopping.
+ */
+bool TaskMutationQueue::bSubmitStatus(int id, TaskState state, MutationCallback Callback)
+{
+    return bSubmitWithCallback(pMakeStatus(id, state), std::move(Callback));
+}
+
+/**
+ * @brief Submits the removal of a task, handing the result to a callback.
+ *
+ * @param id ID of the task to remove.
+ * @param Callback Callback receiving 1 if the task was removed and 0 otherwise, or empty to ignore it.
+ * @return true if the mutation was queued, false if the queue is stopping.
+ */
+bool TaskMutationQueue::bSubmitRemove(int id, MutationCallback Callback)
+{
+    return bSubmitWithCallback(pMakeRemove(id), std::move(Callback));
+}
+
+/**
+ * @brief Applies and commits a list of records, then fulfils and frees them.
+ *
+ * Results are handed back only after the commit, so a producer never sees
+ * the result of a mutation that could still be lost. A record that throws
+ * fails on its own, and a commit that throws fails every record of the
+ * batch; the exception is handed to their futures.
+ *
+ * @param Newest Most recently submitted record of the list.
+ */
+void TaskMutationQueue::vidApplyBatch(MutationRecord *Newest)
+{
+    MutationRecord *Oldest = nullptr;
+    while (Newest != nullptr)
+    {
+        MutationRecord *Next = Newest->Next;
+        Newest->Next = Oldest;
+        Oldest = Newest;
+        Newest = Next;
+    }
+
+    std::size_t Applied = 0;
+    for (MutationRecord *Record = Oldest; Record != nullptr; Record = Record->Next)
+    {
+        try
+        {
+            switch (Record->Kind)
+            {
+            case MutationKind::Add:
+                Record->id = Manager.addTask(std::string_view(Record->Title), std::string_view(Record->Description),
+                                             Record->DueDay, Record->Priority);
+                break;
+            case MutationKind::SetStatus:
+                Record->id = (Manager.setStatus(Record->id, Record->State) == true) ? 1 : 0;
+                break;
+            case MutationKind::Remove:
+                Record->id = (Manager.removeTask(Record->id) == true) ? 1 : 0;
+                break;
+            }
+        }
+        catch (...)
+        {
+            Record->Error = std::current_exception();
+        }
+        ++Applied;
+    }
+    std::exception_ptr CommitError;
+    try
+    {
+        Manager.Commit();
+    }
+    catch (...)
+    {
+        CommitError = std::current_exception();
+    }
+    AppliedCount.fetch_add(Applied, std::memory_order_relaxed);
+    BatchCount.fetch_add(1, std::memory_order_relaxed);
+
+    while (Oldest != nullptr)
+    {
+        MutationRecord *Next = Oldest->Next;
+        std::exception_ptr Error = (Oldest->Error != nullptr) ? Oldest->Error : CommitError;
+        if (Oldest->Result.has_value() == true)
+        {
+            if (Error != nullptr)
+            {
+                Oldest->Result->set_exception(Error);
+            }
+            else
+            {
+                Oldest->Result->set_value(Oldest->id);
+            }
+        }
+        else if (Oldest->Callback)
+        {
+            Oldest->Callback((Error != nullptr) ? TASK_MUTATION_FAILED : Oldest->id);
+        }
+        delete Oldest;
+        Oldest = Next;
+    }
+}
+
+/**
+ * @brief Body of the apply thread.
+ *
+ * Takes every pending record at once, so the batch size grows with the
+ * submission rate and the cost of each commit is shared by more mutations
+ * the busier the queue is.
+ */
+void TaskMutationQueue::vidRun(void)
+{
+    Manager.BeginBatch();
+    while (true)
+    {
+        MutationRecord *Batch = Pending.exchange(nullptr);
+        if (Batch != nullptr)
+        {
+            vidApplyBatch(Batch);
+            continue;
+        }
+        if (Stopping.load() == true)
+        {
+            break;
+        }
+        std::unique_lock<std::mutex> Guard(WakeLock);
+        Sleeping.store(true);
+        WakeSignal.wait(Guard, [this]()
+        {
+            return Pending.load() != nullptr || Stopping.load() == true;
+        });
+        Sleeping.store(false);
+    }
+    Manager.EndBatch();
+}
+
+/**
+ * @brief Gets the number of records applied so far.
+ *
+ * @return Number of applied records.
+ */
+std::size_t TaskMutationQueue::u64GetAppliedCount(void) const
+{
+    return AppliedCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the number of batches committed so far.
+ *
+ * @return Number of committed batches.
+ */
+std::size_t TaskMutationQueue::u64GetBatchCount(void) const
+{
+    return BatchCount.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Applies every record submitted so far and stops the apply thread.
+ *
+ * Producers that passed the stop check before the flag was set are waited
+ * for, so their records are in the list when it is taken for the last time.
+ */
+void TaskMutationQueue::vidStop(void)
+{
+    if (ApplyThread.joinable() == false)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> Guard(WakeLock);
+        Stopping.store(true);
+    }
+    WakeSignal.notify_one();
+    ApplyThread.join();
+
+    while (Producers.load() != 0)
+    {
+        std::this_thread::yield();
+    }
+    MutationRecord *Late = Pending.exchange(nullptr);
+    if (Late != nullptr)
+    {
+        vidApplyBatch(Late);
+    }
+}
+
+/**
+ * @brief Stops the queue, applying every pending record first.
+ */
+TaskMutationQueue::~TaskMutationQueue()
+{
+    vidStop();
+}
@@ -0,0 +1,268 @@
+/**
+ * @file task_mutation_queue.hpp
+ * @brief Declaration of the TaskMutationQueue class, a lock-free submission queue in front of a TaskManager.
+ *
+ * Producer threads push mutation records (add, status change, delete) onto a
+ * lock-free multi-producer list and get either a future for the result or a
+ * callback run with it. A single apply thread owns the TaskManager: it takes
+ * every pending record in one atomic exchange, applies them in submission
+ * order as one journal batch, commits, and only then hands the results back,
+ * so a result means the mutation is as durable as the journal makes it.
+ *
+ * Producers never take a lock to submit. The only lock is the one the apply
+ * thread sleeps on when the queue is empty, and producers touch it only to
+ * wake that thread up.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__MUTATION__QUEUE__
+#define __TASK__MUTATION__QUEUE__
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "task_manager.hpp"
+
+/**
+ * @brief Callback receiving the result of a mutation on the apply thread.
+ */
+using MutationCallback = std::function<void(int)>;
+
+/**
+ * @brief Result handed to the callback of a mutation that failed with an exception.
+ */
+constexpr int TASK_MUTATION_FAILED = -1;
+
+/**
+ * @enum MutationKind
+ * @brief Kind of change carried by a mutation record.
+ */
+enum class MutationKind : std::uint8_t
+{
+    Add,        /**< Add a new task. */
+    SetStatus,  /**< Set the status of a task. */
+    Remove      /**< Remove a task. */
+};
+
+/**
+ * @class TaskMutationQueue
+ * @brief Applies mutations submitted from many threads to one TaskManager on a single apply thread.
+ *
+ * While the queue is running, the apply thread is the only one allowed to
+ * touch the TaskManager; other threads must go through the queue.
+ */
+class TaskMutationQueue
+{
+private:
+    /**
+     * @struct MutationRecord
+     * @brief One submitted mutation, linked into the pending list.
+     */
+    struct MutationRecord
+    {
+        MutationRecord *Next = nullptr;     /**< Record submitted just before this one. */
+        MutationKind Kind;                  /**< Kind of change. */
+        int id = 0;                         /**< Task to change, unused for additions. */
+        TaskState State = TaskState::Pending;   /**< New status, for status changes. */
+        std::int32_t DueDay = TASK_NO_DUE_DATE; /**< Due date, for additions. */
+        TaskPriority Priority = TaskPriority::Unknown; /**< Priority, for additions. */
+        std::string Title;                  /**< Title, for additions. */
+        std::string Description;            /**< Description, for additions. */
+        std::optional<std::promise<int>> Result;    /**< Fulfilled once the record is committed, for future submissions. */
+        MutationCallback Callback;          /**< Called once the record is committed, for callback submissions. */
+        std::exception_ptr Error;           /**< Exception thrown while applying the record, if any. */
+    };
+
+    TaskManager &Manager;                       /**< Task manager owned by the apply thread. */
+    std::atomic<MutationRecord *> Pending{nullptr};  /**< Submitted records, newest first. */
+    std::atomic<bool> Sleeping{false};          /**< true while the apply thread waits for records. */
+    std::atomic<bool> Stopping{false};          /**< true once vidStop() was called. */
+    std::atomic<std::size_t> Producers{0};      /**< Submissions between their stop check and the end of their push. */
+    std::mutex WakeLock;                        /**< Guards the apply thread's sleep. */
+    std::condition_variable WakeSignal;         /**< Wakes the apply thread up. */
+    std::atomic<std::size_t> AppliedCount{0};   /**< Records applied so far. */
+    std::atomic<std::size_t> BatchCount{0};     /**< Batches committed so far. */
+    std::thread ApplyThread;                    /**< Thread applying the records. */
+
+    /**
+     * @brief Creates the record of a task addition.
+     *
+     * @param title Title of the task.
+     * @param desc Description of the task.
+     * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+     * @param Priority Priority level of the task.
+     * @return New record, owned by the caller.
+     */
+    static MutationRecord *pMakeAdd(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority);
+
+    /**
+     * @brief Creates the record of a status change.
+     *
+     * @param id ID of the task to update.
+     * @param state New status.
+     * @return New record, owned by the caller.
+     */
+    static MutationRecord *pMakeStatus(int id, TaskState state);
+
+    /**
+     * @brief Creates the record of a task removal.
+     *
+     * @param id ID of the task to remove.
+     * @return New record, owned by the caller.
+     */
+    static MutationRecord *pMakeRemove(int id);
+
+    /**
+     * @brief Pushes a record onto the pending list and wakes the apply thread if it sleeps.
+     *
+     * @param Record Record to push; the queue takes ownership of it.
+     * @return true if the record was queued, false if the queue is stopping and the record was dropped.
+     */
+    bool bPush(MutationRecord *Record);
+
+    /**
+     * @brief Pushes a record whose result is handed back through a future.
+     *
+     * @param Record Record to push; the queue takes ownership of it.
+     * @return Future receiving the result of the record.
+     */
+    std::future<int> SubmitWithFuture(MutationRecord *Record);
+
+    /**
+     * @brief Pushes a record whose result is handed back through a callback.
+     *
+     * @param Record Record to push; the queue takes ownership of it.
+     * @param Callback Callback receiving the result of the record.
+     * @return true if the record was queued, false if the queue is stopping.
+     */
+    bool bSubmitWithCallback(MutationRecord *Record, MutationCallback Callback);
+
+    /**
+     * @brief Applies and commits a list of records, then fulfils and frees them.
+     *
+     * A record that throws fails on its own, and a commit that throws fails
+     * every record of the batch; the exception is handed to their futures.
+     *
+     * @param Newest Most recently submitted record of the list.
+     */
+    void vidApplyBatch(MutationRecord *Newest);
+
+    /**
+     * @brief Body of the apply thread.
+     */
+    void vidRun(void);
+
+public:
+    /**
+     * @brief Starts the apply thread in front of a task manager.
+     *
+     * @param manager Task manager the mutations are applied to.
+     */
+    explicit TaskMutationQueue(TaskManager &manager);
+
+    TaskMutationQueue(const TaskMutationQueue &) = delete;
+    TaskMutationQueue &operator=(const TaskMutationQueue &) = delete;
+
+    /**
+     * @brief Submits the addition of a new task.
+     *
+     * @param title Title of the task.
+     * @param desc Description of the task.
+     * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+     * @param Priority Priority level of the task.
+     * @return Future receiving the ID of the new task.
+     */
+    std::future<int> SubmitAdd(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority);
+
+    /**
+     * @brief Submits a status change.
+     *
+     * @param id ID of the task to update.
+     * @param state New status.
+     * @return Future receiving 1 if the task existed and was updated, 0 otherwise.
+     */
+    std::future<int> SubmitStatus(int id, TaskState state);
+
+    /**
+     * @brief Submits the removal of a task.
+     *
+     * @param id ID of the task to remove.
+     * @return Future receiving 1 if the task existed and was removed, 0 otherwise.
+     */
+    std::future<int> SubmitRemove(int id);
+
+    /**
+     * @brief Submits the addition of a new task, handing the new ID to a callback.
+     *
+     * Callbacks run on the apply thread, after the commit, and must be quick:
+     * the next batch waits for them. A mutation that fails with an exception
+     * hands TASK_MUTATION_FAILED to its callback, and its future rethrows it.
+     *
+     * @param title Title of the task.
+     * @param desc Description of the task.
+     * @param DueDay Due date of the task as a day number, or TASK_NO_DUE_DATE.
+     * @param Priority Priority level of the task.
+     * @param Callback Callback receiving the ID of the new task, or empty to ignore it.
+     * @return true if the mutation was queued, false if the queue is stopping.
+     */
+    bool bSubmitAdd(std::string_view title, std::string_view desc, std::int32_t DueDay, TaskPriority Priority,
+                    MutationCallback Callback = MutationCallback());
+
+    /**
+     * @brief Submits a status change, handing the result to a callback.
+     *
+     * @param id ID of the task to update.
+     * @param state New status.
+     * @param Callback Callback receiving 1 if the task was updated and 0 otherwise, or empty to ignore it.
+     * @return true if the mutation was queued, false if the queue is stopping.
+     */
+    bool bSubmitStatus(int id, TaskState state, MutationCallback Callback = MutationCallback());
+
+    /**
+     * @brief Submits the removal of a task, handing the result to a callback.
+     *
+     * @param id ID of the task to remove.
+     * @param Callback Callback receiving 1 if the task was removed and 0 otherwise, or empty to ignore it.
+     * @return true if the mutation was queued, false if the queue is stopping.
+     */
+    bool bSubmitRemove(int id, MutationCallback Callback = MutationCallback());
+
+    /**
+     * @brief Gets the number of records applied so far.
+     *
+     * @return Number of applied records.
+     */
+    std::size_t u64GetAppliedCount(void) const;
+
+    /**
+     * @brief Gets the number of batches committed so far.
+     *
+     * @return Number of committed batches.
+     */
+    std::size_t u64GetBatchCount(void) const;
+
+    /**
+     * @brief Applies every record submitted so far and stops the apply thread.
+     *
+     * Records submitted afterwards are dropped: their futures fail with a
+     * std::future_error and callback submissions return false. A submission
+     * racing with the stop is either applied or dropped, never lost.
+     */
+    void vidStop(void);
+
+    /**
+     * @brief Stops the queue, applying every pending record first.
+     */
+    ~TaskMutationQueue();
+};
+
+#endif // __TASK__MUTATION__QUEUE__
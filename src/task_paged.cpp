@@ -0,0 +1,873 @@
+/**
+ * @file task_paged.cpp
+ * @brief Implementation of the paged task file format.
+ *
+ * A full write packs the records into pages and streams them to a temporary
+ * file in large chunks, like the binary format. A patch reads the few pages
+ * holding changed tasks, edits their records in memory and writes them back,
+ * first to the doublewrite file and then in place.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_paged.hpp"
+#include "task_binary.hpp"
+#include "task_journal.hpp"
+#include "task_metrics.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <utility>
+
+/**
+ * @brief Magic bytes identifying a paged task file.
+ */
+static const char TASK_PAGED_MAGIC[8] = {'T', 'A', 'S', 'K', 'P', 'A', 'G', '\0'};
+
+/**
+ * @brief Magic bytes identifying a doublewrite file.
+ */
+static const char TASK_DOUBLEWRITE_MAGIC[8] = {'T', 'A', 'S', 'K', 'D', 'W', 'B', '\0'};
+
+/**
+ * @brief Extent length recorded for the file header and for every page of an extent but its first.
+ */
+static constexpr std::uint32_t TASK_PAGE_CONTINUED = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Largest record that fits in a single page.
+ */
+static constexpr std::size_t TASK_PAGE_PAYLOAD = TASK_PAGE_SIZE - TASK_PAGE_HEADER_SIZE;
+
+/**
+ * @brief Payload bytes a page is filled to by a full write, leaving room for records to grow.
+ */
+static constexpr std::size_t TASK_PAGE_FILL = TASK_PAGE_SIZE * 7 / 8 - TASK_PAGE_HEADER_SIZE;
+
+/**
+ * @brief Number of bytes of the file header page in use, checksum included.
+ */
+static constexpr std::size_t TASK_PAGED_HEADER_FIELDS = 40;
+
+/**
+ * @brief Size after which the pages of a full write are flushed to disk.
+ */
+static constexpr std::size_t TASK_PAGED_FLUSH_SIZE = 1 << 20;
+
+/**
+ * @brief IDs up to twice the task count plus this many are mapped to their page through a flat array.
+ */
+static constexpr std::size_t TASK_PAGED_DENSE_SLACK = 1 << 16;
+
+/**
+ * @brief Fields of the header at the start of an extent.
+ */
+struct TaskExtentHeader
+{
+    std::uint32_t Span = 0;     /**< Number of pages of the extent, or 0 for a free page. */
+    std::uint32_t Count = 0;    /**< Number of records in the extent. */
+    std::uint32_t Used = 0;     /**< Number of payload bytes in use. */
+};
+
+/**
+ * @brief Records of one extent, decoded for editing.
+ */
+struct TaskPageImage
+{
+    std::uint32_t Span = 1;                                 /**< Number of pages of the extent. */
+    std::vector<std::pair<int, std::string>> Records;       /**< ID and encoded record of every task in the extent. */
+    std::size_t Used = 0;                                   /**< Total size of the records. */
+};
+
+/**
+ * @brief Builds the file header page.
+ *
+ * @param PageCount Number of pages in the file, header included.
+ * @param NextId Next task ID to record.
+ * @param TaskCount Number of tasks in the file.
+ * @return Image of the header page.
+ */
+static std::string EncodeFileHeader(std::size_t PageCount, int NextId, std::uint64_t TaskCount)
+{
+    std::string Page;
+    Page.reserve(TASK_PAGE_SIZE);
+    BinaryWriter Writer(Page);
+    Page.append(TASK_PAGED_MAGIC, sizeof(TASK_PAGED_MAGIC));
+    Writer.vidWriteU32(TASK_PAGED_VERSION);
+    Writer.vidWriteU32(static_cast<std::uint32_t>(TASK_PAGE_SIZE));
+    Writer.vidWriteU32(static_cast<std::uint32_t>(PageCount));
+    Writer.vidWriteU32(static_cast<std::uint32_t>(std::max(NextId, 0)));
+    Writer.vidWriteU64(TaskCount);
+    Writer.vidWriteU64(u64Checksum(Page.data(), Page.size()));
+    Page.resize(TASK_PAGE_SIZE, '\0');
+    return Page;
+}
+
+/**
+ * @brief Appends the image of an extent.
+ *
+ * @param Out Buffer the pages are appended to.
+ * @param Span Number of pages of the extent, or 0 for a free page.
+ * @param Count Number of records in the payload.
+ * @param Payload Encoded records, which must fit in the extent.
+ */
+static void vidEncodeExtent(std::string &Out, std::uint32_t Span, std::uint32_t Count, std::string_view Payload)
+{
+    std::size_t Start = Out.size();
+    BinaryWriter Writer(Out);
+    Writer.vidWriteU32(Span);
+    Writer.vidWriteU32(Count);
+    Writer.vidWriteU32(static_cast<std::uint32_t>(Payload.size()));
+    Writer.vidWriteU32(0);
+    std::uint64_t Checksum = u64Checksum(Out.data() + Start, 16);
+    Writer.vidWriteU64(u64Checksum(Payload.data(), Payload.size(), Checksum));
+    Out.append(Payload);
+    Out.resize(Start + std::max<std::size_t>(Span, 1) * TASK_PAGE_SIZE, '\0');
+}
+
+/**
+ * @brief Reads and verifies the header and payload checksum of an extent.
+ *
+ * @param Data First byte of the extent.
+ * @param Size Number of bytes readable from Data.
+ * @param Header Receives the header fields.
+ * @return true if the extent is whole and its checksum matches.
+ */
+static bool bReadExtentHeader(const char *Data, std::size_t Size, TaskExtentHeader &Header)
+{
+    if (Size < TASK_PAGE_SIZE)
+    {
+        return false;
+    }
+    BinaryReader Reader(Data, TASK_PAGE_HEADER_SIZE);
+    Header.Span = Reader.u32Read();
+    Header.Count = Reader.u32Read();
+    Header.Used = Reader.u32Read();
+    Reader.u32Read();
+    std::uint64_t Checksum = Reader.u64Read();
+    std::size_t Pages = std::max<std::size_t>(Header.Span, 1);
+    if (Header.Span == TASK_PAGE_CONTINUED || Pages > Size / TASK_PAGE_SIZE ||
+        Header.Used > Pages * TASK_PAGE_SIZE - TASK_PAGE_HEADER_SIZE || (Header.Span == 0 && Header.Count != 0))
+    {
+        return false;
+    }
+    return u64Checksum(Data + TASK_PAGE_HEADER_SIZE, Header.Used, u64Checksum(Data, 16)) == Checksum;
+}
+
+/**
+ * @brief Splits the payload of an extent into its records.
+ *
+ * @param Payload First byte of the payload.
+ * @param Header Header of the extent.
+ * @param Image Receives the records.
+ * @return true if the payload holds exactly the records the header announces.
+ */
+static bool bDecodeRecords(const char *Payload, const TaskExtentHeader &Header, TaskPageImage &Image)
+{
+    BinaryReader Reader(Payload, Header.Used);
+    Task Scratch;
+    Image.Span = Header.Span;
+    Image.Used = Header.Used;
+    Image.Records.reserve(Header.Count);
+    for (std::uint32_t Index = 0; Index < Header.Count; ++Index)
+    {
+        std::size_t Offset = Header.Used - Reader.u64Remaining();
+        if (Reader.bReadTask(Scratch) == false)
+        {
+            return false;
+        }
+        std::size_t Length = Header.Used - Reader.u64Remaining() - Offset;
+        Image.Records.emplace_back(Scratch.int32GetTaskID(), std::string(Payload + Offset, Length));
+    }
+    return Reader.u64Remaining() == 0;
+}
+
+/**
+ * @brief Writes page images to the doublewrite file and syncs it.
+ *
+ * The file holds a magic string, the page count, then each page number with
+ * its image, and ends with a checksum of everything before it, so a torn
+ * doublewrite file is recognized and ignored.
+ *
+ * @param filename Name of the doublewrite file.
+ * @param Targets Page number of each image.
+ * @param Images Page images, one after the other.
+ * @return true once the file is on disk.
+ */
+static bool bWriteDoublewrite(const std::string &filename, const std::vector<std::uint32_t> &Targets, const std::string &Images)
+{
+    std::string Buffer;
+    Buffer.reserve(24 + Targets.size() * (8 + TASK_PAGE_SIZE));
+    BinaryWriter Writer(Buffer);
+    Buffer.append(TASK_DOUBLEWRITE_MAGIC, sizeof(TASK_DOUBLEWRITE_MAGIC));
+    Writer.vidWriteU32(static_cast<std::uint32_t>(Targets.size()));
+    Writer.vidWriteU32(0);
+    for (std::size_t Index = 0; Index < Targets.size(); ++Index)
+    {
+        Writer.vidWriteU32(Targets[Index]);
+        Writer.vidWriteU32(0);
+        Buffer.append(Images, Index * TASK_PAGE_SIZE, TASK_PAGE_SIZE);
+    }
+    Writer.vidWriteU64(u64Checksum(Buffer.data(), Buffer.size()));
+
+    std::ofstream FileHandler(filename, std::ios::binary | std::ios::trunc);
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    FileHandler.close();
+    if (FileHandler.fail() == true || SyncFileToDisk(filename) == false)
+    {
+        return false;
+    }
+    TASK_METRIC_COUNT(MetricCounter::BytesWritten, Buffer.size());
+    return true;
+}
+
+/**
+ * @brief Gets the page a task is stored in.
+ *
+ * @param id ID of the task.
+ * @return First page of the extent holding the task, or 0 if the file does not hold it.
+ */
+std::uint32_t TaskPageFile::u32PageOf(int id) const
+{
+    if (id >= 0 && static_cast<std::size_t>(id) < DensePages.size() && DensePages[id] != 0)
+    {
+        return DensePages[id];
+    }
+    auto Found = SparsePages.find(id);
+    return (Found == SparsePages.end()) ? 0 : Found->second;
+}
+
+/**
+ * @brief Records the page a task is stored in.
+ *
+ * IDs are handed out in sequence, so they are normally kept in a flat array;
+ * only IDs far beyond the task count, as a hand-edited file may hold, go to a
+ * hash map instead.
+ *
+ * @param id ID of the task.
+ * @param Page First page of the extent holding the task, or 0 once it left the file.
+ */
+void TaskPageFile::vidSetPageOf(int id, std::uint32_t Page)
+{
+    std::size_t Limit = 2 * (TaskCount + SparsePages.size()) + TASK_PAGED_DENSE_SLACK;
+    if (id >= 0 && (static_cast<std::size_t>(id) < DensePages.size() || static_cast<std::size_t>(id) < Limit))
+    {
+        if (static_cast<std::size_t>(id) >= DensePages.size())
+        {
+            DensePages.resize(static_cast<std::size_t>(id) + 1, 0);
+        }
+        DensePages[id] = Page;
+        if (SparsePages.empty() == false)
+        {
+            SparsePages.erase(id);
+        }
+    }
+    else if (Page == 0)
+    {
+        SparsePages.erase(id);
+    }
+    else
+    {
+        SparsePages[id] = Page;
+    }
+}
+
+/**
+ * @brief Forgets the whole layout.
+ */
+void TaskPageFile::vidReset(void)
+{
+    Valid = false;
+    DensePages.clear();
+    SparsePages.clear();
+    PageSpan.clear();
+    PageUsed.clear();
+    FreePages.clear();
+    FillPage = 0;
+    TaskCount = 0;
+    SavedNextId = 0;
+    LastPagesWritten = 0;
+}
+
+/**
+ * @brief Applies the doublewrite file of an interrupted patch, then removes it.
+ *
+ * A doublewrite file that is incomplete or fails its checksum was torn before
+ * any page was written in place, so it is simply dropped.
+ *
+ * @return true if no page was left to recover or all of them were written back.
+ */
+bool TaskPageFile::bRecover(void)
+{
+    std::string Doublewrite = Path + ".dwb";
+    std::error_code Error;
+    if (std::filesystem::exists(Doublewrite, Error) == false)
+    {
+        return true;
+    }
+    bool Recovered = true;
+    {
+        MappedFile Content(Doublewrite);
+        std::string_view View = Content.View();
+        std::size_t Count = 0;
+        bool Complete = View.size() >= 24 && std::memcmp(View.data(), TASK_DOUBLEWRITE_MAGIC, sizeof(TASK_DOUBLEWRITE_MAGIC)) == 0;
+        if (Complete == true)
+        {
+            BinaryReader Reader(View.data() + 8, 4);
+            Count = Reader.u32Read();
+            BinaryReader Trailer(View.data() + View.size() - 8, 8);
+            Complete = View.size() == 24 + Count * (8 + TASK_PAGE_SIZE) &&
+                       u64Checksum(View.data(), View.size() - 8) == Trailer.u64Read();
+        }
+        if (Complete == true && std::filesystem::exists(Path, Error) == true)
+        {
+            std::fstream FileHandler(Path, std::ios::in | std::ios::out | std::ios::binary);
+            for (std::size_t Index = 0; Index < Count && FileHandler; ++Index)
+            {
+                const char *Entry = View.data() + 16 + Index * (8 + TASK_PAGE_SIZE);
+                BinaryReader Reader(Entry, 4);
+                FileHandler.seekp(static_cast<std::streamoff>(Reader.u32Read()) * static_cast<std::streamoff>(TASK_PAGE_SIZE));
+                FileHandler.write(Entry + 8, static_cast<std::streamsize>(TASK_PAGE_SIZE));
+            }
+            FileHandler.close();
+            Recovered = (FileHandler.fail() == false && SyncFileToDisk(Path) == true);
+        }
+    }
+    if (Recovered == true)
+    {
+        std::filesystem::remove(Doublewrite, Error);
+    }
+    return Recovered;
+}
+
+/**
+ * @brief Writes tasks as a new paged file, replacing any existing file atomically.
+ *
+ * The pages are written to "<filename>.tmp", synced and renamed over the
+ * target, and the layout is built along the way. A doublewrite file left
+ * over from the replaced file is removed before the rename.
+ *
+ * @param tasks Tasks to write; tombstones are skipped.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header.
+ * @return true on success, false if the file could not be written.
+ */
+bool TaskPageFile::bCreate(const TaskList &tasks, const std::string &filename, int NextId)
+{
+    vidReset();
+    Path = filename;
+    std::string TempFile = filename + ".tmp";
+    std::ofstream FileHandler(TempFile, std::ios::binary | std::ios::trunc);
+    if (!FileHandler)
+    {
+        return false;
+    }
+
+    std::string Buffer(TASK_PAGE_SIZE, '\0');
+    Buffer.reserve(TASK_PAGED_FLUSH_SIZE + 2 * TASK_PAGE_SIZE);
+    PageSpan.push_back(TASK_PAGE_CONTINUED);
+    PageUsed.push_back(0);
+    std::string Payload;
+    Payload.reserve(TASK_PAGE_SIZE);
+    std::uint32_t Count = 0;
+    auto vidFlushPage = [&]()
+    {
+        if (Count == 0)
+        {
+            return;
+        }
+        vidEncodeExtent(Buffer, 1, Count, Payload);
+        PageSpan.push_back(1);
+        PageUsed.push_back(static_cast<std::uint32_t>(Payload.size()));
+        Payload.clear();
+        Count = 0;
+        if (Buffer.size() >= TASK_PAGED_FLUSH_SIZE)
+        {
+            FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        }
+    };
+
+    std::string Record;
+    BinaryWriter Writer(Record);
+    for (auto &it : tasks)
+    {
+        if (it.bIsRemoved() == true)
+        {
+            continue;
+        }
+        Record.clear();
+        Writer.vidWriteTask(it);
+        ++TaskCount;
+        if (Record.size() > TASK_PAGE_PAYLOAD)
+        {
+            vidFlushPage();
+            std::uint32_t Page = static_cast<std::uint32_t>(PageSpan.size());
+            std::uint32_t Span = static_cast<std::uint32_t>((Record.size() + TASK_PAGE_HEADER_SIZE + TASK_PAGE_SIZE - 1) / TASK_PAGE_SIZE);
+            vidEncodeExtent(Buffer, Span, 1, Record);
+            PageSpan.push_back(Span);
+            PageSpan.resize(Page + Span, TASK_PAGE_CONTINUED);
+            PageUsed.push_back(static_cast<std::uint32_t>(Record.size()));
+            PageUsed.resize(Page + Span, 0);
+            vidSetPageOf(it.int32GetTaskID(), Page);
+            continue;
+        }
+        if (Payload.size() + Record.size() > TASK_PAGE_FILL)
+        {
+            vidFlushPage();
+        }
+        vidSetPageOf(it.int32GetTaskID(), static_cast<std::uint32_t>(PageSpan.size()));
+        Payload.append(Record);
+        ++Count;
+    }
+    vidFlushPage();
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    std::string Header = EncodeFileHeader(PageSpan.size(), NextId, TaskCount);
+    FileHandler.seekp(0);
+    FileHandler.write(Header.data(), static_cast<std::streamsize>(Header.size()));
+    FileHandler.close();
+
+    std::error_code Error;
+    if (FileHandler.fail() == false && SyncFileToDisk(TempFile) == true)
+    {
+        std::filesystem::remove(filename + ".dwb", Error);
+        std::filesystem::rename(TempFile, filename, Error);
+        if (!Error)
+        {
+            for (std::size_t Page = PageSpan.size(); Page-- > 1 && FillPage == 0;)
+            {
+                FillPage = (PageSpan[Page] == 1) ? static_cast<std::uint32_t>(Page) : 0;
+            }
+            SavedNextId = NextId;
+            Valid = true;
+            return true;
+        }
+    }
+    std::filesystem::remove(TempFile, Error);
+    vidReset();
+    return false;
+}
+
+/**
+ * @brief Reads every task of a paged file and builds its layout.
+ *
+ * A doublewrite file left by an interrupted patch is applied first. The file
+ * is mapped and decoded in place; tasks moved by patches are sorted back into
+ * ID order afterwards, which is skipped for files that are still in order.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the decoded tasks are appended to.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if the file is empty.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool TaskPageFile::bLoad(const std::string &filename, TaskList &tasks, int &NextId)
+{
+    vidReset();
+    Path = filename;
+    NextId = 0;
+    if (bRecover() == false)
+    {
+        return false;
+    }
+    MappedFile File(filename);
+    if (File.bIsOpen() == false)
+    {
+        return false;
+    }
+    std::string_view Content = File.View();
+    if (Content.empty() == true)
+    {
+        return true;
+    }
+    if (Content.size() < TASK_PAGE_SIZE ||
+        std::memcmp(Content.data(), TASK_PAGED_MAGIC, sizeof(TASK_PAGED_MAGIC)) != 0)
+    {
+        return false;
+    }
+    BinaryReader Header(Content.data() + sizeof(TASK_PAGED_MAGIC), TASK_PAGED_HEADER_FIELDS - sizeof(TASK_PAGED_MAGIC));
+    std::uint32_t Version = Header.u32Read();
+    std::uint32_t PageSize = Header.u32Read();
+    std::uint32_t PageCount = Header.u32Read();
+    std::uint32_t HeaderNextId = Header.u32Read();
+    std::uint64_t Count = Header.u64Read();
+    std::uint64_t Checksum = Header.u64Read();
+    if (Version != TASK_PAGED_VERSION || PageSize != TASK_PAGE_SIZE || PageCount == 0 ||
+        Content.size() / TASK_PAGE_SIZE < PageCount || HeaderNextId > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+        u64Checksum(Content.data(), TASK_PAGED_HEADER_FIELDS - 8) != Checksum)
+    {
+        return false;
+    }
+
+    std::size_t FirstNew = tasks.size();
+    tasks.reserve(FirstNew + Count);
+    if (HeaderNextId < 2 * Count + TASK_PAGED_DENSE_SLACK)
+    {
+        DensePages.reserve(HeaderNextId);
+    }
+    PageSpan.reserve(PageCount);
+    PageUsed.reserve(PageCount);
+    PageSpan.push_back(TASK_PAGE_CONTINUED);
+    PageUsed.push_back(0);
+    bool Sorted = true;
+    bool Decoded = true;
+    for (std::uint32_t Page = 1; Page < PageCount && Decoded == true;)
+    {
+        const char *Data = Content.data() + static_cast<std::size_t>(Page) * TASK_PAGE_SIZE;
+        TaskExtentHeader Extent;
+        if (bReadExtentHeader(Data, static_cast<std::size_t>(PageCount - Page) * TASK_PAGE_SIZE, Extent) == false)
+        {
+            Decoded = false;
+            break;
+        }
+        if (Extent.Span == 0)
+        {
+            PageSpan.push_back(0);
+            PageUsed.push_back(0);
+            FreePages.push_back(Page);
+            ++Page;
+            continue;
+        }
+        BinaryReader Reader(Data + TASK_PAGE_HEADER_SIZE, Extent.Used);
+        for (std::uint32_t Index = 0; Index < Extent.Count && Decoded == true; ++Index)
+        {
+            tasks.emplace_back();
+            Decoded = Reader.bReadTask(tasks.back());
+            int id = tasks.back().int32GetTaskID();
+            Sorted = Sorted && (tasks.size() - 1 == FirstNew || tasks[tasks.size() - 2].int32GetTaskID() < id);
+            ++TaskCount;
+            vidSetPageOf(id, Page);
+        }
+        Decoded = Decoded && Reader.u64Remaining() == 0;
+        PageSpan.push_back(Extent.Span);
+        PageSpan.resize(Page + Extent.Span, TASK_PAGE_CONTINUED);
+        PageUsed.push_back(Extent.Used);
+        PageUsed.resize(Page + Extent.Span, 0);
+        FillPage = (Extent.Span == 1) ? Page : FillPage;
+        Page += Extent.Span;
+    }
+    if (Decoded == false || TaskCount != Count)
+    {
+        tasks.resize(FirstNew);
+        vidReset();
+        return false;
+    }
+    if (Sorted == false)
+    {
+        std::sort(tasks.begin() + static_cast<std::ptrdiff_t>(FirstNew), tasks.end(), [](const Task &Left, const Task &Right)
+                  { return Left.int32GetTaskID() < Right.int32GetTaskID(); });
+    }
+    SavedNextId = static_cast<int>(HeaderNextId);
+    NextId = SavedNextId;
+    Valid = true;
+    return true;
+}
+
+/**
+ * @brief Rewrites only the pages touched by a set of changes.
+ *
+ * The touched extents are read and split into records, edited, and encoded
+ * again. The new images, and the header page if the task count, page count
+ * or next ID changed, are written to the doublewrite file and synced, then
+ * written in place and synced, and the doublewrite file is removed. The
+ * layout is invalid from the first edit until the pages are on disk, so a
+ * failed patch is always followed by a full write.
+ *
+ * @param Changed Current state of every task added or changed since the file was last written.
+ * @param Removed IDs of the tasks removed since then; IDs the file does not hold are ignored.
+ * @param NextId Next task ID to record in the header.
+ * @return true on success, false if the layout is invalid or the file could not be written.
+ */
+bool TaskPageFile::bPatch(const TaskList &Changed, const std::vector<int> &Removed, int NextId)
+{
+    LastPagesWritten = 0;
+    if (Valid == false)
+    {
+        return false;
+    }
+    Valid = false;
+    std::fstream FileHandler(Path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!FileHandler)
+    {
+        return false;
+    }
+
+    std::size_t OldPageCount = PageSpan.size();
+    std::uint64_t OldTaskCount = TaskCount;
+    std::map<std::uint32_t, TaskPageImage> Pages;
+    std::string Buffer;
+    auto LoadPage = [&](std::uint32_t Page) -> TaskPageImage *
+    {
+        auto Found = Pages.find(Page);
+        if (Found != Pages.end())
+        {
+            return &Found->second;
+        }
+        Buffer.resize(static_cast<std::size_t>(PageSpan[Page]) * TASK_PAGE_SIZE);
+        FileHandler.seekg(static_cast<std::streamoff>(Page) * static_cast<std::streamoff>(TASK_PAGE_SIZE));
+        FileHandler.read(&Buffer[0], static_cast<std::streamsize>(Buffer.size()));
+        TaskExtentHeader Extent;
+        TaskPageImage Image;
+        if (!FileHandler || bReadExtentHeader(Buffer.data(), Buffer.size(), Extent) == false || Extent.Span != PageSpan[Page] ||
+            bDecodeRecords(Buffer.data() + TASK_PAGE_HEADER_SIZE, Extent, Image) == false)
+        {
+            return nullptr;
+        }
+        TASK_METRIC_COUNT(MetricCounter::BytesRead, Buffer.size());
+        return &Pages.emplace(Page, std::move(Image)).first->second;
+    };
+    auto FindRecord = [](TaskPageImage &Image, int id)
+    {
+        return std::find_if(Image.Records.begin(), Image.Records.end(), [id](const std::pair<int, std::string> &Entry)
+                            { return Entry.first == id; });
+    };
+
+    for (int id : Removed)
+    {
+        std::uint32_t Page = u32PageOf(id);
+        if (Page == 0)
+        {
+            continue;
+        }
+        TaskPageImage *Image = LoadPage(Page);
+        if (Image == nullptr)
+        {
+            return false;
+        }
+        auto Entry = FindRecord(*Image, id);
+        if (Entry == Image->Records.end())
+        {
+            return false;
+        }
+        Image->Used -= Entry->second.size();
+        Image->Records.erase(Entry);
+        vidSetPageOf(id, 0);
+        --TaskCount;
+    }
+
+    std::vector<std::pair<int, std::string>> Pending;
+    std::string Record;
+    BinaryWriter Writer(Record);
+    for (auto &it : Changed)
+    {
+        if (it.bIsRemoved() == true)
+        {
+            continue;
+        }
+        Record.clear();
+        Writer.vidWriteTask(it);
+        int id = it.int32GetTaskID();
+        std::uint32_t Page = u32PageOf(id);
+        if (Page == 0)
+        {
+            ++TaskCount;
+            Pending.emplace_back(id, Record);
+            continue;
+        }
+        TaskPageImage *Image = LoadPage(Page);
+        if (Image == nullptr)
+        {
+            return false;
+        }
+        auto Entry = FindRecord(*Image, id);
+        if (Entry == Image->Records.end())
+        {
+            return false;
+        }
+        std::size_t Capacity = static_cast<std::size_t>(Image->Span) * TASK_PAGE_SIZE - TASK_PAGE_HEADER_SIZE;
+        if (Image->Used - Entry->second.size() + Record.size() <= Capacity)
+        {
+            Image->Used = Image->Used - Entry->second.size() + Record.size();
+            Entry->second = Record;
+            continue;
+        }
+        Image->Used -= Entry->second.size();
+        Image->Records.erase(Entry);
+        vidSetPageOf(id, 0);
+        Pending.emplace_back(id, Record);
+    }
+
+    for (auto &Entry : Pending)
+    {
+        std::uint32_t Page = 0;
+        if (Entry.second.size() > TASK_PAGE_PAYLOAD)
+        {
+            Page = static_cast<std::uint32_t>(PageSpan.size());
+            std::uint32_t Span = static_cast<std::uint32_t>((Entry.second.size() + TASK_PAGE_HEADER_SIZE + TASK_PAGE_SIZE - 1) / TASK_PAGE_SIZE);
+            PageSpan.push_back(Span);
+            PageSpan.resize(Page + Span, TASK_PAGE_CONTINUED);
+            PageUsed.resize(Page + Span, 0);
+            Pages[Page].Span = Span;
+        }
+        else
+        {
+            if (FillPage != 0 && PageSpan[FillPage] == 1)
+            {
+                auto Found = Pages.find(FillPage);
+                std::size_t Used = (Found != Pages.end()) ? Found->second.Used : PageUsed[FillPage];
+                Page = (Used + Entry.second.size() <= TASK_PAGE_PAYLOAD) ? FillPage : 0;
+            }
+            if (Page == 0 && FreePages.empty() == false)
+            {
+                Page = FreePages.back();
+                FreePages.pop_back();
+                PageSpan[Page] = 1;
+                Pages[Page] = TaskPageImage();
+            }
+            if (Page == 0)
+            {
+                Page = static_cast<std::uint32_t>(PageSpan.size());
+                PageSpan.push_back(1);
+                PageUsed.push_back(0);
+                Pages[Page] = TaskPageImage();
+            }
+            FillPage = Page;
+        }
+        TaskPageImage *Image = LoadPage(Page);
+        if (Image == nullptr)
+        {
+            return false;
+        }
+        Image->Used += Entry.second.size();
+        Image->Records.push_back(std::move(Entry));
+        vidSetPageOf(Image->Records.back().first, Page);
+    }
+
+    std::string Images;
+    std::vector<std::uint32_t> Targets;
+    std::string Payload;
+    for (auto &[Page, Image] : Pages)
+    {
+        if (Image.Records.empty() == true)
+        {
+            for (std::uint32_t Index = 0; Index < Image.Span; ++Index)
+            {
+                PageSpan[Page + Index] = 0;
+                PageUsed[Page + Index] = 0;
+                FreePages.push_back(Page + Index);
+                vidEncodeExtent(Images, 0, 0, std::string_view());
+                Targets.push_back(Page + Index);
+            }
+            continue;
+        }
+        Payload.clear();
+        for (auto &Entry : Image.Records)
+        {
+            Payload.append(Entry.second);
+        }
+        vidEncodeExtent(Images, Image.Span, static_cast<std::uint32_t>(Image.Records.size()), Payload);
+        PageUsed[Page] = static_cast<std::uint32_t>(Image.Used);
+        for (std::uint32_t Index = 0; Index < Image.Span; ++Index)
+        {
+            Targets.push_back(Page + Index);
+        }
+    }
+    if (PageSpan.size() != OldPageCount || TaskCount != OldTaskCount || NextId != SavedNextId)
+    {
+        Images.append(EncodeFileHeader(PageSpan.size(), NextId, TaskCount));
+        Targets.push_back(0);
+    }
+    if (Targets.empty() == true)
+    {
+        Valid = true;
+        return true;
+    }
+
+    std::string Doublewrite = Path + ".dwb";
+    if (bWriteDoublewrite(Doublewrite, Targets, Images) == false)
+    {
+        return false;
+    }
+    for (std::size_t Index = 0; Index < Targets.size() && FileHandler; ++Index)
+    {
+        FileHandler.seekp(static_cast<std::streamoff>(Targets[Index]) * static_cast<std::streamoff>(TASK_PAGE_SIZE));
+        FileHandler.write(Images.data() + Index * TASK_PAGE_SIZE, static_cast<std::streamsize>(TASK_PAGE_SIZE));
+    }
+    FileHandler.close();
+    if (FileHandler.fail() == true || SyncFileToDisk(Path) == false)
+    {
+        return false;
+    }
+    TASK_METRIC_COUNT(MetricCounter::BytesWritten, Images.size());
+    std::error_code Error;
+    std::filesystem::remove(Doublewrite, Error);
+    SavedNextId = NextId;
+    LastPagesWritten = Targets.size();
+    Valid = true;
+    return true;
+}
+
+/**
+ * @brief Tells whether the layout matches the file on disk, so the file can be patched.
+ *
+ * @return true if bPatch() may be used.
+ */
+bool TaskPageFile::bIsValid(void) const
+{
+    return Valid;
+}
+
+/**
+ * @brief Gets the file the layout describes.
+ *
+ * @return Name of the file, or an empty string if none.
+ */
+const std::string &TaskPageFile::GetPath(void) const
+{
+    return Path;
+}
+
+/**
+ * @brief Gets the number of pages written in place by the last patch.
+ *
+ * @return Page count, not counting the copies in the doublewrite file.
+ */
+std::size_t TaskPageFile::u64GetPagesWritten(void) const
+{
+    return LastPagesWritten;
+}
+
+/**
+ * @brief Tells whether a file name selects the paged task format.
+ *
+ * @param filename Name of the task file.
+ * @return true if the name ends with ".tdb".
+ */
+bool IsPagedTaskFile(const std::string &filename)
+{
+    const std::string Extension = ".tdb";
+    return filename.size() >= Extension.size() &&
+           filename.compare(filename.size() - Extension.size(), Extension.size(), Extension) == 0;
+}
+
+/**
+ * @brief Writes tasks to a file in the paged format, replacing it atomically.
+ *
+ * @param tasks Tasks to write; tombstones are skipped.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksPaged(const TaskList &tasks, const std::string &filename, int NextId)
+{
+    TaskPageFile File;
+    return File.bCreate(tasks, filename, NextId);
+}
+
+/**
+ * @brief Reads tasks from a file in the paged format.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the decoded tasks are appended to, in ID order.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if the file is empty.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool LoadTasksPaged(const std::string &filename, TaskList &tasks, int &NextId)
+{
+    TaskPageFile File;
+    return File.bLoad(filename, tasks, NextId);
+}
@@ -0,0 +1,199 @@
+/**
+ * @file task_paged.hpp
+ * @brief Declaration of the paged task file format, which can be updated in place.
+ *
+ * A paged task file is made of fixed-size pages. Page 0 is the file header:
+ * a magic string, the format version, the page size, the page count, the next
+ * task ID to hand out, the number of tasks and a checksum of these fields.
+ * Every other page either is free or starts an extent of one or more pages
+ * holding task records in the binary format (see BinaryWriter::vidWriteTask()),
+ * behind a small header with the extent length, the record count, the number
+ * of payload bytes and a checksum. A record too large for one page gets an
+ * extent of its own, long enough to hold it.
+ *
+ * Because every record lives in a known page, a save only has to rewrite the
+ * pages holding the tasks that changed: a one-task edit costs one page write,
+ * however large the file. Pages left empty by deletions are kept on a free
+ * list and reused for new tasks before the file grows.
+ *
+ * Pages are never written in place before their new images are safely on
+ * disk in a doublewrite file ("<filename>.dwb"), which is applied again when
+ * the file is next opened, so a crash in the middle of a page write never
+ * leaves a torn page behind.
+ * All integers are stored little-endian regardless of the host byte order.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__PAGED__
+#define __TASK__PAGED__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "task.hpp"
+
+/**
+ * @brief Size in bytes of every page of a paged task file.
+ */
+constexpr std::size_t TASK_PAGE_SIZE = 4096;
+
+/**
+ * @brief Size in bytes of the header at the start of each extent.
+ */
+constexpr std::size_t TASK_PAGE_HEADER_SIZE = 24;
+
+/**
+ * @brief Current version of the paged task file format.
+ */
+constexpr std::uint32_t TASK_PAGED_VERSION = 1;
+
+/**
+ * @class TaskPageFile
+ * @brief Layout of a paged task file: which page holds each task, and how full each page is.
+ *
+ * The layout is built when the file is written or loaded in full, and kept
+ * up to date by bPatch(), which rewrites only the pages touched by the given
+ * changes. If anything goes wrong the layout is marked invalid, and the file
+ * must be written in full again before it can be patched.
+ */
+class TaskPageFile
+{
+private:
+    std::string Path;                                   /**< File the layout describes. */
+    bool Valid = false;                                 /**< true if the layout matches the file on disk. */
+    std::vector<std::uint32_t> DensePages;              /**< First page of the extent holding each task ID, or 0. */
+    std::unordered_map<int, std::uint32_t> SparsePages; /**< Same, for IDs too far apart to be kept in DensePages. */
+    std::vector<std::uint32_t> PageSpan;                /**< Extent length of each page: 0 if free, TASK_PAGE_CONTINUED past the first page. */
+    std::vector<std::uint32_t> PageUsed;                /**< Payload bytes in use in each extent, by its first page. */
+    std::vector<std::uint32_t> FreePages;               /**< Free pages, reused last in first out. */
+    std::uint32_t FillPage = 0;                         /**< Page new tasks are added to while it has room, or 0. */
+    std::uint64_t TaskCount = 0;                        /**< Number of tasks in the file. */
+    int SavedNextId = 0;                                /**< Next task ID recorded in the file header. */
+    std::size_t LastPagesWritten = 0;                   /**< Pages written in place by the last patch. */
+
+    /**
+     * @brief Gets the page a task is stored in.
+     *
+     * @param id ID of the task.
+     * @return First page of the extent holding the task, or 0 if the file does not hold it.
+     */
+    std::uint32_t u32PageOf(int id) const;
+
+    /**
+     * @brief Records the page a task is stored in.
+     *
+     * @param id ID of the task.
+     * @param Page First page of the extent holding the task, or 0 once it left the file.
+     */
+    void vidSetPageOf(int id, std::uint32_t Page);
+
+    /**
+     * @brief Forgets the whole layout.
+     */
+    void vidReset(void);
+
+    /**
+     * @brief Applies the doublewrite file of an interrupted patch, then removes it.
+     *
+     * @return true if no page was left to recover or all of them were written back.
+     */
+    bool bRecover(void);
+
+public:
+    /**
+     * @brief Writes tasks as a new paged file, replacing any existing file atomically.
+     *
+     * Pages are filled to seven eighths when written in full, so most edits
+     * that make a task longer still fit in its page.
+     *
+     * @param tasks Tasks to write; tombstones are skipped.
+     * @param filename Name of the file to write.
+     * @param NextId Next task ID to record in the header.
+     * @return true on success, false if the file could not be written.
+     */
+    bool bCreate(const TaskList &tasks, const std::string &filename, int NextId);
+
+    /**
+     * @brief Reads every task of a paged file and builds its layout.
+     *
+     * The tasks are appended in ID order. Every page checksum is verified
+     * before any task is returned.
+     *
+     * @param filename Name of the file to read.
+     * @param tasks List the decoded tasks are appended to.
+     * @param NextId Receives the next task ID recorded in the header, or 0 if the file is empty.
+     * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+     */
+    bool bLoad(const std::string &filename, TaskList &tasks, int &NextId);
+
+    /**
+     * @brief Rewrites only the pages touched by a set of changes.
+     *
+     * A changed task is rewritten in its page if it still fits there, and
+     * moved otherwise. New tasks go to the page last filled, then to a free
+     * page, then to a page added at the end of the file. Pages left empty are
+     * put on the free list.
+     *
+     * @param Changed Current state of every task added or changed since the file was last written.
+     * @param Removed IDs of the tasks removed since then; IDs the file does not hold are ignored.
+     * @param NextId Next task ID to record in the header.
+     * @return true on success, false if the layout is invalid or the file could not be written.
+     */
+    bool bPatch(const TaskList &Changed, const std::vector<int> &Removed, int NextId);
+
+    /**
+     * @brief Tells whether the layout matches the file on disk, so the file can be patched.
+     *
+     * @return true if bPatch() may be used.
+     */
+    bool bIsValid(void) const;
+
+    /**
+     * @brief Gets the file the layout describes.
+     *
+     * @return Name of the file, or an empty string if none.
+     */
+    const std::string &GetPath(void) const;
+
+    /**
+     * @brief Gets the number of pages written in place by the last patch.
+     *
+     * @return Page count, not counting the copies in the doublewrite file.
+     */
+    std::size_t u64GetPagesWritten(void) const;
+};
+
+/**
+ * @brief Tells whether a file name selects the paged task format.
+ *
+ * Files with the ".tdb" extension are stored in the paged format.
+ *
+ * @param filename Name of the task file.
+ * @return true if the file uses the paged format.
+ */
+bool IsPagedTaskFile(const std::string &filename);
+
+/**
+ * @brief Writes tasks to a file in the paged format, replacing it atomically.
+ *
+ * @param tasks Tasks to write; tombstones are skipped.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksPaged(const TaskList &tasks, const std::string &filename, int NextId);
+
+/**
+ * @brief Reads tasks from a file in the paged format.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the decoded tasks are appended to, in ID order.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if the file is empty.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool LoadTasksPaged(const std::string &filename, TaskList &tasks, int &NextId);
+
+#endif // __TASK__PAGED__
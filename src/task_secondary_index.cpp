@@ -0,0 +1,231 @@
+/**
+ * @file task_secondary_index.cpp
+ * @brief Implementation of the TaskSecondaryIndex class.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include <algorithm>
+#include <iterator>
+#include "task_secondary_index.hpp"
+
+/**
+ * @brief Number of priority levels, and so of posting lists per status.
+ */
+static constexpr std::size_t TASK_INDEX_PRIORITY_COUNT = static_cast<std::size_t>(TaskPriority::High) + 1;
+
+/**
+ * @brief Number of posting lists, one per status and priority.
+ */
+static constexpr std::size_t TASK_INDEX_LIST_COUNT = (static_cast<std::size_t>(TaskState::Done) + 1) * TASK_INDEX_PRIORITY_COUNT;
+
+/**
+ * @brief Bias that maps signed 32-bit values onto unsigned values in the same order.
+ */
+static constexpr std::uint32_t TASK_INDEX_SIGN_BIAS = 0x80000000u;
+
+/**
+ * @brief Default constructor for TaskSecondaryIndex.
+ */
+TaskSecondaryIndex::TaskSecondaryIndex()
+{
+    Lists.reserve(TASK_INDEX_LIST_COUNT);
+    for (std::size_t List = 0; List < TASK_INDEX_LIST_COUNT; ++List)
+    {
+        Lists.emplace_back(&NodePool);
+    }
+}
+
+/**
+ * @brief Gets the posting list of a status and priority.
+ *
+ * @param State Task status.
+ * @param Priority Task priority.
+ * @return Position of the list in Lists.
+ */
+std::size_t TaskSecondaryIndex::u64ListOf(TaskState State, TaskPriority Priority)
+{
+    return static_cast<std::size_t>(State) * TASK_INDEX_PRIORITY_COUNT + static_cast<std::size_t>(Priority);
+}
+
+/**
+ * @brief Encodes a due date and ID into a key that sorts by due date, then ID.
+ *
+ * @param DueDay Due date as a day number.
+ * @param id Task ID.
+ * @return Key of the task in its posting list.
+ */
+std::uint64_t TaskSecondaryIndex::u64Key(std::int32_t DueDay, int id)
+{
+    std::uint64_t High = static_cast<std::uint32_t>(DueDay) ^ TASK_INDEX_SIGN_BIAS;
+    std::uint64_t Low = static_cast<std::uint32_t>(id) ^ TASK_INDEX_SIGN_BIAS;
+    return (High << 32) | Low;
+}
+
+/**
+ * @brief Tells whether the index has been built.
+ *
+ * @return true if the index tracks every task.
+ */
+bool TaskSecondaryIndex::bIsBuilt(void) const
+{
+    return Built;
+}
+
+/**
+ * @brief Fills the index from a task list, replacing its content.
+ *
+ * @param tasks Tasks to index; tombstones are skipped.
+ */
+void TaskSecondaryIndex::vidBuild(const TaskList &tasks)
+{
+    vidClear();
+    Built = true;
+    for (auto &it : tasks)
+    {
+        if (it.bIsRemoved() == true)
+        {
+            continue;
+        }
+        vidInsert(it);
+    }
+}
+
+/**
+ * @brief Empties the index and marks it as unbuilt.
+ */
+void TaskSecondaryIndex::vidClear(void)
+{
+    for (auto &List : Lists)
+    {
+        List.clear();
+    }
+    Built = false;
+}
+
+/**
+ * @brief Adds a task to the index.
+ *
+ * @param task Task to add, with its current status, priority and due date.
+ */
+void TaskSecondaryIndex::vidInsert(const Task &task)
+{
+    if (Built == true)
+    {
+        Lists[u64ListOf(task.GetTaskState(), task.GetTaskPriority())].insert(u64Key(task.int32GetDueDay(), task.int32GetTaskID()));
+    }
+}
+
+/**
+ * @brief Removes a task from the index.
+ *
+ * @param task Task to remove, with the status, priority and due date it was indexed with.
+ */
+void TaskSecondaryIndex::vidErase(const Task &task)
+{
+    if (Built == true)
+    {
+        Lists[u64ListOf(task.GetTaskState(), task.GetTaskPriority())].erase(u64Key(task.int32GetDueDay(), task.int32GetTaskID()));
+    }
+}
+
+/**
+ * @brief Moves a batch of tasks to the posting lists of a new status.
+ *
+ * The nodes are unlinked from their old lists and relinked into the new ones
+ * without being reallocated. They are relinked in key order, each insertion
+ * hinted by the previous one, so a batch of IDs costs one pass per list.
+ *
+ * @param Changed Tasks to move, with the status they were indexed with.
+ * @param State New status of every task in Changed.
+ */
+void TaskSecondaryIndex::vidMoveToState(const std::vector<const Task *> &Changed, TaskState State)
+{
+    if (Built == false)
+    {
+        return;
+    }
+    using NodeType = std::pmr::set<std::uint64_t>::node_type;
+    std::vector<std::pair<std::size_t, NodeType>> Moved;
+    Moved.reserve(Changed.size());
+    for (const Task *it : Changed)
+    {
+        if (it->GetTaskState() == State)
+        {
+            continue;
+        }
+        NodeType Node = Lists[u64ListOf(it->GetTaskState(), it->GetTaskPriority())].extract(u64Key(it->int32GetDueDay(), it->int32GetTaskID()));
+        if (Node.empty() == false)
+        {
+            Moved.emplace_back(u64ListOf(State, it->GetTaskPriority()), std::move(Node));
+        }
+    }
+    std::sort(Moved.begin(), Moved.end(), [](const std::pair<std::size_t, NodeType> &Left, const std::pair<std::size_t, NodeType> &Right)
+              { return (Left.first != Right.first) ? (Left.first < Right.first) : (Left.second.value() < Right.second.value()); });
+    std::size_t Current = TASK_INDEX_LIST_COUNT;
+    std::pmr::set<std::uint64_t>::iterator Hint;
+    for (auto &Entry : Moved)
+    {
+        auto &List = Lists[Entry.first];
+        if (Entry.first != Current)
+        {
+            Current = Entry.first;
+            Hint = List.lower_bound(Entry.second.value());
+        }
+        Hint = std::next(List.insert(Hint, std::move(Entry.second)));
+    }
+}
+
+/**
+ * @brief Collects the IDs of the tasks matching a filter.
+ *
+ * Only the posting lists of the requested status and priority are visited,
+ * and in each only the requested due date range. The ranges are then merged,
+ * so the cost is proportional to the number of matches.
+ *
+ * @param Filter Conditions to match.
+ * @return Matching task IDs, ordered by due date and then ID.
+ */
+std::vector<int> TaskSecondaryIndex::Select(const TaskFilter &Filter) const
+{
+    using Iterator = std::pmr::set<std::uint64_t>::const_iterator;
+    std::vector<std::pair<Iterator, Iterator>> Ranges;
+    std::uint64_t From = u64Key(Filter.DueFrom, std::numeric_limits<int>::min());
+    std::uint64_t To = u64Key(Filter.DueTo, std::numeric_limits<int>::max());
+    for (std::size_t List = 0; List < Lists.size(); ++List)
+    {
+        auto State = static_cast<TaskState>(List / TASK_INDEX_PRIORITY_COUNT);
+        auto Priority = static_cast<TaskPriority>(List % TASK_INDEX_PRIORITY_COUNT);
+        if ((Filter.HasState == true && State != Filter.State) || (Filter.HasPriority == true && Priority != Filter.Priority))
+        {
+            continue;
+        }
+        Iterator First = Lists[List].lower_bound(From);
+        Iterator Last = Lists[List].upper_bound(To);
+        if (First != Last)
+        {
+            Ranges.emplace_back(First, Last);
+        }
+    }
+
+    std::vector<int> Ids;
+    while (Ranges.empty() == false)
+    {
+        std::size_t Smallest = 0;
+        for (std::size_t Range = 1; Range < Ranges.size(); ++Range)
+        {
+            if (*Ranges[Range].first < *Ranges[Smallest].first)
+            {
+                Smallest = Range;
+            }
+        }
+        auto &Range = Ranges[Smallest];
+        Ids.push_back(static_cast<int>(static_cast<std::uint32_t>(*Range.first) ^ TASK_INDEX_SIGN_BIAS));
+        if (++Range.first == Range.second)
+        {
+            Ranges.erase(Ranges.begin() + static_cast<std::ptrdiff_t>(Smallest));
+        }
+    }
+    return Ids;
+}
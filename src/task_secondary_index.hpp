@@ -0,0 +1,131 @@
+/**
+ * @file task_secondary_index.hpp
+ * @brief Declaration of the TaskSecondaryIndex class, an index of tasks by status, priority and due date.
+ *
+ * Tasks are split into one posting list per (status, priority) pair, and each
+ * list is kept sorted by due date and then ID. A filter selects the lists it
+ * needs and reads only the due date range it asks for, so a query costs time
+ * proportional to its result rather than to the number of tasks.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__SECONDARY__INDEX__
+#define __TASK__SECONDARY__INDEX__
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <vector>
+#include "task.hpp"
+
+/**
+ * @struct TaskFilter
+ * @brief Conditions a task must meet to be selected by a query.
+ *
+ * Unset conditions match every task. The due date range is inclusive.
+ */
+struct TaskFilter
+{
+    bool HasState = false;                              /**< true to filter on State. */
+    TaskState State = TaskState::Pending;               /**< Required status. */
+    bool HasPriority = false;                           /**< true to filter on Priority. */
+    TaskPriority Priority = TaskPriority::Unknown;      /**< Required priority. */
+    std::int32_t DueFrom = std::numeric_limits<std::int32_t>::min();    /**< Earliest due day. */
+    std::int32_t DueTo = std::numeric_limits<std::int32_t>::max();      /**< Latest due day. */
+};
+
+/**
+ * @class TaskSecondaryIndex
+ * @brief Posting lists of task IDs by status and priority, ordered by due date.
+ *
+ * The index starts out unbuilt, and inserts and erases are ignored until
+ * vidBuild() fills it, so task sets that are never queried pay nothing for it.
+ */
+class TaskSecondaryIndex
+{
+private:
+    std::pmr::unsynchronized_pool_resource NodePool;    /**< Pool serving the nodes of every posting list. */
+    std::vector<std::pmr::set<std::uint64_t>> Lists;    /**< One list of (due date, ID) keys per status and priority. */
+    bool Built = false;                                 /**< true once vidBuild() has run. */
+
+    /**
+     * @brief Gets the posting list of a status and priority.
+     *
+     * @param State Task status.
+     * @param Priority Task priority.
+     * @return Position of the list in Lists.
+     */
+    static std::size_t u64ListOf(TaskState State, TaskPriority Priority);
+
+    /**
+     * @brief Encodes a due date and ID into a key that sorts by due date, then ID.
+     *
+     * @param DueDay Due date as a day number.
+     * @param id Task ID.
+     * @return Key of the task in its posting list.
+     */
+    static std::uint64_t u64Key(std::int32_t DueDay, int id);
+
+public:
+    /**
+     * @brief Default constructor for TaskSecondaryIndex.
+     */
+    TaskSecondaryIndex();
+
+    TaskSecondaryIndex(const TaskSecondaryIndex &) = delete;
+    TaskSecondaryIndex &operator=(const TaskSecondaryIndex &) = delete;
+
+    /**
+     * @brief Tells whether the index has been built.
+     *
+     * @return true if the index tracks every task.
+     */
+    bool bIsBuilt(void) const;
+
+    /**
+     * @brief Fills the index from a task list, replacing its content.
+     *
+     * @param tasks Tasks to index; tombstones are skipped.
+     */
+    void vidBuild(const TaskList &tasks);
+
+    /**
+     * @brief Empties the index and marks it as unbuilt.
+     */
+    void vidClear(void);
+
+    /**
+     * @brief Adds a task to the index.
+     *
+     * @param task Task to add, with its current status, priority and due date.
+     */
+    void vidInsert(const Task &task);
+
+    /**
+     * @brief Removes a task from the index.
+     *
+     * @param task Task to remove, with the status, priority and due date it was indexed with.
+     */
+    void vidErase(const Task &task);
+
+    /**
+     * @brief Moves a batch of tasks to the posting lists of a new status.
+     *
+     * @param Changed Tasks to move, with the status they were indexed with.
+     * @param State New status of every task in Changed.
+     */
+    void vidMoveToState(const std::vector<const Task *> &Changed, TaskState State);
+
+    /**
+     * @brief Collects the IDs of the tasks matching a filter.
+     *
+     * @param Filter Conditions to match.
+     * @return Matching task IDs, ordered by due date and then ID.
+     */
+    std::vector<int> Select(const TaskFilter &Filter) const;
+};
+
+#endif // __TASK__SECONDARY__INDEX__
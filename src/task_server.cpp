@@ -0,0 +1,641 @@
+/**
+ * @file task_server.cpp
+ * @brief Implementation of the TaskServer class and its client.
+ *
+ * The event loop is level-triggered: a connection is watched for input until
+ * the client shuts down its side, except while it is backlogged, and for
+ * writability while it has output the socket did not take or backlogged
+ * work. Each pass reads every ready connection, runs the command lines it
+ * got until its output reaches the high-water mark, commits the journal once
+ * if anything ran, and then sends the responses. SIGINT and SIGTERM arrive
+ * through a signalfd in the same loop, so a stop request is handled between
+ * passes and never in the middle of a batch.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_server.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define TASK_HAS_SOCKETS 1
+#else
+#define TASK_HAS_SOCKETS 0
+#endif
+
+#if defined(__linux__)
+#include <csignal>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#define TASK_HAS_EPOLL 1
+#else
+#define TASK_HAS_EPOLL 0
+#endif
+
+/**
+ * @brief Number of bytes read from a socket at a time.
+ */
+static constexpr std::size_t TASK_SERVER_READ_SIZE = 1 << 16;
+
+/**
+ * @brief Most events handled per pass of the event loop.
+ */
+static constexpr int TASK_SERVER_MAX_EVENTS = 64;
+
+/**
+ * @brief Prefix of TCP addresses.
+ */
+static constexpr std::string_view TASK_SERVER_TCP_PREFIX = "tcp:";
+
+/**
+ * @brief Start of the result line of a failed command.
+ */
+static constexpr std::string_view TASK_SERVER_ERROR_PREFIX = "ERROR ";
+
+#if TASK_HAS_SOCKETS
+
+/**
+ * @brief Permission bits masked off the Unix socket, so only its owner can connect.
+ */
+static constexpr mode_t TASK_SERVER_SOCKET_UMASK = 0177;
+
+/**
+ * @brief Creates a socket and fills in the socket address of an address string.
+ *
+ * @param Address "tcp:<port>" or the path of a Unix socket.
+ * @param Storage Receives the socket address.
+ * @param Length Receives the length of the socket address.
+ * @return New socket, or -1 if the address is invalid or no socket could be created.
+ */
+static int CreateSocketFor(const std::string &Address, sockaddr_storage &Storage, socklen_t &Length)
+{
+    std::memset(&Storage, 0, sizeof(Storage));
+    if (Address.compare(0, TASK_SERVER_TCP_PREFIX.size(), TASK_SERVER_TCP_PREFIX) == 0)
+    {
+        const char *Begin = Address.data() + TASK_SERVER_TCP_PREFIX.size();
+        const char *End = Address.data() + Address.size();
+        std::uint16_t Port = 0;
+        auto Result = std::from_chars(Begin, End, Port);
+        if (Result.ec != std::errc() || Result.ptr != End || Port == 0)
+        {
+            return -1;
+        }
+        sockaddr_in *Inet = reinterpret_cast<sockaddr_in *>(&Storage);
+        Inet->sin_family = AF_INET;
+        Inet->sin_port = htons(Port);
+        Inet->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        Length = sizeof(sockaddr_in);
+        return ::socket(AF_INET, SOCK_STREAM, 0);
+    }
+
+    sockaddr_un *Local = reinterpret_cast<sockaddr_un *>(&Storage);
+    if (Address.empty() == true || Address.size() >= sizeof(Local->sun_path))
+    {
+        return -1;
+    }
+    Local->sun_family = AF_UNIX;
+    std::memcpy(Local->sun_path, Address.data(), Address.size());
+    Length = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + Address.size() + 1);
+    return ::socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+#endif // TASK_HAS_SOCKETS
+
+/**
+ * @brief Constructs a server in front of a task manager.
+ *
+ * @param manager Task manager the commands run against; it must stay alive while the server runs.
+ */
+TaskServer::TaskServer(TaskManager &manager) : Manager(manager)
+{
+}
+
+/**
+ * @brief Starts listening on an address.
+ *
+ * A stale Unix socket file left by a server that did not exit cleanly is
+ * replaced, but only if it is a socket and no server answers on it. A new
+ * Unix socket is created with mode 0600, so only its owner can connect.
+ *
+ * @param Address "tcp:<port>" or the path of a Unix socket.
+ * @return true if the server is listening, false otherwise.
+ */
+bool TaskServer::bListen(const std::string &Address)
+{
+#if TASK_HAS_EPOLL
+    sockaddr_storage Storage;
+    socklen_t Length = 0;
+    ListenFd = CreateSocketFor(Address, Storage, Length);
+    if (ListenFd < 0)
+    {
+        std::cerr << "Invalid Server Address " << Address << std::endl;
+        return false;
+    }
+    struct stat Info;
+    if (Storage.ss_family == AF_UNIX && ::lstat(Address.c_str(), &Info) == 0)
+    {
+        if (S_ISSOCK(Info.st_mode) == false)
+        {
+            std::cerr << "Server Address " << Address << " Exists And Is Not A Socket" << std::endl;
+            return false;
+        }
+        int Probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool Running = (Probe >= 0 && ::connect(Probe, reinterpret_cast<sockaddr *>(&Storage), Length) == 0);
+        if (Probe >= 0)
+        {
+            ::close(Probe);
+        }
+        if (Running == true)
+        {
+            std::cerr << "A Server Is Already Running On " << Address << std::endl;
+            return false;
+        }
+        ::unlink(Address.c_str());
+    }
+    else if (Storage.ss_family != AF_UNIX)
+    {
+        int Reuse = 1;
+        ::setsockopt(ListenFd, SOL_SOCKET, SO_REUSEADDR, &Reuse, sizeof(Reuse));
+    }
+    mode_t Mask = ::umask(TASK_SERVER_SOCKET_UMASK);
+    int Bound = ::bind(ListenFd, reinterpret_cast<sockaddr *>(&Storage), Length);
+    ::umask(Mask);
+    if (Bound != 0)
+    {
+        std::cerr << "Error While Listening On " << Address << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (Storage.ss_family == AF_UNIX)
+    {
+        UnixPath = Address;    /*Ours From Now On, Removed On Exit*/
+    }
+    if (::listen(ListenFd, SOMAXCONN) != 0)
+    {
+        std::cerr << "Error While Listening On " << Address << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    ::fcntl(ListenFd, F_SETFL, ::fcntl(ListenFd, F_GETFL) | O_NONBLOCK);
+
+    EpollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event Event{};
+    Event.events = EPOLLIN;
+    Event.data.fd = ListenFd;
+    return EpollFd >= 0 && ::epoll_ctl(EpollFd, EPOLL_CTL_ADD, ListenFd, &Event) == 0;
+#else
+    (void)Address;
+    std::cerr << "Server Mode Is Not Supported On This Platform" << std::endl;
+    return false;
+#endif
+}
+
+/**
+ * @brief Accepts every pending connection.
+ */
+void TaskServer::vidAccept(void)
+{
+#if TASK_HAS_EPOLL
+    while (true)
+    {
+        int Fd = ::accept4(ListenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (Fd < 0)
+        {
+            return;
+        }
+        epoll_event Event{};
+        Event.events = EPOLLIN;
+        Event.data.fd = Fd;
+        if (::epoll_ctl(EpollFd, EPOLL_CTL_ADD, Fd, &Event) != 0)
+        {
+            ::close(Fd);
+            continue;
+        }
+        Connections[Fd].Watched = EPOLLIN;
+    }
+#endif
+}
+
+/**
+ * @brief Reads what a connection sent.
+ *
+ * Reading stops once TASK_SERVER_MAX_LINE bytes wait to be run; the rest
+ * stays in the socket until they are.
+ *
+ * @param Fd Socket of the connection.
+ * @param Client State of the connection.
+ * @return false if the connection failed or sent a line too long, and must be closed.
+ */
+bool TaskServer::bReceive(int Fd, Connection &Client)
+{
+#if TASK_HAS_SOCKETS
+    while (Client.Input.size() < TASK_SERVER_MAX_LINE)
+    {
+        std::size_t Old = Client.Input.size();
+        Client.Input.resize(Old + TASK_SERVER_READ_SIZE);
+        ssize_t Count = ::read(Fd, &Client.Input[Old], TASK_SERVER_READ_SIZE);
+        Client.Input.resize(Old + static_cast<std::size_t>((Count > 0) ? Count : 0));
+        if (Count == 0)
+        {
+            Client.InputClosed = true;
+            break;
+        }
+        if (Count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            return false;
+        }
+    }
+    return Client.Input.size() < TASK_SERVER_MAX_LINE || Client.Input.find('\n') != std::string::npos;
+#else
+    (void)Fd;
+    (void)Client;
+    return false;
+#endif
+}
+
+/**
+ * @brief Runs the command lines a connection sent, until its pending output reaches TASK_SERVER_HIGH_WATER.
+ *
+ * A list, query or search reply is formatted a chunk at a time, and the lines
+ * after it wait until it is complete, so replies keep their order. Input left
+ * without a newline waits for the rest of its line, unless the client has
+ * shut down its side, in which case it is run as the last line.
+ *
+ * @param Client State of the connection.
+ * @return true if any command line ran.
+ */
+bool TaskServer::bRunCommands(Connection &Client)
+{
+    std::size_t Lines = Client.LineNumber;
+    if (Client.Sent > 0)
+    {
+        Client.Output.erase(0, Client.Sent);
+        Client.Sent = 0;
+    }
+    std::string_view Pending = Client.Input;
+    std::size_t NewLine = 0;
+    while (Client.Output.size() < TASK_SERVER_HIGH_WATER)
+    {
+        if (Client.Listing.Pending == true)
+        {
+            bAppendTaskBatchListing(Manager, Client.Listing, Client.Output, TASK_SERVER_HIGH_WATER);
+        }
+        else if ((NewLine = Pending.find('\n')) != std::string_view::npos)
+        {
+            bRunTaskBatchLine(Manager, Pending.substr(0, NewLine), ++Client.LineNumber, Client.Output, nullptr, &Client.Listing);
+            Pending.remove_prefix(NewLine + 1);
+        }
+        else if (Client.InputClosed == true && Pending.empty() == false)
+        {
+            bRunTaskBatchLine(Manager, Pending, ++Client.LineNumber, Client.Output, nullptr, &Client.Listing);
+            Pending = std::string_view();
+        }
+        else
+        {
+            break;
+        }
+    }
+    Client.Input.erase(0, Client.Input.size() - Pending.size());
+    Client.Backlogged = (Client.Listing.Pending == true || Pending.find('\n') != std::string_view::npos ||
+                         (Client.InputClosed == true && Pending.empty() == false));
+    return Client.LineNumber != Lines;
+}
+
+/**
+ * @brief Sends as much pending output of a connection as the socket takes.
+ *
+ * A backlogged connection is not read from, and is watched for writability
+ * even with no output left, so the next pass runs the rest of its work.
+ *
+ * @param Fd Socket of the connection.
+ * @param Client State of the connection.
+ * @return false if the connection is finished or failed and must be closed.
+ */
+bool TaskServer::bSend(int Fd, Connection &Client)
+{
+#if TASK_HAS_EPOLL
+    while (Client.Sent < Client.Output.size())
+    {
+        ssize_t Count = ::send(Fd, Client.Output.data() + Client.Sent, Client.Output.size() - Client.Sent, MSG_NOSIGNAL);
+        if (Count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            return false;
+        }
+        Client.Sent += static_cast<std::size_t>(Count);
+    }
+    if (Client.Sent == Client.Output.size())
+    {
+        Client.Output.clear();
+        Client.Sent = 0;
+    }
+
+    bool Writing = (Client.Output.empty() == false);
+    std::uint32_t Watched = ((Client.InputClosed || Client.Backlogged) ? 0u : static_cast<std::uint32_t>(EPOLLIN)) |
+                            ((Writing || Client.Backlogged) ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+    if (Watched != Client.Watched)
+    {
+        epoll_event Event{};
+        Event.events = Watched;
+        Event.data.fd = Fd;
+        ::epoll_ctl(EpollFd, EPOLL_CTL_MOD, Fd, &Event);
+        Client.Watched = Watched;
+    }
+    return Writing == true || Client.Backlogged == true || Client.InputClosed == false;
+#else
+    (void)Fd;
+    (void)Client;
+    return false;
+#endif
+}
+
+/**
+ * @brief Closes a connection and forgets its state.
+ *
+ * @param Fd Socket of the connection.
+ */
+void TaskServer::vidClose(int Fd)
+{
+#if TASK_HAS_SOCKETS
+    ::close(Fd);
+#endif
+    Connections.erase(Fd);
+}
+
+/**
+ * @brief Blocks SIGINT and SIGTERM in the calling thread and in every thread it starts afterwards.
+ */
+void vidBlockTaskServerSignals(void)
+{
+#if TASK_HAS_EPOLL
+    sigset_t Signals;
+    sigemptyset(&Signals);
+    sigaddset(&Signals, SIGINT);
+    sigaddset(&Signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &Signals, nullptr);
+#endif
+}
+
+/**
+ * @brief Serves connections until SIGINT or SIGTERM is received.
+ *
+ * Responses are sent only after the journal commit that covers them, so a
+ * client never sees "OK" for a mutation that could still be lost. The signals
+ * stay blocked on return, so a second one cannot cut short the final save.
+ */
+void TaskServer::vidRun(void)
+{
+#if TASK_HAS_EPOLL
+    sigset_t Signals;
+    sigemptyset(&Signals);
+    sigaddset(&Signals, SIGINT);
+    sigaddset(&Signals, SIGTERM);
+    SignalFd = ::signalfd(-1, &Signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    epoll_event SignalEvent{};
+    SignalEvent.events = EPOLLIN;
+    SignalEvent.data.fd = SignalFd;
+    ::epoll_ctl(EpollFd, EPOLL_CTL_ADD, SignalFd, &SignalEvent);
+
+    epoll_event Events[TASK_SERVER_MAX_EVENTS];
+    std::vector<int> Ready;
+    bool Running = true;
+    Manager.BeginBatch();
+    while (Running == true)
+    {
+        int Count = ::epoll_wait(EpollFd, Events, TASK_SERVER_MAX_EVENTS, -1);
+        if (Count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        Ready.clear();
+        bool Ran = false;
+        for (int Index = 0; Index < Count; ++Index)
+        {
+            int Fd = Events[Index].data.fd;
+            if (Fd == SignalFd)
+            {
+                signalfd_siginfo Info;
+                while (::read(SignalFd, &Info, sizeof(Info)) == static_cast<ssize_t>(sizeof(Info)))
+                {
+                }
+                Running = false;
+                continue;
+            }
+            if (Fd == ListenFd)
+            {
+                vidAccept();
+                continue;
+            }
+            auto it = Connections.find(Fd);
+            if (it == Connections.end())
+            {
+                continue;
+            }
+            if (it->second.InputClosed == false && it->second.Backlogged == false &&
+                (Events[Index].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0 && bReceive(Fd, it->second) == false)
+            {
+                vidClose(Fd);
+                continue;
+            }
+            Ready.push_back(Fd);
+        }
+        for (int Fd : Ready)
+        {
+            auto it = Connections.find(Fd);
+            if (it != Connections.end() && bRunCommands(it->second) == true)
+            {
+                Ran = true;
+            }
+        }
+
+        if (Ran == true)
+        {
+            Manager.Commit();
+        }
+        for (int Fd : Ready)
+        {
+            auto it = Connections.find(Fd);
+            if (it != Connections.end() && bSend(Fd, it->second) == false)
+            {
+                vidClose(Fd);
+            }
+        }
+    }
+    Manager.EndBatch();
+#endif
+}
+
+/**
+ * @brief Closes every connection and the listening socket.
+ */
+TaskServer::~TaskServer()
+{
+#if TASK_HAS_SOCKETS
+    for (auto &Entry : Connections)
+    {
+        ::close(Entry.first);
+    }
+    for (int Fd : {SignalFd, EpollFd, ListenFd})
+    {
+        if (Fd >= 0)
+        {
+            ::close(Fd);
+        }
+    }
+    if (UnixPath.empty() == false)
+    {
+        ::unlink(UnixPath.c_str());
+    }
+#endif
+}
+
+/**
+ * @brief Sends a stream of batch commands to a server and writes back its results.
+ *
+ * Commands are read in blocks and written while results are read, and the
+ * sending side is shut down after the last command, which tells the server to
+ * close the connection once every result is sent.
+ *
+ * @param Address "tcp:<port>" or the path of a Unix socket.
+ * @param In Stream the commands are read from.
+ * @param Out Stream the results are written to.
+ * @param Failed Receives the number of commands that failed, counted from the result lines starting with "ERROR ".
+ * @return true if the whole exchange took place, false if the server could not be reached or hung up early.
+ */
+bool bRunTaskClient(const std::string &Address, std::istream &In, std::ostream &Out, std::size_t &Failed)
+{
+    Failed = 0;
+#if TASK_HAS_SOCKETS
+    sockaddr_storage Storage;
+    socklen_t Length = 0;
+    int Fd = CreateSocketFor(Address, Storage, Length);
+    if (Fd < 0 || ::connect(Fd, reinterpret_cast<sockaddr *>(&Storage), Length) != 0)
+    {
+        std::cerr << "Error While Connecting To " << Address << std::endl;
+        if (Fd >= 0)
+        {
+            ::close(Fd);
+        }
+        return false;
+    }
+
+    std::vector<char> Request(TASK_SERVER_READ_SIZE);
+    std::vector<char> Response(TASK_SERVER_READ_SIZE);
+    std::size_t RequestSize = 0;
+    std::size_t RequestSent = 0;
+    bool Sending = true;
+    bool Complete = true;
+    std::size_t Matched = 0;    /*Bytes Of The Error Prefix At The Start Of The Current Line*/
+    bool Decided = false;
+    while (true)
+    {
+        if (Sending == true && RequestSent == RequestSize)
+        {
+            In.read(Request.data(), static_cast<std::streamsize>(Request.size()));
+            RequestSize = static_cast<std::size_t>(In.gcount());
+            RequestSent = 0;
+            if (RequestSize == 0)
+            {
+                ::shutdown(Fd, SHUT_WR);
+                Sending = false;
+            }
+        }
+
+        pollfd Watch{Fd, static_cast<short>(POLLIN | (Sending ? POLLOUT : 0)), 0};
+        if (::poll(&Watch, 1, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            Complete = false;
+            break;
+        }
+        if ((Watch.revents & POLLOUT) != 0)
+        {
+            ssize_t Count = ::send(Fd, Request.data() + RequestSent, RequestSize - RequestSent, MSG_NOSIGNAL);
+            if (Count < 0 && errno != EINTR && errno != EAGAIN)
+            {
+                Complete = false;
+                break;
+            }
+            RequestSent += static_cast<std::size_t>((Count > 0) ? Count : 0);
+        }
+        if ((Watch.revents & (POLLIN | POLLHUP | POLLERR)) != 0)
+        {
+            ssize_t Count = ::read(Fd, Response.data(), Response.size());
+            if (Count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (Count <= 0)
+            {
+                Complete = (Count == 0 && Sending == false);
+                break;
+            }
+            for (ssize_t Index = 0; Index < Count; ++Index)
+            {
+                if (Response[Index] == '\n')
+                {
+                    Matched = 0;
+                    Decided = false;
+                }
+                else if (Decided == false)
+                {
+                    if (Response[Index] != TASK_SERVER_ERROR_PREFIX[Matched])
+                    {
+                        Decided = true;
+                    }
+                    else if (++Matched == TASK_SERVER_ERROR_PREFIX.size())
+                    {
+                        ++Failed;
+                        Decided = true;
+                    }
+                }
+            }
+            Out.write(Response.data(), Count);
+        }
+    }
+    ::close(Fd);
+    Out.flush();
+    if (Complete == false)
+    {
+        std::cerr << "Connection To " << Address << " Was Lost" << std::endl;
+    }
+    return Complete;
+#else
+    (void)In;
+    (void)Out;
+    std::cerr << "Client Mode Is Not Supported On This Platform" << std::endl;
+    return false;
+#endif
+}
@@ -0,0 +1,168 @@
+/**
+ * @file task_server.hpp
+ * @brief Declaration of the TaskServer class, a resident task manager serving batch commands over a socket.
+ *
+ * The server keeps one TaskManager loaded and answers the batch protocol of
+ * task_batch.hpp on a Unix domain socket or a localhost TCP port, so each
+ * request costs one command instead of loading and saving the whole file.
+ * Every command line gets its results back ending with one "OK" or "ERROR"
+ * line, and commands from one connection run in the order they were sent.
+ *
+ * A single thread runs an epoll event loop over non-blocking sockets. The
+ * commands read in one pass of the loop, over all connections, share one
+ * journal commit, and their responses are sent only after it. A client that
+ * does not read its responses stops being read from once TASK_SERVER_HIGH_WATER
+ * bytes wait for it, and list, query and search replies are formatted in
+ * chunks of that size as the client takes them.
+ *
+ * Addresses are either "tcp:<port>", for 127.0.0.1, or the path of a Unix socket.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__SERVER__
+#define __TASK__SERVER__
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include "task_batch.hpp"
+#include "task_manager.hpp"
+
+/**
+ * @brief Longest command line a connection may send before it is dropped.
+ */
+constexpr std::size_t TASK_SERVER_MAX_LINE = 1 << 20;
+
+/**
+ * @brief Bytes of output waiting for a connection past which no further command of it runs.
+ */
+constexpr std::size_t TASK_SERVER_HIGH_WATER = 1 << 20;
+
+/**
+ * @class TaskServer
+ * @brief Serves batch commands against one resident task manager.
+ */
+class TaskServer
+{
+private:
+    /**
+     * @struct Connection
+     * @brief State of one client connection.
+     */
+    struct Connection
+    {
+        std::string Input;              /**< Bytes received but not yet run, starting at a line boundary. */
+        std::string Output;             /**< Results waiting to be sent. */
+        std::size_t Sent = 0;           /**< Bytes of Output already sent. */
+        std::size_t LineNumber = 0;     /**< Command lines received so far, reported in errors. */
+        bool InputClosed = false;       /**< true once the client shut down its side. */
+        bool Backlogged = false;        /**< true while commands or a listing wait for the output to drain. */
+        std::uint32_t Watched = 0;      /**< Events the socket is currently watched for. */
+        TaskBatchListing Listing;       /**< Reply of a list, query or search command still being formatted. */
+    };
+
+    TaskManager &Manager;                               /**< Task manager the commands run against. */
+    std::string UnixPath;                               /**< Path of the Unix socket to remove on exit, if any. */
+    int ListenFd = -1;                                  /**< Listening socket. */
+    int EpollFd = -1;                                   /**< Event loop instance. */
+    int SignalFd = -1;                                  /**< Receives SIGINT and SIGTERM while serving. */
+    std::unordered_map<int, Connection> Connections;    /**< Open connections by socket. */
+
+    /**
+     * @brief Accepts every pending connection.
+     */
+    void vidAccept(void);
+
+    /**
+     * @brief Reads what a connection sent.
+     *
+     * @param Fd Socket of the connection.
+     * @param Client State of the connection.
+     * @return false if the connection failed or sent a line too long, and must be closed.
+     */
+    bool bReceive(int Fd, Connection &Client);
+
+    /**
+     * @brief Runs the command lines a connection sent, until its pending output reaches TASK_SERVER_HIGH_WATER.
+     *
+     * @param Client State of the connection.
+     * @return true if any command line ran.
+     */
+    bool bRunCommands(Connection &Client);
+
+    /**
+     * @brief Sends as much pending output of a connection as the socket takes.
+     *
+     * @param Fd Socket of the connection.
+     * @param Client State of the connection.
+     * @return false if the connection is finished or failed and must be closed.
+     */
+    bool bSend(int Fd, Connection &Client);
+
+    /**
+     * @brief Closes a connection and forgets its state.
+     *
+     * @param Fd Socket of the connection.
+     */
+    void vidClose(int Fd);
+
+public:
+    /**
+     * @brief Constructs a server in front of a task manager.
+     *
+     * @param manager Task manager the commands run against; it must stay alive while the server runs.
+     */
+    explicit TaskServer(TaskManager &manager);
+
+    TaskServer(const TaskServer &) = delete;
+    TaskServer &operator=(const TaskServer &) = delete;
+
+    /**
+     * @brief Starts listening on an address.
+     *
+     * @param Address "tcp:<port>" or the path of a Unix socket.
+     * @return true if the server is listening, false otherwise.
+     */
+    bool bListen(const std::string &Address);
+
+    /**
+     * @brief Serves connections until SIGINT or SIGTERM is received.
+     *
+     * Mutations are journaled in batches committed once per pass of the loop.
+     * The signals must have been blocked with vidBlockTaskServerSignals().
+     */
+    void vidRun(void);
+
+    /**
+     * @brief Closes every connection and the listening socket.
+     */
+    ~TaskServer();
+};
+
+/**
+ * @brief Blocks SIGINT and SIGTERM in the calling thread and in every thread it starts afterwards.
+ *
+ * TaskServer::vidRun() takes these signals from a signalfd, which only sees
+ * them if no thread of the process can receive them. Call it before starting
+ * any thread: the metrics dumper, the journal sync and compaction threads and
+ * the loaders all inherit the mask of the thread that creates them.
+ */
+void vidBlockTaskServerSignals(void);
+
+/**
+ * @brief Sends a stream of batch commands to a server and writes back its results.
+ *
+ * Commands are streamed to the server while its results are read, so large
+ * batches are pipelined rather than sent one round trip at a time.
+ *
+ * @param Address "tcp:<port>" or the path of a Unix socket.
+ * @param In Stream the commands are read from.
+ * @param Out Stream the results are written to.
+ * @param Failed Receives the number of commands that failed.
+ * @return true if the whole exchange took place, false if the server could not be reached or hung up early.
+ */
+bool bRunTaskClient(const std::string &Address, std::istream &In, std::ostream &Out, std::size_t &Failed);
+
+#endif // __TASK__SERVER__
@@ -0,0 +1,863 @@
+/**
+ * @file task_snapshot.cpp
+ * @brief Implementation of the compressed, block-structured task snapshot format.
+ *
+ * Saving cuts the task list into blocks of about TASK_SNAPSHOT_BLOCK_TEXT
+ * bytes of text, encodes and compresses them on several threads, and writes
+ * them out in order followed by the block index. Loading maps the file,
+ * verifies the index, and decodes the blocks on several threads, each into
+ * its own arena, before moving the tasks into the caller's list in order.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_snapshot.hpp"
+#include "block_codec.hpp"
+#include "task_binary.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <thread>
+
+/**
+ * @brief Magic bytes identifying a snapshot file.
+ */
+static const char TASK_SNAPSHOT_MAGIC[8] = {'T', 'A', 'S', 'K', 'S', 'N', 'P', '\0'};
+
+/**
+ * @brief Bytes of title and description text a block is filled to before the next one starts.
+ *
+ * Large enough for the codec to find repeats across many tasks, small enough
+ * for a block to stay in L2 while it is decoded, and for lazy readers to
+ * fault in little more than the tasks they need.
+ */
+static constexpr std::size_t TASK_SNAPSHOT_BLOCK_TEXT = 128 * 1024;
+
+/**
+ * @brief Largest number of tasks in one block, for tasks with little or no text.
+ */
+static constexpr std::size_t TASK_SNAPSHOT_BLOCK_TASKS = 8192;
+
+/**
+ * @brief Number of header bytes covered by the header checksum.
+ */
+static constexpr std::size_t TASK_SNAPSHOT_HEADER_FIELDS = TASK_SNAPSHOT_HEADER_SIZE - 8;
+
+/**
+ * @brief Block flag set when the metadata section is compressed.
+ */
+static constexpr std::uint32_t TASK_SNAPSHOT_META_COMPRESSED = 1;
+
+/**
+ * @brief Block flag set when the text section is compressed.
+ */
+static constexpr std::uint32_t TASK_SNAPSHOT_TEXT_COMPRESSED = 2;
+
+/**
+ * @brief A block once encoded, waiting to be written.
+ */
+struct EncodedBlock
+{
+    TaskSnapshotBlock Entry;    /**< Index entry of the block, but for its offset. */
+    std::string Bytes;          /**< Stored metadata section followed by the stored text section. */
+};
+
+/**
+ * @brief Appends an unsigned integer as a varint: seven bits per byte, low bits first.
+ *
+ * @param Out Buffer the bytes are appended to.
+ * @param Value Integer to append.
+ */
+static void vidWriteVarint(std::string &Out, std::uint64_t Value)
+{
+    while (Value >= 0x80)
+    {
+        Out.push_back(static_cast<char>((Value & 0x7F) | 0x80));
+        Value >>= 7;
+    }
+    Out.push_back(static_cast<char>(Value));
+}
+
+/**
+ * @brief Reads a varint.
+ *
+ * @param Data Next byte to read, advanced past the varint.
+ * @param End End of the readable bytes.
+ * @param Value Receives the integer.
+ * @return true if a whole varint of at most ten bytes was read.
+ */
+static bool bReadVarint(const unsigned char *&Data, const unsigned char *End, std::uint64_t &Value)
+{
+    Value = 0;
+    for (unsigned Shift = 0; Shift < 64 && Data < End; Shift += 7)
+    {
+        unsigned char Byte = *Data++;
+        Value |= static_cast<std::uint64_t>(Byte & 0x7F) << Shift;
+        if ((Byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Maps a signed difference to an unsigned one, small in magnitude either way.
+ *
+ * @param Value Signed integer.
+ * @return 0, -1, 1, -2, 2... mapped to 0, 1, 2, 3, 4...
+ */
+static std::uint64_t u64ZigZag(std::int64_t Value)
+{
+    return (static_cast<std::uint64_t>(Value) << 1) ^ static_cast<std::uint64_t>(Value >> 63);
+}
+
+/**
+ * @brief Reverses u64ZigZag().
+ *
+ * @param Value Unsigned integer.
+ * @return Signed integer it stands for.
+ */
+static std::int64_t int64UnZigZag(std::uint64_t Value)
+{
+    return static_cast<std::int64_t>(Value >> 1) ^ -static_cast<std::int64_t>(Value & 1);
+}
+
+/**
+ * @brief Appends a low-cardinality column: its distinct values, then one bit-packed code per row.
+ *
+ * Codes are as wide as needed to number the distinct values, so a column with
+ * one value takes no bits per row, two values one bit, up to four two bits.
+ *
+ * @param Out Buffer the column is appended to.
+ * @param Values One byte per row.
+ */
+static void vidWriteDictionary(std::string &Out, const std::vector<std::uint8_t> &Values)
+{
+    std::uint8_t Codes[256];
+    std::vector<std::uint8_t> Dictionary;
+    for (std::uint8_t Value : Values)
+    {
+        if (std::find(Dictionary.begin(), Dictionary.end(), Value) == Dictionary.end())
+        {
+            Dictionary.push_back(Value);
+        }
+    }
+    Out.push_back(static_cast<char>(Dictionary.size()));
+    for (std::size_t Code = 0; Code < Dictionary.size(); ++Code)
+    {
+        Out.push_back(static_cast<char>(Dictionary[Code]));
+        Codes[Dictionary[Code]] = static_cast<std::uint8_t>(Code);
+    }
+    unsigned Width = 0;
+    while ((std::size_t{1} << Width) < Dictionary.size())
+    {
+        ++Width;
+    }
+    if (Width == 0)
+    {
+        return;
+    }
+    std::size_t Start = Out.size();
+    Out.resize(Start + (Values.size() * Width + 7) / 8, '\0');
+    for (std::size_t Row = 0; Row < Values.size(); ++Row)
+    {
+        std::size_t Bit = Row * Width;
+        unsigned Code = Codes[Values[Row]];
+        for (unsigned Index = 0; Index < Width; ++Index, ++Bit)
+        {
+            Out[Start + Bit / 8] = static_cast<char>(static_cast<unsigned char>(Out[Start + Bit / 8]) | (((Code >> Index) & 1u) << (Bit % 8)));
+        }
+    }
+}
+
+/**
+ * @brief Reads a column written by vidWriteDictionary().
+ *
+ * @param Data Next byte to read, advanced past the column.
+ * @param End End of the readable bytes.
+ * @param Count Number of rows.
+ * @param Values Receives one byte per row.
+ * @return true if the whole column was read.
+ */
+static bool bReadDictionary(const unsigned char *&Data, const unsigned char *End, std::size_t Count, std::vector<std::uint8_t> &Values)
+{
+    if (Data >= End)
+    {
+        return false;
+    }
+    std::size_t Size = *Data++;
+    if ((Size == 0 && Count != 0) || static_cast<std::size_t>(End - Data) < Size)
+    {
+        return false;
+    }
+    const unsigned char *Dictionary = Data;
+    Data += Size;
+    unsigned Width = 0;
+    while ((std::size_t{1} << Width) < Size)
+    {
+        ++Width;
+    }
+    std::size_t Bytes = (Count * Width + 7) / 8;
+    if (static_cast<std::size_t>(End - Data) < Bytes)
+    {
+        return false;
+    }
+    Values.resize(Count);
+    for (std::size_t Row = 0; Row < Count; ++Row)
+    {
+        std::size_t Bit = Row * Width;
+        unsigned Code = 0;
+        for (unsigned Index = 0; Index < Width; ++Index, ++Bit)
+        {
+            Code |= ((Data[Bit / 8] >> (Bit % 8)) & 1u) << Index;
+        }
+        if (Code >= Size)
+        {
+            return false;
+        }
+        Values[Row] = Dictionary[Code];
+    }
+    Data += Bytes;
+    return true;
+}
+
+/**
+ * @brief Appends a section, compressed unless that does not make it smaller.
+ *
+ * @param Out Buffer the section is appended to.
+ * @param Raw Bytes of the section.
+ * @param Compressed Receives true if the section was stored compressed.
+ * @return Number of bytes appended.
+ */
+static std::size_t u64StoreSection(std::string &Out, const std::string &Raw, bool &Compressed)
+{
+    std::size_t Start = Out.size();
+    std::size_t Size = u64CompressBlock(Raw.data(), Raw.size(), Out);
+    Compressed = Size < Raw.size();
+    if (Compressed == false)
+    {
+        Out.resize(Start);
+        Out.append(Raw);
+        Size = Raw.size();
+    }
+    return Size;
+}
+
+/**
+ * @brief Encodes and compresses one block of tasks.
+ *
+ * @param Begin First task of the block.
+ * @param End Past the last task of the block; tombstones in the range are skipped.
+ * @param Block Receives the encoded block.
+ */
+static void vidEncodeBlock(const Task *Begin, const Task *End, EncodedBlock &Block)
+{
+    std::string Meta;
+    std::string Text;
+    std::vector<std::uint8_t> States;
+    std::vector<std::uint8_t> Priorities;
+    std::uint32_t Count = 0;
+    for (const Task *it = Begin; it != End; ++it)
+    {
+        if (it->bIsRemoved() == false)
+        {
+            ++Count;
+        }
+    }
+    States.reserve(Count);
+    Priorities.reserve(Count);
+    vidWriteVarint(Meta, Count);
+
+    std::int64_t Previous = 0;
+    bool First = true;
+    for (const Task *it = Begin; it != End; ++it)
+    {
+        if (it->bIsRemoved() == true)
+        {
+            continue;
+        }
+        vidWriteVarint(Meta, u64ZigZag(static_cast<std::int64_t>(it->int32GetTaskID()) - Previous));
+        Previous = it->int32GetTaskID();
+        Block.Entry.FirstId = (First == true) ? Previous : std::min<std::int32_t>(Block.Entry.FirstId, Previous);
+        Block.Entry.LastId = (First == true) ? Previous : std::max<std::int32_t>(Block.Entry.LastId, Previous);
+        First = false;
+        States.push_back(static_cast<std::uint8_t>(it->GetTaskState()));
+        Priorities.push_back(static_cast<std::uint8_t>(it->GetTaskPriority()));
+    }
+    vidWriteDictionary(Meta, States);
+    vidWriteDictionary(Meta, Priorities);
+    Previous = 0;
+    for (const Task *it = Begin; it != End; ++it)
+    {
+        if (it->bIsRemoved() == false)
+        {
+            vidWriteVarint(Meta, u64ZigZag(static_cast<std::int64_t>(it->int32GetDueDay()) - Previous));
+            Previous = it->int32GetDueDay();
+        }
+    }
+    for (const Task *it = Begin; it != End; ++it)
+    {
+        if (it->bIsRemoved() == false)
+        {
+            vidWriteVarint(Meta, it->int32GetTaskTitle().size());
+            Text.append(it->int32GetTaskTitle());
+        }
+    }
+    for (const Task *it = Begin; it != End; ++it)
+    {
+        if (it->bIsRemoved() == false)
+        {
+            vidWriteVarint(Meta, it->int32GetTaskDescription().size());
+            Text.append(it->int32GetTaskDescription());
+        }
+    }
+
+    bool MetaCompressed = false;
+    bool TextCompressed = false;
+    Block.Bytes.reserve(u64CompressBound(Meta.size()) + u64CompressBound(Text.size()));
+    Block.Entry.MetaStored = static_cast<std::uint32_t>(u64StoreSection(Block.Bytes, Meta, MetaCompressed));
+    Block.Entry.TextStored = static_cast<std::uint32_t>(u64StoreSection(Block.Bytes, Text, TextCompressed));
+    Block.Entry.MetaRaw = static_cast<std::uint32_t>(Meta.size());
+    Block.Entry.TextRaw = static_cast<std::uint32_t>(Text.size());
+    Block.Entry.Count = Count;
+    Block.Entry.Flags = (MetaCompressed ? TASK_SNAPSHOT_META_COMPRESSED : 0) | (TextCompressed ? TASK_SNAPSHOT_TEXT_COMPRESSED : 0);
+    Block.Entry.MetaChecksum = u64Checksum(Block.Bytes.data(), Block.Entry.MetaStored);
+    Block.Entry.TextChecksum = u64Checksum(Block.Bytes.data() + Block.Entry.MetaStored, Block.Entry.TextStored);
+}
+
+/**
+ * @brief Maps a snapshot file and reads its block index.
+ *
+ * The header and index checksum is verified, and every block is checked to
+ * lie within the file, so that blocks can later be read without more checks
+ * than their own checksum. An empty file is a valid, empty snapshot.
+ *
+ * @param filename Name of the snapshot file.
+ */
+TaskSnapshotReader::TaskSnapshotReader(const std::string &filename)
+    : File(filename)
+{
+    if (File.bIsOpen() == false)
+    {
+        return;
+    }
+    std::string_view Content = File.View();
+    if (Content.empty() == true)
+    {
+        Valid = true;
+        return;
+    }
+    if (Content.size() < TASK_SNAPSHOT_HEADER_SIZE ||
+        std::memcmp(Content.data(), TASK_SNAPSHOT_MAGIC, sizeof(TASK_SNAPSHOT_MAGIC)) != 0)
+    {
+        return;
+    }
+    BinaryReader Header(Content.data() + sizeof(TASK_SNAPSHOT_MAGIC), TASK_SNAPSHOT_HEADER_SIZE - sizeof(TASK_SNAPSHOT_MAGIC));
+    std::uint32_t Version = Header.u32Read();
+    std::uint32_t HeaderNextId = Header.u32Read();
+    std::uint64_t Count = Header.u64Read();
+    std::uint32_t BlockCount = Header.u32Read();
+    Header.u32Read();
+    std::uint64_t IndexOffset = Header.u64Read();
+    std::uint64_t Checksum = Header.u64Read();
+    if (Version != TASK_SNAPSHOT_VERSION || HeaderNextId > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) ||
+        IndexOffset < TASK_SNAPSHOT_HEADER_SIZE || IndexOffset > Content.size() ||
+        (Content.size() - IndexOffset) / TASK_SNAPSHOT_INDEX_ENTRY_SIZE != BlockCount ||
+        (Content.size() - IndexOffset) % TASK_SNAPSHOT_INDEX_ENTRY_SIZE != 0)
+    {
+        return;
+    }
+    std::uint64_t Expected = u64Checksum(Content.data(), TASK_SNAPSHOT_HEADER_FIELDS);
+    if (u64Checksum(Content.data() + IndexOffset, Content.size() - IndexOffset, Expected) != Checksum)
+    {
+        return;
+    }
+
+    BinaryReader Index(Content.data() + IndexOffset, Content.size() - IndexOffset);
+    Blocks.resize(BlockCount);
+    std::uint64_t Total = 0;
+    for (auto &Block : Blocks)
+    {
+        Block.Offset = Index.u64Read();
+        Block.MetaStored = Index.u32Read();
+        Block.MetaRaw = Index.u32Read();
+        Block.TextStored = Index.u32Read();
+        Block.TextRaw = Index.u32Read();
+        Block.Count = Index.u32Read();
+        Block.Flags = Index.u32Read();
+        Block.FirstId = static_cast<std::int32_t>(Index.u32Read());
+        Block.LastId = static_cast<std::int32_t>(Index.u32Read());
+        Block.MetaChecksum = Index.u64Read();
+        Block.TextChecksum = Index.u64Read();
+        if (Block.Offset < TASK_SNAPSHOT_HEADER_SIZE || Block.Offset > IndexOffset ||
+            static_cast<std::uint64_t>(Block.MetaStored) + Block.TextStored > IndexOffset - Block.Offset)
+        {
+            Blocks.clear();
+            return;
+        }
+        Total += Block.Count;
+    }
+    if (Index.bFailed() == true || Total != Count)
+    {
+        Blocks.clear();
+        return;
+    }
+    TaskCount = Count;
+    NextId = static_cast<int>(HeaderNextId);
+    Valid = true;
+}
+
+/**
+ * @brief Tells whether the file is a valid snapshot.
+ *
+ * @return true if the header and block index were read and verified; an empty file is a valid, empty snapshot.
+ */
+bool TaskSnapshotReader::bIsValid(void) const
+{
+    return Valid;
+}
+
+/**
+ * @brief Gets the number of tasks in the snapshot.
+ *
+ * @return Task count.
+ */
+std::uint64_t TaskSnapshotReader::u64GetTaskCount(void) const
+{
+    return TaskCount;
+}
+
+/**
+ * @brief Gets the next task ID recorded in the snapshot.
+ *
+ * @return Next ID, or 0 for an empty file.
+ */
+int TaskSnapshotReader::int32GetNextId(void) const
+{
+    return NextId;
+}
+
+/**
+ * @brief Gets the block index.
+ *
+ * @return One entry per block, in file order.
+ */
+const std::vector<TaskSnapshotBlock> &TaskSnapshotReader::GetBlocks(void) const
+{
+    return Blocks;
+}
+
+/**
+ * @brief Verifies the checksum of a section of a block and gets it decompressed.
+ *
+ * Each section has a checksum of its own, so reading the metadata of a block
+ * never costs a pass over its text.
+ *
+ * @param Index Index of the block.
+ * @param Text true for the text section, false for the metadata section.
+ * @param Out Receives the decompressed section.
+ * @return true if the section is intact and decompressed to its recorded size.
+ */
+bool TaskSnapshotReader::bReadSection(std::size_t Index, bool Text, std::string &Out) const
+{
+    if (Index >= Blocks.size())
+    {
+        return false;
+    }
+    const TaskSnapshotBlock &Block = Blocks[Index];
+    const char *Data = File.View().data() + Block.Offset;
+    const char *Source = (Text == true) ? Data + Block.MetaStored : Data;
+    std::size_t Stored = (Text == true) ? Block.TextStored : Block.MetaStored;
+    std::size_t Raw = (Text == true) ? Block.TextRaw : Block.MetaRaw;
+    std::uint32_t Flag = (Text == true) ? TASK_SNAPSHOT_TEXT_COMPRESSED : TASK_SNAPSHOT_META_COMPRESSED;
+    if (u64Checksum(Source, Stored) != ((Text == true) ? Block.TextChecksum : Block.MetaChecksum))
+    {
+        return false;
+    }
+    if ((Block.Flags & Flag) == 0)
+    {
+        if (Stored != Raw)
+        {
+            return false;
+        }
+        Out.assign(Source, Stored);
+        return true;
+    }
+    Out.resize(Raw);
+    return bDecompressBlock(Source, Stored, Out.data(), Raw);
+}
+
+/**
+ * @brief Decodes the metadata section of a block only.
+ *
+ * Every column is checked against the task count of the block, and the text
+ * lengths against the size of its text section.
+ *
+ * @param Index Index of the block.
+ * @param Meta Receives the columns of the block.
+ * @return true on success, false if the block is corrupt.
+ */
+bool TaskSnapshotReader::bReadMeta(std::size_t Index, TaskSnapshotMeta &Meta) const
+{
+    std::string Raw;
+    if (bReadSection(Index, false, Raw) == false)
+    {
+        return false;
+    }
+    const unsigned char *Data = reinterpret_cast<const unsigned char *>(Raw.data());
+    const unsigned char *End = Data + Raw.size();
+    std::uint64_t Value = 0;
+    if (bReadVarint(Data, End, Value) == false || Value != Blocks[Index].Count)
+    {
+        return false;
+    }
+    std::size_t Count = static_cast<std::size_t>(Value);
+
+    Meta.Ids.resize(Count);
+    std::int64_t Previous = 0;
+    for (auto &id : Meta.Ids)
+    {
+        if (bReadVarint(Data, End, Value) == false)
+        {
+            return false;
+        }
+        Previous += int64UnZigZag(Value);
+        if (Previous < 0 || Previous > std::numeric_limits<std::int32_t>::max())
+        {
+            return false;
+        }
+        id = static_cast<std::int32_t>(Previous);
+    }
+
+    std::vector<std::uint8_t> Column;
+    if (bReadDictionary(Data, End, Count, Column) == false)
+    {
+        return false;
+    }
+    Meta.States.resize(Count);
+    for (std::size_t Row = 0; Row < Count; ++Row)
+    {
+        if (Column[Row] > static_cast<std::uint8_t>(TaskState::Done))
+        {
+            return false;
+        }
+        Meta.States[Row] = static_cast<TaskState>(Column[Row]);
+    }
+    if (bReadDictionary(Data, End, Count, Column) == false)
+    {
+        return false;
+    }
+    Meta.Priorities.resize(Count);
+    for (std::size_t Row = 0; Row < Count; ++Row)
+    {
+        if (Column[Row] > static_cast<std::uint8_t>(TaskPriority::High))
+        {
+            return false;
+        }
+        Meta.Priorities[Row] = static_cast<TaskPriority>(Column[Row]);
+    }
+
+    Meta.DueDays.resize(Count);
+    Previous = 0;
+    for (auto &Day : Meta.DueDays)
+    {
+        if (bReadVarint(Data, End, Value) == false)
+        {
+            return false;
+        }
+        Previous += int64UnZigZag(Value);
+        if (Previous < std::numeric_limits<std::int32_t>::min() || Previous > std::numeric_limits<std::int32_t>::max())
+        {
+            return false;
+        }
+        Day = static_cast<std::int32_t>(Previous);
+    }
+
+    std::uint64_t Offset = 0;
+    for (auto *Offsets : {&Meta.TitleOffsets, &Meta.DescOffsets})
+    {
+        Offsets->resize(Count + 1);
+        for (std::size_t Row = 0; Row < Count; ++Row)
+        {
+            (*Offsets)[Row] = static_cast<std::uint32_t>(Offset);
+            if (bReadVarint(Data, End, Value) == false || Value > Blocks[Index].TextRaw - Offset)
+            {
+                return false;
+            }
+            Offset += Value;
+        }
+        (*Offsets)[Count] = static_cast<std::uint32_t>(Offset);
+    }
+    return Data == End && Offset == Blocks[Index].TextRaw;
+}
+
+/**
+ * @brief Decompresses the text section of a block only.
+ *
+ * @param Index Index of the block.
+ * @param Text Receives the titles and descriptions, to be cut with the offsets of bReadMeta().
+ * @return true on success, false if the block is corrupt.
+ */
+bool TaskSnapshotReader::bReadText(std::size_t Index, std::string &Text) const
+{
+    return bReadSection(Index, true, Text);
+}
+
+/**
+ * @brief Decodes every task of a block.
+ *
+ * @param Index Index of the block.
+ * @param tasks List the tasks are appended to, with its allocator.
+ * @return true on success, false if the block is corrupt; nothing is appended then.
+ */
+bool TaskSnapshotReader::bReadBlock(std::size_t Index, TaskList &tasks) const
+{
+    TaskSnapshotMeta Meta;
+    std::string Text;
+    if (bReadMeta(Index, Meta) == false || bReadText(Index, Text) == false)
+    {
+        return false;
+    }
+    std::string_view View(Text);
+    tasks.reserve(tasks.size() + Meta.Ids.size());
+    for (std::size_t Row = 0; Row < Meta.Ids.size(); ++Row)
+    {
+        tasks.emplace_back(Meta.Ids[Row],
+                           View.substr(Meta.TitleOffsets[Row], Meta.TitleOffsets[Row + 1] - Meta.TitleOffsets[Row]),
+                           View.substr(Meta.DescOffsets[Row], Meta.DescOffsets[Row + 1] - Meta.DescOffsets[Row]),
+                           Meta.DueDays[Row], Meta.Priorities[Row]);
+        if (Meta.States[Row] == TaskState::Done)
+        {
+            tasks.back().markDone();
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Result of decoding a run of blocks on one thread.
+ */
+struct SnapshotChunk
+{
+    std::pmr::monotonic_buffer_resource Arena;  /**< Scratch memory for the text of the decoded tasks. */
+    TaskList Tasks{&Arena};                     /**< Tasks decoded from the run. */
+    bool Decoded = true;                        /**< false if any block of the run is corrupt. */
+};
+
+/**
+ * @brief Decodes every task of the snapshot, on several threads for large files.
+ *
+ * The blocks are split into as many runs of consecutive blocks as there are
+ * threads. The first run is decoded straight into the list; the others into
+ * arenas of their own, moved into the list in order once every thread is done.
+ *
+ * @param tasks List the tasks are appended to, in file order.
+ * @param ThreadCount Number of threads to use, or 0 to pick one per hardware thread.
+ * @return true on success, false if any block is corrupt; nothing is appended then.
+ */
+bool TaskSnapshotReader::bReadAll(TaskList &tasks, unsigned ThreadCount) const
+{
+    if (Valid == false)
+    {
+        return false;
+    }
+    if (ThreadCount == 0)
+    {
+        ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t RunCount = std::max<std::size_t>(1, std::min<std::size_t>(ThreadCount, Blocks.size()));
+    std::size_t FirstNew = tasks.size();
+    tasks.reserve(FirstNew + TaskCount);
+
+    std::deque<SnapshotChunk> Chunks(RunCount);
+    auto vidDecodeRun = [this, RunCount](std::size_t Run, TaskList &Out, bool &Decoded)
+    {
+        std::size_t Begin = Blocks.size() * Run / RunCount;
+        std::size_t End = Blocks.size() * (Run + 1) / RunCount;
+        for (std::size_t Index = Begin; Index < End && Decoded == true; ++Index)
+        {
+            Decoded = bReadBlock(Index, Out);
+        }
+    };
+    std::vector<std::thread> Workers;
+    for (std::size_t Run = 1; Run < RunCount; ++Run)
+    {
+        Workers.emplace_back(vidDecodeRun, Run, std::ref(Chunks[Run].Tasks), std::ref(Chunks[Run].Decoded));
+    }
+    vidDecodeRun(0, tasks, Chunks[0].Decoded);
+    for (auto &Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    bool Decoded = true;
+    for (auto &Chunk : Chunks)
+    {
+        Decoded = Decoded && Chunk.Decoded;
+    }
+    if (Decoded == false)
+    {
+        tasks.resize(FirstNew);
+        return false;
+    }
+    for (std::size_t Run = 1; Run < RunCount; ++Run)
+    {
+        std::move(Chunks[Run].Tasks.begin(), Chunks[Run].Tasks.end(), std::back_inserter(tasks));
+    }
+    return true;
+}
+
+/**
+ * @brief Tells whether a file name selects the snapshot task format.
+ *
+ * @param filename Name of the task file.
+ * @return true if the name ends with ".tsnap".
+ */
+bool IsSnapshotTaskFile(const std::string &filename)
+{
+    const std::string Extension = ".tsnap";
+    return filename.size() >= Extension.size() &&
+           filename.compare(filename.size() - Extension.size(), Extension.size(), Extension) == 0;
+}
+
+/**
+ * @brief Writes tasks to a file in the snapshot format.
+ *
+ * The list is cut into blocks in one pass over the text sizes; the blocks are
+ * then encoded by a pool of threads, each taking the next block not yet
+ * taken, and written out in order once all are done. The header goes last,
+ * over the placeholder written first, so a file cut short has no valid header.
+ *
+ * @param tasks Tasks to write; tombstones are skipped.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header, or 0 to record none.
+ * @param ThreadCount Number of threads compressing blocks, or 0 to pick one per hardware thread.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksSnapshot(const TaskList &tasks, const std::string &filename, int NextId, unsigned ThreadCount)
+{
+    std::ofstream FileHandler(filename, std::ios::binary | std::ios::trunc);
+    if (!FileHandler)
+    {
+        return false;
+    }
+
+    std::vector<std::size_t> Bounds{0};
+    std::size_t TextSize = 0;
+    std::size_t Count = 0;
+    for (std::size_t Index = 0; Index < tasks.size(); ++Index)
+    {
+        if (TextSize >= TASK_SNAPSHOT_BLOCK_TEXT || Count >= TASK_SNAPSHOT_BLOCK_TASKS)
+        {
+            Bounds.push_back(Index);
+            TextSize = 0;
+            Count = 0;
+        }
+        TextSize += tasks[Index].int32GetTaskTitle().size() + tasks[Index].int32GetTaskDescription().size();
+        ++Count;
+    }
+    if (tasks.empty() == false)
+    {
+        Bounds.push_back(tasks.size());
+    }
+    std::vector<EncodedBlock> Blocks(Bounds.size() - 1);
+
+    if (ThreadCount == 0)
+    {
+        ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::atomic<std::size_t> NextBlock{0};
+    auto vidEncodeBlocks = [&]()
+    {
+        for (std::size_t Index = NextBlock++; Index < Blocks.size(); Index = NextBlock++)
+        {
+            vidEncodeBlock(tasks.data() + Bounds[Index], tasks.data() + Bounds[Index + 1], Blocks[Index]);
+        }
+    };
+    std::vector<std::thread> Workers;
+    for (unsigned Index = 1; Index < std::min<std::size_t>(ThreadCount, Blocks.size()); ++Index)
+    {
+        Workers.emplace_back(vidEncodeBlocks);
+    }
+    vidEncodeBlocks();
+    for (auto &Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    std::string Header(TASK_SNAPSHOT_HEADER_SIZE, '\0');
+    FileHandler.write(Header.data(), static_cast<std::streamsize>(Header.size()));
+    std::string Index;
+    Index.reserve(Blocks.size() * TASK_SNAPSHOT_INDEX_ENTRY_SIZE);
+    BinaryWriter IndexWriter(Index);
+    std::uint64_t Offset = TASK_SNAPSHOT_HEADER_SIZE;
+    std::uint64_t TaskCount = 0;
+    std::uint32_t BlockCount = 0;
+    for (auto &Block : Blocks)
+    {
+        if (Block.Entry.Count == 0)
+        {
+            continue;
+        }
+        FileHandler.write(Block.Bytes.data(), static_cast<std::streamsize>(Block.Bytes.size()));
+        IndexWriter.vidWriteU64(Offset);
+        IndexWriter.vidWriteU32(Block.Entry.MetaStored);
+        IndexWriter.vidWriteU32(Block.Entry.MetaRaw);
+        IndexWriter.vidWriteU32(Block.Entry.TextStored);
+        IndexWriter.vidWriteU32(Block.Entry.TextRaw);
+        IndexWriter.vidWriteU32(Block.Entry.Count);
+        IndexWriter.vidWriteU32(Block.Entry.Flags);
+        IndexWriter.vidWriteU32(static_cast<std::uint32_t>(Block.Entry.FirstId));
+        IndexWriter.vidWriteU32(static_cast<std::uint32_t>(Block.Entry.LastId));
+        IndexWriter.vidWriteU64(Block.Entry.MetaChecksum);
+        IndexWriter.vidWriteU64(Block.Entry.TextChecksum);
+        Offset += Block.Bytes.size();
+        TaskCount += Block.Entry.Count;
+        ++BlockCount;
+        std::string().swap(Block.Bytes);
+    }
+    FileHandler.write(Index.data(), static_cast<std::streamsize>(Index.size()));
+
+    Header.clear();
+    BinaryWriter HeaderWriter(Header);
+    Header.append(TASK_SNAPSHOT_MAGIC, sizeof(TASK_SNAPSHOT_MAGIC));
+    HeaderWriter.vidWriteU32(TASK_SNAPSHOT_VERSION);
+    HeaderWriter.vidWriteU32(static_cast<std::uint32_t>(std::max(NextId, 0)));
+    HeaderWriter.vidWriteU64(TaskCount);
+    HeaderWriter.vidWriteU32(BlockCount);
+    HeaderWriter.vidWriteU32(0);
+    HeaderWriter.vidWriteU64(Offset);
+    std::uint64_t Checksum = u64Checksum(Header.data(), Header.size());
+    HeaderWriter.vidWriteU64(u64Checksum(Index.data(), Index.size(), Checksum));
+    FileHandler.seekp(0);
+    FileHandler.write(Header.data(), static_cast<std::streamsize>(Header.size()));
+    FileHandler.close();
+    return FileHandler.fail() == false;
+}
+
+/**
+ * @brief Reads tasks from a file in the snapshot format.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the decoded tasks are appended to, in file order.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if none was recorded.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool LoadTasksSnapshot(const std::string &filename, TaskList &tasks, int &NextId)
+{
+    NextId = 0;
+    TaskSnapshotReader Reader(filename);
+    if (Reader.bReadAll(tasks) == false)
+    {
+        return false;
+    }
+    NextId = Reader.int32GetNextId();
+    return true;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file task_snapshot.hpp
+ * @brief Declaration of the compressed, block-structured task snapshot format.
+ *
+ * A snapshot file starts with a fixed header holding a magic string, the
+ * format version, the next task ID to hand out, the number of tasks and of
+ * blocks, the offset of the block index and a checksum of the header and the
+ * index. The tasks are stored in blocks of consecutive tasks; the index at the
+ * end of the file gives, for each block, its offset, sizes, task count, first
+ * and last task ID and a checksum of each of its two sections.
+ *
+ * Each block holds two sections, compressed separately with the block codec
+ * (see block_codec.hpp), or stored as is when that does not make them smaller:
+ *  - the metadata section: the task count, the IDs as zigzag varint deltas,
+ *    the status and priority columns dictionary-encoded (the distinct values
+ *    of the block, then one bit-packed code per task, zero bits wide when
+ *    every task shares the same value), the due days as zigzag varint
+ *    deltas, and the title and description lengths as varints;
+ *  - the text section: every title, then every description, back to back.
+ * Grouping each column together puts similar bytes next to each other,
+ * which is what lets repetitive task text compress several times over.
+ *
+ * Blocks are independent of one another, so a snapshot is encoded and
+ * decoded on several threads, and a reader can decode any single block, or
+ * only its metadata section, without touching the rest of the file.
+ * All integers are stored little-endian regardless of the host byte order.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__SNAPSHOT__
+#define __TASK__SNAPSHOT__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mapped_file.hpp"
+#include "task.hpp"
+
+/**
+ * @brief Current version of the snapshot format.
+ */
+constexpr std::uint32_t TASK_SNAPSHOT_VERSION = 1;
+
+/**
+ * @brief Size in bytes of the snapshot file header.
+ */
+constexpr std::size_t TASK_SNAPSHOT_HEADER_SIZE = 48;
+
+/**
+ * @brief Size in bytes of one entry of the block index.
+ */
+constexpr std::size_t TASK_SNAPSHOT_INDEX_ENTRY_SIZE = 56;
+
+/**
+ * @struct TaskSnapshotBlock
+ * @brief Entry of the block index of a snapshot.
+ */
+struct TaskSnapshotBlock
+{
+    std::uint64_t Offset = 0;       /**< Offset of the block in the file. */
+    std::uint32_t MetaStored = 0;   /**< Size of the metadata section as stored. */
+    std::uint32_t MetaRaw = 0;      /**< Size of the metadata section once decompressed. */
+    std::uint32_t TextStored = 0;   /**< Size of the text section as stored, right after the metadata. */
+    std::uint32_t TextRaw = 0;      /**< Size of the text section once decompressed. */
+    std::uint32_t Count = 0;        /**< Number of tasks in the block. */
+    std::uint32_t Flags = 0;        /**< Bit 0 set if the metadata is compressed, bit 1 if the text is. */
+    std::int32_t FirstId = 0;       /**< Smallest task ID in the block. */
+    std::int32_t LastId = 0;        /**< Largest task ID in the block. */
+    std::uint64_t MetaChecksum = 0; /**< Checksum of the stored metadata section. */
+    std::uint64_t TextChecksum = 0; /**< Checksum of the stored text section. */
+};
+
+/**
+ * @struct TaskSnapshotMeta
+ * @brief Decoded metadata section of a block: every field of its tasks but their text.
+ */
+struct TaskSnapshotMeta
+{
+    std::vector<std::int32_t> Ids;              /**< Task IDs. */
+    std::vector<TaskState> States;              /**< Task statuses. */
+    std::vector<TaskPriority> Priorities;       /**< Task priorities. */
+    std::vector<std::int32_t> DueDays;          /**< Due dates as day numbers, or TASK_NO_DUE_DATE. */
+    std::vector<std::uint32_t> TitleOffsets;    /**< Offset of each title in the text section, plus one final end offset. */
+    std::vector<std::uint32_t> DescOffsets;     /**< Offset of each description in the text section, plus one final end offset. */
+};
+
+/**
+ * @class TaskSnapshotReader
+ * @brief Maps a snapshot file and decodes its blocks on request.
+ *
+ * Opening a snapshot only reads and verifies its header and block index.
+ * Blocks may be decoded from several threads at once.
+ */
+class TaskSnapshotReader
+{
+private:
+    MappedFile File;                            /**< Mapped snapshot file. */
+    std::vector<TaskSnapshotBlock> Blocks;      /**< Block index. */
+    std::uint64_t TaskCount = 0;                /**< Number of tasks in the file. */
+    int NextId = 0;                             /**< Next task ID recorded in the header. */
+    bool Valid = false;                         /**< true if the header and index were read and verified. */
+
+    /**
+     * @brief Verifies the checksum of a section of a block and gets it decompressed.
+     *
+     * @param Index Index of the block.
+     * @param Text true for the text section, false for the metadata section.
+     * @param Out Receives the decompressed section.
+     * @return true if the section is intact and decompressed to its recorded size.
+     */
+    bool bReadSection(std::size_t Index, bool Text, std::string &Out) const;
+
+public:
+    /**
+     * @brief Maps a snapshot file and reads its block index.
+     *
+     * @param filename Name of the snapshot file.
+     */
+    explicit TaskSnapshotReader(const std::string &filename);
+
+    TaskSnapshotReader(const TaskSnapshotReader &) = delete;
+    TaskSnapshotReader &operator=(const TaskSnapshotReader &) = delete;
+
+    /**
+     * @brief Tells whether the file is a valid snapshot.
+     *
+     * @return true if the header and block index were read and verified; an empty file is a valid, empty snapshot.
+     */
+    bool bIsValid(void) const;
+
+    /**
+     * @brief Gets the number of tasks in the snapshot.
+     *
+     * @return Task count.
+     */
+    std::uint64_t u64GetTaskCount(void) const;
+
+    /**
+     * @brief Gets the next task ID recorded in the snapshot.
+     *
+     * @return Next ID, or 0 for an empty file.
+     */
+    int int32GetNextId(void) const;
+
+    /**
+     * @brief Gets the block index.
+     *
+     * @return One entry per block, in file order.
+     */
+    const std::vector<TaskSnapshotBlock> &GetBlocks(void) const;
+
+    /**
+     * @brief Decodes the metadata section of a block only.
+     *
+     * @param Index Index of the block.
+     * @param Meta Receives the columns of the block.
+     * @return true on success, false if the block is corrupt.
+     */
+    bool bReadMeta(std::size_t Index, TaskSnapshotMeta &Meta) const;
+
+    /**
+     * @brief Decompresses the text section of a block only.
+     *
+     * @param Index Index of the block.
+     * @param Text Receives the titles and descriptions, to be cut with the offsets of bReadMeta().
+     * @return true on success, false if the block is corrupt.
+     */
+    bool bReadText(std::size_t Index, std::string &Text) const;
+
+    /**
+     * @brief Decodes every task of a block.
+     *
+     * @param Index Index of the block.
+     * @param tasks List the tasks are appended to.
+     * @return true on success, false if the block is corrupt; nothing is appended then.
+     */
+    bool bReadBlock(std::size_t Index, TaskList &tasks) const;
+
+    /**
+     * @brief Decodes every task of the snapshot, on several threads for large files.
+     *
+     * @param tasks List the tasks are appended to, in file order.
+     * @param ThreadCount Number of threads to use, or 0 to pick one per hardware thread.
+     * @return true on success, false if any block is corrupt; nothing is appended then.
+     */
+    bool bReadAll(TaskList &tasks, unsigned ThreadCount = 0) const;
+};
+
+/**
+ * @brief Tells whether a file name selects the snapshot task format.
+ *
+ * Files with the ".tsnap" extension are stored in the snapshot format.
+ *
+ * @param filename Name of the task file.
+ * @return true if the file uses the snapshot format.
+ */
+bool IsSnapshotTaskFile(const std::string &filename);
+
+/**
+ * @brief Writes tasks to a file in the snapshot format.
+ *
+ * Deleted tasks still waiting in the list as tombstones are skipped.
+ *
+ * @param tasks Tasks to write.
+ * @param filename Name of the file to write.
+ * @param NextId Next task ID to record in the header, or 0 to record none.
+ * @param ThreadCount Number of threads compressing blocks, or 0 to pick one per hardware thread.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksSnapshot(const TaskList &tasks, const std::string &filename, int NextId = 0, unsigned ThreadCount = 0);
+
+/**
+ * @brief Reads tasks from a file in the snapshot format.
+ *
+ * @param filename Name of the file to read.
+ * @param tasks List the decoded tasks are appended to.
+ * @param NextId Receives the next task ID recorded in the header, or 0 if none was recorded.
+ * @return true on success (an empty file holds no tasks), false if the file is missing, truncated or corrupt.
+ */
+bool LoadTasksSnapshot(const std::string &filename, TaskList &tasks, int &NextId);
+
+#endif // __TASK__SNAPSHOT__
@@ -0,0 +1,506 @@
+/**
+ * @file task_text.cpp
+ * @brief Implementation of the reader and writer for the pipe-delimited text task format.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_text.hpp"
+#include "task_text_scanner.hpp"
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <fstream>
+#include <thread>
+
+/**
+ * @brief Splits one line of a text task file into its field values.
+ *
+ * @param Line Line to split, without its trailing newline.
+ * @param Fields Array receiving the values of the six fields in file order.
+ * @return true if the line holds exactly six "key: value" fields, false otherwise.
+ */
+bool SplitTaskLine(std::string_view Line, std::string_view (&Fields)[TASK_TEXT_FIELD_COUNT])
+{
+    if (Line.empty() == false && Line.back() == '\r')
+    {
+        Line.remove_suffix(1);
+    }
+
+    std::size_t FieldCount = 0;
+    while (true)
+    {
+        std::size_t Separator = Line.find('|');
+        std::string_view Field = Line.substr(0, Separator);
+        std::size_t Colon = Field.find(':');
+        if (Colon == std::string_view::npos || FieldCount == TASK_TEXT_FIELD_COUNT)
+        {
+            return false;
+        }
+        Field.remove_prefix(Colon + 1);
+        if (Field.empty() == false)
+        {
+            Field.remove_prefix(1);
+        }
+        Fields[FieldCount++] = Field;
+
+        if (Separator == std::string_view::npos)
+        {
+            break;
+        }
+        Line.remove_prefix(Separator + 1);
+    }
+    return FieldCount == TASK_TEXT_FIELD_COUNT;
+}
+
+/**
+ * @struct TaskFieldViews
+ * @brief Parsed fields of one line of a text task file, its text still in the file.
+ */
+struct TaskFieldViews
+{
+    int id = 0;                                     /**< Task ID. */
+    std::int32_t DueDay = TASK_NO_DUE_DATE;         /**< Due date as a day number. */
+    TaskPriority Priority = TaskPriority::Unknown;  /**< Priority level. */
+    TaskState State = TaskState::Pending;           /**< Status. */
+    std::string_view Title;                         /**< Title, in the file. */
+    std::string_view Description;                   /**< Description, in the file. */
+    std::string_view RawDueDate;                    /**< Unrecognized due date text, or empty. */
+    std::string_view RawPriority;                   /**< Unrecognized priority text, or empty. */
+};
+
+/**
+ * @brief Parses the field values of one line of a text task file.
+ *
+ * The ID field must be a plain decimal integer and the status must be
+ * "Pending" or "Done". No text is copied: the parsed fields point into Fields.
+ *
+ * @param Fields Values of the six fields in file order.
+ * @param Parsed Receives the parsed fields.
+ * @param Normalized Set to true if an unrecognized due date or priority was kept as text.
+ * @return true if the fields are valid, false otherwise.
+ */
+static bool bParseTaskFields(const std::string_view (&Fields)[TASK_TEXT_FIELD_COUNT], TaskFieldViews &Parsed, bool &Normalized)
+{
+    int id = 0;
+    const char *IdEnd = Fields[0].data() + Fields[0].size();
+    auto Result = std::from_chars(Fields[0].data(), IdEnd, id);
+    if (Result.ec != std::errc() || Result.ptr != IdEnd)
+    {
+        return false;
+    }
+
+    TaskState State = TaskState::Pending;
+    if (ParseTaskState(Fields[5], State) == false)
+    {
+        return false;
+    }
+    std::int32_t DueDay = TASK_NO_DUE_DATE;
+    TaskPriority Priority = TaskPriority::Unknown;
+    std::string_view RawDueDate;
+    std::string_view RawPriority;
+    if (ParseDueDate(Fields[3], DueDay) == false)
+    {
+        DueDay = TASK_NO_DUE_DATE;
+        RawDueDate = Fields[3];
+    }
+    if (ParseTaskPriority(Fields[4], Priority) == false)
+    {
+        Priority = TaskPriority::Unknown;
+        RawPriority = Fields[4];
+    }
+
+    Parsed.id = id;
+    Parsed.DueDay = DueDay;
+    Parsed.Priority = Priority;
+    Parsed.State = State;
+    Parsed.Title = Fields[1];
+    Parsed.Description = Fields[2];
+    Parsed.RawDueDate = RawDueDate;
+    Parsed.RawPriority = RawPriority;
+    Normalized = (RawDueDate.empty() == false || RawPriority.empty() == false);
+    return true;
+}
+
+/**
+ * @brief Copies parsed fields into a task, its text included.
+ *
+ * @param Parsed Parsed fields of one line.
+ * @param task Task that receives them.
+ */
+static void vidBuildTask(const TaskFieldViews &Parsed, Task &task)
+{
+    task.vidAssign(Parsed.id, Parsed.Title, Parsed.Description, Parsed.DueDay, Parsed.Priority, Parsed.State);
+    if (Parsed.RawDueDate.empty() == false || Parsed.RawPriority.empty() == false)
+    {
+        task.vidKeepRawFields(Parsed.RawDueDate, Parsed.RawPriority);
+    }
+}
+
+/**
+ * @brief Parses one line of a text task file into a task.
+ *
+ * @param Line Line to parse, without its trailing newline.
+ * @param task Task that receives the parsed fields.
+ * @param Normalized Set to true if an unrecognized due date or priority was kept as text.
+ * @return true if the line is well formed, false otherwise.
+ */
+bool ParseTaskLine(std::string_view Line, Task &task, bool &Normalized)
+{
+    std::string_view Fields[TASK_TEXT_FIELD_COUNT];
+    TaskFieldViews Parsed;
+    if (SplitTaskLine(Line, Fields) == false || bParseTaskFields(Fields, Parsed, Normalized) == false)
+    {
+        return false;
+    }
+    vidBuildTask(Parsed, task);
+    return true;
+}
+
+/**
+ * @brief Appends the text-format line of a task, newline included, to a buffer.
+ *
+ * @param Buffer Buffer the line is appended to.
+ * @param task Task to format.
+ */
+void AppendTaskLine(std::string &Buffer, const Task &task)
+{
+    char IdText[16];
+    auto IdEnd = std::to_chars(IdText, IdText + sizeof(IdText), task.int32GetTaskID()).ptr;
+    Buffer.append("ID: ").append(IdText, static_cast<std::size_t>(IdEnd - IdText));
+    Buffer.append("|Title: ").append(task.int32GetTaskTitle());
+    Buffer.append("|Description: ").append(task.int32GetTaskDescription());
+    Buffer.append("|Due Date: ").append(task.int32GetTaskdueDate());
+    Buffer.append("|Priority: ").append(task.int32GetTaskpriority());
+    Buffer.append("|Status: ").append(task.GetTaskStatus()).push_back('\n');
+}
+
+/**
+ * @brief Inputs smaller than this many bytes per thread are parsed on fewer threads.
+ */
+static constexpr std::size_t TASK_TEXT_MIN_CHUNK_SIZE = 1 << 20;
+
+/**
+ * @brief Number of bytes whose delimiters are scanned at once.
+ *
+ * Small enough for the block and its offsets to stay in cache while the lines
+ * are split; a block always ends on a line boundary.
+ */
+static constexpr std::size_t TASK_TEXT_SCAN_BLOCK_SIZE = 1 << 16;
+
+/**
+ * @struct TextChunk
+ * @brief Result of parsing one newline-aligned chunk of a text task file.
+ */
+struct TextChunk
+{
+    std::string_view Content;                   /**< Bytes of the chunk. */
+    std::vector<TaskFieldViews> Parsed;         /**< Fields of the lines parsed but not yet copied into tasks. */
+    std::vector<std::size_t> MalformedLines;    /**< Chunk-relative line numbers of malformed lines. */
+    std::vector<std::size_t> NormalizedLines;   /**< Chunk-relative line numbers of normalized lines. */
+    std::size_t LineCount = 0;                  /**< Number of lines in the chunk. */
+};
+
+/**
+ * @brief Parses every line of a block whose delimiters have been scanned.
+ *
+ * Fields are split exactly as SplitTaskLine() does, but from the delimiter
+ * offsets rather than by searching the text again.
+ *
+ * @param Block Block of whole lines, the last one possibly without its newline.
+ * @param Positions Offsets of every '|', ':' and '\n' in the block.
+ * @param Count Number of offsets.
+ * @param Chunk Chunk the block belongs to; its parsed lines and line numbers are stored back into it.
+ */
+static void vidParseBlock(std::string_view Block, const std::uint32_t *Positions, std::size_t Count, TextChunk &Chunk)
+{
+    std::string_view Fields[TASK_TEXT_FIELD_COUNT];
+    std::size_t Cursor = 0;
+    std::size_t LineStart = 0;
+    while (LineStart < Block.size())
+    {
+        std::size_t FieldCount = 0;
+        std::size_t Colon = std::string_view::npos;
+        bool Valid = true;
+        auto CloseField = [&](std::size_t FieldEnd)
+        {
+            if (Colon == std::string_view::npos || FieldCount == TASK_TEXT_FIELD_COUNT)
+            {
+                Valid = false;
+            }
+            else
+            {
+                std::string_view Field = Block.substr(Colon + 1, FieldEnd - Colon - 1);
+                if (Field.empty() == false)
+                {
+                    Field.remove_prefix(1);
+                }
+                Fields[FieldCount++] = Field;
+            }
+            Colon = std::string_view::npos;
+        };
+
+        std::size_t LineEnd = Block.size();
+        for (; Cursor < Count; ++Cursor)
+        {
+            std::size_t Offset = Positions[Cursor];
+            char Byte = Block[Offset];
+            if (Byte == '\n')
+            {
+                LineEnd = Offset;
+                ++Cursor;
+                break;
+            }
+            if (Byte == ':')
+            {
+                Colon = (Colon == std::string_view::npos) ? Offset : Colon;
+                continue;
+            }
+            CloseField(Offset);
+        }
+        std::size_t NextLine = (LineEnd < Block.size()) ? LineEnd + 1 : LineEnd;
+        if (LineEnd > LineStart && Block[LineEnd - 1] == '\r')
+        {
+            --LineEnd;
+        }
+        ++Chunk.LineCount;
+
+        if (LineEnd == LineStart || Block[LineStart] == '#')
+        {
+            LineStart = NextLine;
+            continue;
+        }
+        CloseField(LineEnd);
+        LineStart = NextLine;
+
+        bool Normalized = false;
+        TaskFieldViews Parsed;
+        if (Valid == false || FieldCount != TASK_TEXT_FIELD_COUNT || bParseTaskFields(Fields, Parsed, Normalized) == false)
+        {
+            Chunk.MalformedLines.push_back(Chunk.LineCount);
+            continue;
+        }
+        Chunk.Parsed.push_back(Parsed);
+        if (Normalized == true)
+        {
+            Chunk.NormalizedLines.push_back(Chunk.LineCount);
+        }
+    }
+}
+
+/**
+ * @brief Copies the parsed lines of a chunk into tasks, and forgets them.
+ *
+ * @param Chunk Chunk whose parsed lines to copy.
+ * @param tasks Vector the tasks are appended to.
+ */
+static void vidBuildTasks(TextChunk &Chunk, TaskList &tasks)
+{
+    for (const TaskFieldViews &Parsed : Chunk.Parsed)
+    {
+        tasks.emplace_back();
+        vidBuildTask(Parsed, tasks.back());
+    }
+    Chunk.Parsed.clear();
+}
+
+/**
+ * @brief Parses every line of one chunk.
+ *
+ * The chunk is cut into blocks of whole lines; the delimiters of each block
+ * are located in one vectorized pass before its lines are split.
+ *
+ * @param Chunk Chunk to parse; its parsed lines and line numbers are stored back into it.
+ * @param tasks Vector the tasks of each block are appended to as soon as it is parsed,
+ *              or nullptr to leave every parsed line in the chunk.
+ */
+static void vidParseChunk(TextChunk &Chunk, TaskList *tasks)
+{
+    ScanLevel Level = GetBestScanLevel();
+    std::vector<std::uint32_t> Positions(TASK_TEXT_SCAN_BLOCK_SIZE);
+    std::string_view Data = Chunk.Content;
+    while (Data.empty() == false)
+    {
+        std::size_t BlockSize = Data.size();
+        if (BlockSize > TASK_TEXT_SCAN_BLOCK_SIZE)
+        {
+            std::size_t NewLine = Data.rfind('\n', TASK_TEXT_SCAN_BLOCK_SIZE - 1);
+            if (NewLine == std::string_view::npos)
+            {
+                NewLine = Data.find('\n', TASK_TEXT_SCAN_BLOCK_SIZE);
+            }
+            BlockSize = (NewLine == std::string_view::npos) ? Data.size() : NewLine + 1;
+        }
+        std::string_view Block = Data.substr(0, BlockSize);
+        if (Positions.size() < Block.size())
+        {
+            Positions.resize(Block.size());
+        }
+        std::size_t Count = u64ScanDelimiters(Block, Positions.data(), Level);
+        vidParseBlock(Block, Positions.data(), Count, Chunk);
+        if (tasks != nullptr)
+        {
+            vidBuildTasks(Chunk, *tasks);
+        }
+        Data.remove_prefix(BlockSize);
+    }
+}
+
+/**
+ * @brief Parses the whole content of a text task file, in parallel for large inputs.
+ *
+ * @param Content Whole content of the file.
+ * @param tasks Vector the parsed tasks are appended to.
+ * @param MalformedLines Vector receiving the line numbers of malformed lines, in ascending order.
+ * @param NormalizedLines Vector receiving the line numbers of normalized lines, in ascending order.
+ * @param ThreadCount Number of threads to use, or 0 to pick one per hardware thread.
+ */
+void ParseTaskText(std::string_view Content, TaskList &tasks, std::vector<std::size_t> &MalformedLines,
+                   std::vector<std::size_t> &NormalizedLines, unsigned ThreadCount)
+{
+    if (ThreadCount == 0)
+    {
+        ThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t MaxChunks = std::max<std::size_t>(1, Content.size() / TASK_TEXT_MIN_CHUNK_SIZE);
+    std::size_t ChunkCount = std::min<std::size_t>(ThreadCount, MaxChunks);
+
+    std::deque<TextChunk> Chunks;
+    std::size_t Start = 0;
+    for (std::size_t Index = 0; Index < ChunkCount && Start < Content.size(); ++Index)
+    {
+        std::size_t Stop = Content.size();
+        if (Index + 1 < ChunkCount)
+        {
+            std::size_t Target = std::max(Start, Content.size() * (Index + 1) / ChunkCount);
+            std::size_t NewLine = Content.find('\n', Target);
+            Stop = (NewLine == std::string_view::npos) ? Content.size() : NewLine + 1;
+        }
+        Chunks.emplace_back();
+        Chunks.back().Content = Content.substr(Start, Stop - Start);
+        Start = Stop;
+    }
+
+    std::vector<std::thread> Workers;
+    for (std::size_t Index = 1; Index < Chunks.size(); ++Index)
+    {
+        Workers.emplace_back(vidParseChunk, std::ref(Chunks[Index]), nullptr);
+    }
+    std::size_t FirstNew = tasks.size();
+    if (Chunks.empty() == false)
+    {
+        vidParseChunk(Chunks[0], &tasks);
+    }
+    for (auto &Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    std::size_t Total = tasks.size();
+    for (auto &Chunk : Chunks)
+    {
+        Total += Chunk.Parsed.size();
+    }
+    tasks.reserve(Total);
+
+    std::size_t LineOffset = 0;
+    for (auto &Chunk : Chunks)
+    {
+        vidBuildTasks(Chunk, tasks);
+        for (std::size_t Line : Chunk.MalformedLines)
+        {
+            MalformedLines.push_back(LineOffset + Line);
+        }
+        for (std::size_t Line : Chunk.NormalizedLines)
+        {
+            NormalizedLines.push_back(LineOffset + Line);
+        }
+        LineOffset += Chunk.LineCount;
+    }
+
+    auto ById = [](const Task &Left, const Task &Right)
+    { return Left.int32GetTaskID() < Right.int32GetTaskID(); };
+    if (std::is_sorted(tasks.begin() + FirstNew, tasks.end(), ById) == false)
+    {
+        std::stable_sort(tasks.begin() + FirstNew, tasks.end(), ById);
+    }
+}
+
+/**
+ * @brief Reads the next task ID recorded at the start of a text task file.
+ *
+ * @param Content Whole content of the file.
+ * @param NextId Receives the recorded ID.
+ * @return true if the file starts with a valid "# Next ID: <id>" line, false otherwise.
+ */
+bool ParseTextNextId(std::string_view Content, int &NextId)
+{
+    if (Content.substr(0, TASK_TEXT_NEXT_ID_PREFIX.size()) != TASK_TEXT_NEXT_ID_PREFIX)
+    {
+        return false;
+    }
+    std::string_view Line = Content.substr(TASK_TEXT_NEXT_ID_PREFIX.size());
+    Line = Line.substr(0, Line.find('\n'));
+    if (Line.empty() == false && Line.back() == '\r')
+    {
+        Line.remove_suffix(1);
+    }
+    int Value = 0;
+    auto Result = std::from_chars(Line.data(), Line.data() + Line.size(), Value);
+    if (Result.ec != std::errc() || Result.ptr != Line.data() + Line.size() || Value <= 0)
+    {
+        return false;
+    }
+    NextId = Value;
+    return true;
+}
+
+/**
+ * @brief Size after which the save buffer is flushed to disk.
+ */
+static constexpr std::size_t TASK_TEXT_FLUSH_SIZE = 1 << 20;
+
+/**
+ * @brief Writes tasks to a file in the text format.
+ *
+ * Lines are formatted into one reused buffer that is written out in large
+ * blocks, so saving does no per-task allocation. Tombstones are skipped.
+ *
+ * @param tasks Tasks to write.
+ * @param filename Name of the file to write; its previous content is replaced.
+ * @param NextId Next task ID to record in the first line, or 0 to record none.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksText(const TaskList &tasks, const std::string &filename, int NextId)
+{
+    std::ofstream FileHandler(filename, std::ios::trunc);
+    if (!FileHandler)
+    {
+        return false;
+    }
+    std::string Buffer;
+    Buffer.reserve(TASK_TEXT_FLUSH_SIZE + 4096);
+    if (NextId > 0)
+    {
+        char IdText[16];
+        auto IdEnd = std::to_chars(IdText, IdText + sizeof(IdText), NextId).ptr;
+        Buffer.append(TASK_TEXT_NEXT_ID_PREFIX).append(IdText, static_cast<std::size_t>(IdEnd - IdText)).push_back('\n');
+    }
+    for (auto &it : tasks)
+    {
+        if (it.bIsRemoved() == true)
+        {
+            continue;
+        }
+        AppendTaskLine(Buffer, it);
+        if (Buffer.size() >= TASK_TEXT_FLUSH_SIZE)
+        {
+            FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        }
+    }
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    FileHandler.close();
+    return !FileHandler.fail();
+}
@@ -0,0 +1,110 @@
+/**
+ * @file task_text.hpp
+ * @brief Declaration of the reader and writer for the pipe-delimited text task format.
+ *
+ * Each line of a text task file has the form
+ * "ID: <id>|Title: <title>|Description: <desc>|Due Date: <date>|Priority: <priority>|Status: <status>".
+ * The parser works on std::string_view slices of the input and never builds
+ * intermediate strings; the writer produces the same layout. Lines starting
+ * with '#' are comments; the writer starts the file with a "# Next ID: <id>"
+ * comment so deleted IDs are not handed out again after a reload.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__TEXT__
+#define __TASK__TEXT__
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "task.hpp"
+
+/**
+ * @brief Number of fields on each line of a text task file.
+ */
+constexpr std::size_t TASK_TEXT_FIELD_COUNT = 6;
+
+/**
+ * @brief Start of the comment line recording the next task ID.
+ */
+constexpr std::string_view TASK_TEXT_NEXT_ID_PREFIX = "# Next ID: ";
+
+/**
+ * @brief Splits one line of a text task file into its field values.
+ *
+ * Each field is cut at its first ':' and the single space that follows it is
+ * dropped, leaving views that point into the given line.
+ *
+ * @param Line Line to split, without its trailing newline.
+ * @param Fields Array receiving the values of the six fields in file order.
+ * @return true if the line holds exactly six "key: value" fields, false otherwise.
+ */
+bool SplitTaskLine(std::string_view Line, std::string_view (&Fields)[TASK_TEXT_FIELD_COUNT]);
+
+/**
+ * @brief Parses one line of a text task file into a task.
+ *
+ * The ID and status must be valid for the line to be accepted. A due date or
+ * priority that is not recognized is kept as text with the task (see
+ * Task::vidKeepRawFields()) rather than rejecting the whole task, so neither
+ * the task nor the text is lost from older files.
+ *
+ * @param Line Line to parse, without its trailing newline.
+ * @param task Task that receives the parsed fields.
+ * @param Normalized Set to true if an unrecognized due date or priority was kept as text.
+ * @return true if the line is well formed, false otherwise.
+ */
+bool ParseTaskLine(std::string_view Line, Task &task, bool &Normalized);
+
+/**
+ * @brief Appends the text-format line of a task, newline included, to a buffer.
+ *
+ * @param Buffer Buffer the line is appended to.
+ * @param task Task to format.
+ */
+void AppendTaskLine(std::string &Buffer, const Task &task);
+
+/**
+ * @brief Parses the whole content of a text task file, in parallel for large inputs.
+ *
+ * The content is split at newline boundaries into one chunk per hardware thread.
+ * The first chunk is parsed into tasks block by block; every other chunk is
+ * parsed on its own thread into fields that still point into Content, which are
+ * copied into tasks once every thread is done, so the text of every task is
+ * copied exactly once. The tasks end up in ID order. Blank and comment lines are
+ * ignored; malformed lines are skipped and their 1-based line numbers reported,
+ * as are the lines whose due date or priority was kept as text.
+ *
+ * @param Content Whole content of the file.
+ * @param tasks Vector the parsed tasks are appended to.
+ * @param MalformedLines Vector receiving the line numbers of malformed lines, in ascending order.
+ * @param NormalizedLines Vector receiving the line numbers of normalized lines, in ascending order.
+ * @param ThreadCount Number of threads to use, or 0 to pick one per hardware thread.
+ */
+void ParseTaskText(std::string_view Content, TaskList &tasks, std::vector<std::size_t> &MalformedLines,
+                   std::vector<std::size_t> &NormalizedLines, unsigned ThreadCount = 0);
+
+/**
+ * @brief Reads the next task ID recorded at the start of a text task file.
+ *
+ * @param Content Whole content of the file.
+ * @param NextId Receives the recorded ID.
+ * @return true if the file starts with a valid "# Next ID: <id>" line, false otherwise.
+ */
+bool ParseTextNextId(std::string_view Content, int &NextId);
+
+/**
+ * @brief Writes tasks to a file in the text format.
+ *
+ * Deleted tasks still waiting in the list as tombstones are skipped.
+ *
+ * @param tasks Tasks to write.
+ * @param filename Name of the file to write; its previous content is replaced.
+ * @param NextId Next task ID to record in the first line, or 0 to record none.
+ * @return true on success, false if the file could not be written.
+ */
+bool SaveTasksText(const TaskList &tasks, const std::string &filename, int NextId = 0);
+
+#endif // __TASK__TEXT__
@@ -0,0 +1,632 @@
+/**
+ * @file task_text_index.cpp
+ * @brief Implementation of the TaskTextIndex inverted index.
+ *
+ * A saved index starts with a 40-byte header: the magic "TASKIDX\0", the format
+ * version, a flags word, the stamp of the task files, the token count and a
+ * checksum of the payload. The payload lists the tokens in order, each as a
+ * length-prefixed string followed by its count of live IDs and the IDs.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_text_index.hpp"
+#include "task_binary.hpp"
+#include "mapped_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+/**
+ * @brief Magic bytes at the start of every saved index.
+ */
+static const char TASK_TEXT_INDEX_MAGIC[8] = {'T', 'A', 'S', 'K', 'I', 'D', 'X', '\0'};
+
+/**
+ * @brief Size in bytes of the saved index header.
+ */
+static constexpr std::size_t TASK_TEXT_INDEX_HEADER_SIZE = 40;
+
+/**
+ * @brief Payload size after which the save buffer is flushed to disk.
+ */
+static constexpr std::size_t TASK_TEXT_INDEX_FLUSH_SIZE = 1 << 20;
+
+/**
+ * @brief Bit flagging a removed ID in a posting list.
+ */
+static constexpr std::uint32_t TASK_TEXT_INDEX_REMOVED = 0x80000000u;
+
+/**
+ * @brief Longest token that is indexed; longer runs are cut to this length.
+ */
+static constexpr std::size_t TASK_TEXT_INDEX_MAX_TOKEN = 64;
+
+/**
+ * @brief Tells whether a byte belongs to a token.
+ *
+ * ASCII letters and digits do, and so do all bytes of multi-byte UTF-8
+ * characters, so words in other scripts are kept whole.
+ *
+ * @param Byte Byte to test.
+ * @return true if the byte is part of a token.
+ */
+static bool bIsTokenByte(unsigned char Byte)
+{
+    return (Byte >= '0' && Byte <= '9') || (Byte >= 'a' && Byte <= 'z') || (Byte >= 'A' && Byte <= 'Z') || Byte >= 0x80;
+}
+
+/**
+ * @brief Lowercases a text in place and splits it into tokens.
+ *
+ * The tokens are views into the text, so no string is allocated per token.
+ *
+ * @param Text Text to split; its ASCII letters are lowercased.
+ * @param Tokens Vector the tokens are appended to, valid while Text is unchanged.
+ */
+static void vidTokenize(std::string &Text, std::vector<std::string_view> &Tokens)
+{
+    std::size_t Index = 0;
+    while (Index < Text.size())
+    {
+        if (bIsTokenByte(static_cast<unsigned char>(Text[Index])) == false)
+        {
+            ++Index;
+            continue;
+        }
+        std::size_t First = Index;
+        while (Index < Text.size() && bIsTokenByte(static_cast<unsigned char>(Text[Index])) == true)
+        {
+            if (Text[Index] >= 'A' && Text[Index] <= 'Z')
+            {
+                Text[Index] = static_cast<char>(Text[Index] - 'A' + 'a');
+            }
+            ++Index;
+        }
+        Tokens.emplace_back(Text.data() + First, std::min(Index - First, TASK_TEXT_INDEX_MAX_TOKEN));
+    }
+}
+
+/**
+ * @brief Compares posting list entries by ID, ignoring the removed flag.
+ *
+ * @param Left First entry.
+ * @param Right Second entry.
+ * @return true if Left holds the smaller ID.
+ */
+static bool bIdLess(std::uint32_t Left, std::uint32_t Right)
+{
+    return (Left & ~TASK_TEXT_INDEX_REMOVED) < (Right & ~TASK_TEXT_INDEX_REMOVED);
+}
+
+/**
+ * @brief Default constructor for TaskTextIndex.
+ */
+TaskTextIndex::TaskTextIndex() = default;
+
+/**
+ * @brief Tells whether the index has been built or loaded.
+ *
+ * @return true if the index tracks every task.
+ */
+bool TaskTextIndex::bIsBuilt(void) const
+{
+    return Built;
+}
+
+/**
+ * @brief Tells whether the index changed since it was built, loaded or saved.
+ *
+ * @return true if the saved copy is out of date.
+ */
+bool TaskTextIndex::bIsDirty(void) const
+{
+    return Dirty;
+}
+
+/**
+ * @brief Collects the tokens of a title and description into ScratchTokens.
+ *
+ * A token may be collected more than once; inserts and erases see the task's
+ * own ID on a repeat and skip it.
+ *
+ * @param title Task title.
+ * @param desc Task description.
+ */
+void TaskTextIndex::vidCollectTokens(std::string_view title, std::string_view desc)
+{
+    ScratchText.assign(title);
+    ScratchText.push_back(' ');
+    ScratchText.append(desc);
+    ScratchTokens.clear();
+    vidTokenize(ScratchText, ScratchTokens);
+}
+
+/**
+ * @brief Fills the index from a task list, replacing its content.
+ *
+ * @param tasks Tasks to index; tombstones are skipped.
+ */
+void TaskTextIndex::vidBuild(const TaskList &tasks)
+{
+    vidClear();
+    Built = true;
+    for (auto &it : tasks)
+    {
+        if (it.bIsRemoved() == true)
+        {
+            continue;
+        }
+        vidInsert(it.int32GetTaskID(), it.int32GetTaskTitle(), it.int32GetTaskDescription());
+    }
+}
+
+/**
+ * @brief Empties the index and marks it as unbuilt.
+ */
+void TaskTextIndex::vidClear(void)
+{
+    Lookup.clear();
+    Postings.clear();
+    Built = false;
+    Dirty = false;
+}
+
+/**
+ * @brief Adds the tokens of a task to the index.
+ *
+ * IDs usually arrive in ascending order and are appended; an older ID is
+ * inserted in place, or simply unflagged if it was removed before.
+ *
+ * @param id Task ID.
+ * @param title Task title.
+ * @param desc Task description.
+ */
+void TaskTextIndex::vidInsert(int id, std::string_view title, std::string_view desc)
+{
+    if (Built == false)
+    {
+        return;
+    }
+    Dirty = true;
+    std::uint32_t Id = static_cast<std::uint32_t>(id);
+    vidCollectTokens(title, desc);
+    for (std::string_view Token : ScratchTokens)
+    {
+        auto Found = Lookup.find(Token);
+        if (Found == Lookup.end())
+        {
+            auto Node = Postings.emplace(std::string(Token), Posting()).first;
+            Found = Lookup.emplace(Node->first, &Node->second).first;
+        }
+        auto &Ids = Found->second->Ids;
+        if (Ids.empty() == true || bIdLess(Ids.back(), Id) == true)
+        {
+            Ids.push_back(Id);
+            continue;
+        }
+        if (Ids.back() == Id)
+        {
+            continue;
+        }
+        auto Slot = std::lower_bound(Ids.begin(), Ids.end(), Id, bIdLess);
+        if (Slot != Ids.end() && bIdLess(Id, *Slot) == false)
+        {
+            if ((*Slot & TASK_TEXT_INDEX_REMOVED) != 0)
+            {
+                *Slot = Id;
+                --Found->second->Removed;
+            }
+        }
+        else
+        {
+            Ids.insert(Slot, Id);
+        }
+    }
+}
+
+/**
+ * @brief Removes the tokens of a task from the index.
+ *
+ * The ID is only flagged in each posting list. A list is compacted once half
+ * of its entries are flagged, and dropped once it is empty.
+ *
+ * @param id Task ID.
+ * @param title Title the task was indexed with.
+ * @param desc Description the task was indexed with.
+ */
+void TaskTextIndex::vidErase(int id, std::string_view title, std::string_view desc)
+{
+    if (Built == false)
+    {
+        return;
+    }
+    Dirty = true;
+    std::uint32_t Id = static_cast<std::uint32_t>(id);
+    vidCollectTokens(title, desc);
+    for (std::string_view Token : ScratchTokens)
+    {
+        auto Found = Lookup.find(Token);
+        if (Found == Lookup.end())
+        {
+            continue;
+        }
+        Posting &List = *Found->second;
+        auto Slot = std::lower_bound(List.Ids.begin(), List.Ids.end(), Id, bIdLess);
+        if (Slot == List.Ids.end() || *Slot != Id)
+        {
+            continue;
+        }
+        *Slot |= TASK_TEXT_INDEX_REMOVED;
+        if (++List.Removed * 2 > List.Ids.size())
+        {
+            List.Ids.erase(std::remove_if(List.Ids.begin(), List.Ids.end(), [](std::uint32_t Entry)
+                                          { return (Entry & TASK_TEXT_INDEX_REMOVED) != 0; }),
+                           List.Ids.end());
+            List.Removed = 0;
+            if (List.Ids.empty() == true)
+            {
+                Lookup.erase(Found);
+                Postings.erase(Postings.find(Token));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tells whether a posting list holds a live ID.
+ *
+ * @param List Posting list to search.
+ * @param id Task ID to look for.
+ * @return true if the ID is in the list and not flagged.
+ */
+bool TaskTextIndex::bContains(const Posting &List, std::uint32_t id)
+{
+    auto Slot = std::lower_bound(List.Ids.begin(), List.Ids.end(), id, bIdLess);
+    return Slot != List.Ids.end() && *Slot == id;
+}
+
+/**
+ * @brief Collects the posting lists of every token starting with a prefix.
+ *
+ * @param Prefix Token prefix.
+ * @param Lists Vector the posting lists are appended to.
+ */
+void TaskTextIndex::vidCollectPrefix(std::string_view Prefix, std::vector<const Posting *> &Lists) const
+{
+    for (auto it = Postings.lower_bound(Prefix); it != Postings.end() && it->first.compare(0, Prefix.size(), Prefix) == 0; ++it)
+    {
+        Lists.push_back(&it->second);
+    }
+}
+
+/**
+ * @brief Merges the live IDs of several posting lists.
+ *
+ * @param Lists Posting lists to merge.
+ * @param Ids Receives the IDs, sorted and without duplicates.
+ */
+void TaskTextIndex::vidMergeLive(const std::vector<const Posting *> &Lists, std::vector<std::uint32_t> &Ids)
+{
+    for (const Posting *List : Lists)
+    {
+        for (std::uint32_t Entry : List->Ids)
+        {
+            if ((Entry & TASK_TEXT_INDEX_REMOVED) == 0)
+            {
+                Ids.push_back(Entry);
+            }
+        }
+    }
+    std::sort(Ids.begin(), Ids.end());
+    Ids.erase(std::unique(Ids.begin(), Ids.end()), Ids.end());
+}
+
+/**
+ * @brief Finds the tasks matching a query.
+ *
+ * Each group of terms joined by "OR" is the set of posting lists of its exact
+ * terms and prefix expansions. The smallest group drives the search: its IDs
+ * are walked in order and every candidate is looked up in the other groups by
+ * binary search, so a query costs about the size of its most selective group
+ * times the log of the others. A group spanning several lists is merged into
+ * one sorted list only when it drives the search or when probing each of its
+ * lists would cost more than the merge.
+ *
+ * @param Query Terms to match (see the file description for the syntax).
+ * @return IDs of the matching tasks in ascending order.
+ */
+std::vector<int> TaskTextIndex::Search(std::string_view Query) const
+{
+    struct SearchTerm
+    {
+        std::string Token;          /**< Lowercased token or prefix. */
+        bool Prefix;                /**< true if the term matches every token starting with Token. */
+        bool OrWithPrevious;        /**< true if the term is an alternative to the term before it. */
+    };
+    struct SearchGroup
+    {
+        std::vector<const Posting *> Lists; /**< Posting lists of the alternatives of the group. */
+        std::size_t Size = 0;               /**< Number of live IDs over all the lists. */
+        std::vector<std::uint32_t> Ids;     /**< Sorted live IDs of all the lists, if Merged. */
+        bool Merged = false;                /**< true if the lists were merged into Ids. */
+    };
+
+    std::vector<SearchTerm> Terms;
+    std::string Lowered;
+    std::vector<std::string_view> Tokens;
+    bool PendingOr = false;
+    while (Query.empty() == false)
+    {
+        std::size_t Space = Query.find_first_of(" \t");
+        std::string_view Word = Query.substr(0, Space);
+        Query.remove_prefix((Space == std::string_view::npos) ? Query.size() : Space + 1);
+        if (Word.empty() == true)
+        {
+            continue;
+        }
+        if (Word == "OR" && Terms.empty() == false)
+        {
+            PendingOr = true;
+            continue;
+        }
+        bool Prefix = (Word.back() == '*');
+        Lowered.assign(Word);
+        Tokens.clear();
+        vidTokenize(Lowered, Tokens);
+        for (std::size_t Index = 0; Index < Tokens.size(); ++Index)
+        {
+            Terms.push_back({std::string(Tokens[Index]), Prefix && Index + 1 == Tokens.size(), Index == 0 && PendingOr});
+        }
+        PendingOr = false;
+    }
+    if (Built == false || Terms.empty() == true)
+    {
+        return {};
+    }
+
+    std::vector<SearchGroup> Groups;
+    for (std::size_t First = 0; First < Terms.size();)
+    {
+        std::size_t Last = First + 1;
+        while (Last < Terms.size() && Terms[Last].OrWithPrevious == true)
+        {
+            ++Last;
+        }
+        SearchGroup Group;
+        for (std::size_t Index = First; Index < Last; ++Index)
+        {
+            if (Terms[Index].Prefix == true)
+            {
+                vidCollectPrefix(Terms[Index].Token, Group.Lists);
+                continue;
+            }
+            auto Found = Lookup.find(Terms[Index].Token);
+            if (Found != Lookup.end())
+            {
+                Group.Lists.push_back(Found->second);
+            }
+        }
+        std::sort(Group.Lists.begin(), Group.Lists.end());
+        Group.Lists.erase(std::unique(Group.Lists.begin(), Group.Lists.end()), Group.Lists.end());
+        for (const Posting *List : Group.Lists)
+        {
+            Group.Size += List->Ids.size() - List->Removed;
+        }
+        if (Group.Size == 0)
+        {
+            return {};
+        }
+        Groups.push_back(std::move(Group));
+        First = Last;
+    }
+
+    std::size_t Smallest = 0;
+    for (std::size_t Index = 1; Index < Groups.size(); ++Index)
+    {
+        if (Groups[Index].Size < Groups[Smallest].Size)
+        {
+            Smallest = Index;
+        }
+    }
+    const std::size_t DriverSize = Groups[Smallest].Size;
+    for (std::size_t Index = 0; Index < Groups.size(); ++Index)
+    {
+        SearchGroup &Group = Groups[Index];
+        if (Group.Lists.size() > 1 && (Index == Smallest || DriverSize * Group.Lists.size() > Group.Size))
+        {
+            vidMergeLive(Group.Lists, Group.Ids);
+            Group.Merged = true;
+        }
+    }
+    const SearchGroup &Driver = Groups[Smallest];
+    const std::vector<std::uint32_t> &Candidates = (Driver.Merged == true) ? Driver.Ids : Driver.Lists.front()->Ids;
+
+    std::vector<int> Matches;
+    for (std::uint32_t Candidate : Candidates)
+    {
+        if ((Candidate & TASK_TEXT_INDEX_REMOVED) != 0)
+        {
+            continue;
+        }
+        bool Match = true;
+        for (std::size_t Index = 0; Index < Groups.size() && Match == true; ++Index)
+        {
+            if (Index == Smallest)
+            {
+                continue;
+            }
+            const SearchGroup &Group = Groups[Index];
+            Match = (Group.Merged == true) ? std::binary_search(Group.Ids.begin(), Group.Ids.end(), Candidate)
+                                           : std::any_of(Group.Lists.begin(), Group.Lists.end(), [Candidate](const Posting *List)
+                                                         { return bContains(*List, Candidate); });
+        }
+        if (Match == true)
+        {
+            Matches.push_back(static_cast<int>(Candidate));
+        }
+    }
+    return Matches;
+}
+
+/**
+ * @brief Writes the index to a file.
+ *
+ * Only live IDs are written. The index is written to "<path>.tmp" first and
+ * renamed over the old one, so a crash never leaves a half-written index.
+ *
+ * @param path Name of the index file.
+ * @param Stamp Stamp of the task files the index reflects (see u64FilesStamp()).
+ * @return true on success, false if the file could not be written.
+ */
+bool TaskTextIndex::bSave(const std::string &path, std::uint64_t Stamp)
+{
+    std::string TempFile = path + ".tmp";
+    std::ofstream FileHandler(TempFile, std::ios::binary | std::ios::trunc);
+    if (!FileHandler)
+    {
+        return false;
+    }
+
+    std::string Buffer(TASK_TEXT_INDEX_HEADER_SIZE, '\0');
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    Buffer.clear();
+    Buffer.reserve(TASK_TEXT_INDEX_FLUSH_SIZE + 4096);
+
+    BinaryWriter Writer(Buffer);
+    std::uint64_t Checksum = u64Checksum(nullptr, 0);
+    for (auto &[Token, List] : Postings)
+    {
+        Writer.vidWriteString(Token);
+        Writer.vidWriteU32(static_cast<std::uint32_t>(List.Ids.size() - List.Removed));
+        for (std::uint32_t Entry : List.Ids)
+        {
+            if ((Entry & TASK_TEXT_INDEX_REMOVED) == 0)
+            {
+                Writer.vidWriteU32(Entry);
+            }
+        }
+        if (Buffer.size() >= TASK_TEXT_INDEX_FLUSH_SIZE)
+        {
+            std::size_t Flushed = Buffer.size() & ~static_cast<std::size_t>(7);
+            Checksum = u64Checksum(Buffer.data(), Flushed, Checksum);
+            FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Flushed));
+            Buffer.erase(0, Flushed);
+        }
+    }
+    Checksum = u64Checksum(Buffer.data(), Buffer.size(), Checksum);
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+
+    Buffer.clear();
+    Buffer.append(TASK_TEXT_INDEX_MAGIC, sizeof(TASK_TEXT_INDEX_MAGIC));
+    Writer.vidWriteU32(TASK_TEXT_INDEX_VERSION);
+    Writer.vidWriteU32(0);
+    Writer.vidWriteU64(Stamp);
+    Writer.vidWriteU64(Postings.size());
+    Writer.vidWriteU64(Checksum);
+    FileHandler.seekp(0);
+    FileHandler.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+    FileHandler.close();
+    if (FileHandler.fail() == true)
+    {
+        return false;
+    }
+
+    std::error_code Error;
+    std::filesystem::rename(TempFile, path, Error);
+    if (!Error)
+    {
+        Dirty = false;
+    }
+    return !Error;
+}
+
+/**
+ * @brief Loads the index from a file if it matches the given stamp.
+ *
+ * @param path Name of the index file.
+ * @param Stamp Stamp the index must have been saved with.
+ * @return true if the index was loaded, false if it is missing, stale or corrupted.
+ */
+bool TaskTextIndex::bLoad(const std::string &path, std::uint64_t Stamp)
+{
+    vidClear();
+    MappedFile File(path);
+    std::string_view Content = File.View();
+    if (Content.size() < TASK_TEXT_INDEX_HEADER_SIZE ||
+        std::memcmp(Content.data(), TASK_TEXT_INDEX_MAGIC, sizeof(TASK_TEXT_INDEX_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    BinaryReader Header(Content.data() + sizeof(TASK_TEXT_INDEX_MAGIC), TASK_TEXT_INDEX_HEADER_SIZE - sizeof(TASK_TEXT_INDEX_MAGIC));
+    std::uint32_t Version = Header.u32Read();
+    Header.u32Read();
+    std::uint64_t SavedStamp = Header.u64Read();
+    std::uint64_t Count = Header.u64Read();
+    std::uint64_t Checksum = Header.u64Read();
+
+    const char *Payload = Content.data() + TASK_TEXT_INDEX_HEADER_SIZE;
+    std::size_t PayloadSize = Content.size() - TASK_TEXT_INDEX_HEADER_SIZE;
+    if (Version != TASK_TEXT_INDEX_VERSION || SavedStamp != Stamp || u64Checksum(Payload, PayloadSize) != Checksum)
+    {
+        return false;
+    }
+
+    BinaryReader Reader(Payload, PayloadSize);
+    Lookup.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(Count, PayloadSize / 8)));
+    for (std::uint64_t Index = 0; Index < Count; ++Index)
+    {
+        std::string_view Token = Reader.svRead();
+        std::uint32_t Size = Reader.u32Read();
+        if (Reader.bFailed() == true || Reader.u64Remaining() / 4 < Size)
+        {
+            vidClear();
+            return false;
+        }
+        auto Node = Postings.emplace_hint(Postings.end(), std::string(Token), Posting());
+        Lookup.emplace(Node->first, &Node->second);
+        Posting &List = Node->second;
+        List.Ids.resize(Size);
+        for (auto &Entry : List.Ids)
+        {
+            Entry = Reader.u32Read();
+        }
+    }
+    if (Reader.u64Remaining() != 0)
+    {
+        vidClear();
+        return false;
+    }
+    Built = true;
+    return true;
+}
+
+/**
+ * @brief Computes a stamp of the size and modification time of some files.
+ *
+ * @param Paths Names of the files.
+ * @return Stamp that changes whenever one of the files does.
+ */
+std::uint64_t u64FilesStamp(const std::vector<std::string> &Paths)
+{
+    std::string Buffer;
+    BinaryWriter Writer(Buffer);
+    for (auto &Path : Paths)
+    {
+        std::error_code Error;
+        std::uint64_t Size = std::filesystem::file_size(Path, Error);
+        if (Error)
+        {
+            Writer.vidWriteU64(~static_cast<std::uint64_t>(0));
+            Writer.vidWriteU64(0);
+            continue;
+        }
+        auto Modified = std::filesystem::last_write_time(Path, Error);
+        Writer.vidWriteU64(Size);
+        Writer.vidWriteU64(static_cast<std::uint64_t>(Modified.time_since_epoch().count()));
+    }
+    return u64Checksum(Buffer.data(), Buffer.size());
+}
@@ -0,0 +1,190 @@
+/**
+ * @file task_text_index.hpp
+ * @brief Declaration of the TaskTextIndex class, an inverted index over task titles and descriptions.
+ *
+ * Titles and descriptions are split into tokens: runs of letters and digits,
+ * lowercased. Each token maps to the sorted list of the IDs of the tasks that
+ * contain it. Removing a task only flags its ID in each list, and a list is
+ * compacted once half of it is flagged, so updates never shift whole lists.
+ *
+ * A query is a sequence of terms that must all match. Terms joined by "OR"
+ * match if either does, and a term ending in '*' matches every token starting
+ * with it. For example "report OR summary draft*" finds the tasks containing
+ * "report" or "summary" and some token starting with "draft".
+ *
+ * The index can be saved next to its task file, stamped with the size and
+ * modification time of the files it was built from, and loaded back as long
+ * as those files are unchanged.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__TEXT__INDEX__
+#define __TASK__TEXT__INDEX__
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "task.hpp"
+
+/**
+ * @brief Current version of the saved index format.
+ */
+constexpr std::uint32_t TASK_TEXT_INDEX_VERSION = 1;
+
+/**
+ * @class TaskTextIndex
+ * @brief Inverted index from title and description tokens to task IDs.
+ *
+ * The index starts out unbuilt, and inserts and erases are ignored until it is
+ * built or loaded.
+ */
+class TaskTextIndex
+{
+private:
+    /**
+     * @struct Posting
+     * @brief Sorted IDs of the tasks containing one token.
+     */
+    struct Posting
+    {
+        std::vector<std::uint32_t> Ids;     /**< Task IDs in ascending order; the top bit flags a removed ID. */
+        std::uint32_t Removed = 0;          /**< Number of flagged IDs. */
+    };
+
+    std::map<std::string, Posting, std::less<>> Postings;  /**< Posting list of each token, in token order. */
+    std::unordered_map<std::string_view, Posting *> Lookup; /**< Hashed access to Postings, keyed by views of its tokens. */
+    std::string ScratchText;                /**< Reusable buffer for the lowercased text of one task. */
+    std::vector<std::string_view> ScratchTokens; /**< Reusable buffer for the tokens of one task, viewing ScratchText. */
+    bool Built = false;                     /**< true once the index tracks every task. */
+    bool Dirty = false;                     /**< true if the index changed since it was built, loaded or saved. */
+
+    /**
+     * @brief Collects the tokens of a title and description into ScratchTokens.
+     *
+     * @param title Task title.
+     * @param desc Task description.
+     */
+    void vidCollectTokens(std::string_view title, std::string_view desc);
+
+    /**
+     * @brief Collects the posting lists of every token starting with a prefix.
+     *
+     * @param Prefix Token prefix.
+     * @param Lists Vector the posting lists are appended to.
+     */
+    void vidCollectPrefix(std::string_view Prefix, std::vector<const Posting *> &Lists) const;
+
+    /**
+     * @brief Tells whether a posting list holds a live ID.
+     *
+     * @param List Posting list to search.
+     * @param id Task ID to look for.
+     * @return true if the ID is in the list and not flagged.
+     */
+    static bool bContains(const Posting &List, std::uint32_t id);
+
+    /**
+     * @brief Merges the live IDs of several posting lists.
+     *
+     * @param Lists Posting lists to merge.
+     * @param Ids Receives the IDs, sorted and without duplicates.
+     */
+    static void vidMergeLive(const std::vector<const Posting *> &Lists, std::vector<std::uint32_t> &Ids);
+
+public:
+    /**
+     * @brief Default constructor for TaskTextIndex.
+     */
+    TaskTextIndex();
+
+    TaskTextIndex(const TaskTextIndex &) = delete;
+    TaskTextIndex &operator=(const TaskTextIndex &) = delete;
+
+    /**
+     * @brief Tells whether the index has been built or loaded.
+     *
+     * @return true if the index tracks every task.
+     */
+    bool bIsBuilt(void) const;
+
+    /**
+     * @brief Tells whether the index changed since it was built, loaded or saved.
+     *
+     * @return true if the saved copy is out of date.
+     */
+    bool bIsDirty(void) const;
+
+    /**
+     * @brief Fills the index from a task list, replacing its content.
+     *
+     * @param tasks Tasks to index; tombstones are skipped.
+     */
+    void vidBuild(const TaskList &tasks);
+
+    /**
+     * @brief Empties the index and marks it as unbuilt.
+     */
+    void vidClear(void);
+
+    /**
+     * @brief Adds the tokens of a task to the index.
+     *
+     * @param id Task ID.
+     * @param title Task title.
+     * @param desc Task description.
+     */
+    void vidInsert(int id, std::string_view title, std::string_view desc);
+
+    /**
+     * @brief Removes the tokens of a task from the index.
+     *
+     * @param id Task ID.
+     * @param title Title the task was indexed with.
+     * @param desc Description the task was indexed with.
+     */
+    void vidErase(int id, std::string_view title, std::string_view desc);
+
+    /**
+     * @brief Finds the tasks matching a query.
+     *
+     * @param Query Terms to match (see the file description for the syntax).
+     * @return IDs of the matching tasks in ascending order.
+     */
+    std::vector<int> Search(std::string_view Query) const;
+
+    /**
+     * @brief Writes the index to a file.
+     *
+     * @param path Name of the index file.
+     * @param Stamp Stamp of the task files the index reflects (see u64FilesStamp()).
+     * @return true on success, false if the file could not be written.
+     */
+    bool bSave(const std::string &path, std::uint64_t Stamp);
+
+    /**
+     * @brief Loads the index from a file if it matches the given stamp.
+     *
+     * @param path Name of the index file.
+     * @param Stamp Stamp the index must have been saved with.
+     * @return true if the index was loaded, false if it is missing, stale or corrupted.
+     */
+    bool bLoad(const std::string &path, std::uint64_t Stamp);
+};
+
+/**
+ * @brief Computes a stamp of the size and modification time of some files.
+ *
+ * Missing files are part of the stamp too, so creating or deleting one of them
+ * changes it.
+ *
+ * @param Paths Names of the files.
+ * @return Stamp that changes whenever one of the files does.
+ */
+std::uint64_t u64FilesStamp(const std::vector<std::string> &Paths);
+
+#endif // __TASK__TEXT__INDEX__
@@ -0,0 +1,191 @@
+/**
+ * @file task_text_scanner.cpp
+ * @brief Implementation of the vectorized delimiter scanner.
+ *
+ * The vector scanners compare a whole register of bytes against each delimiter
+ * at once, fold the three results into a bit mask with one bit per byte, and
+ * emit the offset of every set bit. The AVX2 and SSE2 versions are compiled
+ * with per-function target attributes, so the rest of the program needs no
+ * special compiler flags and still runs on processors without them.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_text_scanner.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define TASK_TEXT_SCANNER_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Tells whether a byte is one of the delimiters of the text format.
+ *
+ * @param Byte Byte to test.
+ * @return true for '|', ':' and '\n'.
+ */
+static bool bIsDelimiter(char Byte)
+{
+    return Byte == '|' || Byte == ':' || Byte == '\n';
+}
+
+/**
+ * @brief Scans a range one byte at a time.
+ *
+ * @param Block Whole block being scanned.
+ * @param Offset Offset of the first byte to scan.
+ * @param Positions Array the offsets are written to.
+ * @return Pointer past the last offset written.
+ */
+static std::uint32_t *pScanScalar(std::string_view Block, std::size_t Offset, std::uint32_t *Positions)
+{
+    for (; Offset < Block.size(); ++Offset)
+    {
+        if (bIsDelimiter(Block[Offset]) == true)
+        {
+            *Positions++ = static_cast<std::uint32_t>(Offset);
+        }
+    }
+    return Positions;
+}
+
+#ifdef TASK_TEXT_SCANNER_X86
+
+/**
+ * @brief Writes the offset of every set bit of a mask.
+ *
+ * @param Mask One bit per byte, set for the delimiters.
+ * @param Base Offset of the byte matching bit 0.
+ * @param Positions Array the offsets are written to.
+ * @return Pointer past the last offset written.
+ */
+static inline std::uint32_t *pEmitMask(std::uint32_t Mask, std::size_t Base, std::uint32_t *Positions)
+{
+    while (Mask != 0)
+    {
+        *Positions++ = static_cast<std::uint32_t>(Base + static_cast<std::size_t>(__builtin_ctz(Mask)));
+        Mask &= Mask - 1;
+    }
+    return Positions;
+}
+
+/**
+ * @brief Scans a block 16 bytes at a time with SSE2.
+ *
+ * @param Block Block to scan.
+ * @param Positions Array the offsets are written to.
+ * @return Pointer past the last offset written.
+ */
+__attribute__((target("sse2"))) static std::uint32_t *pScanSse2(std::string_view Block, std::uint32_t *Positions)
+{
+    const __m128i Pipe = _mm_set1_epi8('|');
+    const __m128i Colon = _mm_set1_epi8(':');
+    const __m128i NewLine = _mm_set1_epi8('\n');
+    std::size_t Offset = 0;
+    for (; Offset + 16 <= Block.size(); Offset += 16)
+    {
+        __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Block.data() + Offset));
+        __m128i Hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Bytes, Pipe), _mm_cmpeq_epi8(Bytes, Colon)),
+                                    _mm_cmpeq_epi8(Bytes, NewLine));
+        Positions = pEmitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(Hits)), Offset, Positions);
+    }
+    return pScanScalar(Block, Offset, Positions);
+}
+
+/**
+ * @brief Scans a block 32 bytes at a time with AVX2.
+ *
+ * @param Block Block to scan.
+ * @param Positions Array the offsets are written to.
+ * @return Pointer past the last offset written.
+ */
+__attribute__((target("avx2"))) static std::uint32_t *pScanAvx2(std::string_view Block, std::uint32_t *Positions)
+{
+    const __m256i Pipe = _mm256_set1_epi8('|');
+    const __m256i Colon = _mm256_set1_epi8(':');
+    const __m256i NewLine = _mm256_set1_epi8('\n');
+    std::size_t Offset = 0;
+    for (; Offset + 32 <= Block.size(); Offset += 32)
+    {
+        __m256i Bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(Block.data() + Offset));
+        __m256i Hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(Bytes, Pipe), _mm256_cmpeq_epi8(Bytes, Colon)),
+                                       _mm256_cmpeq_epi8(Bytes, NewLine));
+        Positions = pEmitMask(static_cast<std::uint32_t>(_mm256_movemask_epi8(Hits)), Offset, Positions);
+    }
+    return pScanScalar(Block, Offset, Positions);
+}
+
+#endif // TASK_TEXT_SCANNER_X86
+
+/**
+ * @brief Gets the fastest scan level supported by the running processor.
+ *
+ * @return Detected scan level, computed once and cached.
+ */
+ScanLevel GetBestScanLevel(void)
+{
+    static const ScanLevel Best = []()
+    {
+#ifdef TASK_TEXT_SCANNER_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return ScanLevel::Avx2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return ScanLevel::Sse2;
+        }
+#endif
+        return ScanLevel::Scalar;
+    }();
+    return Best;
+}
+
+/**
+ * @brief Gets the display name of a scan level.
+ *
+ * @param Level Scan level.
+ * @return "scalar", "sse2" or "avx2".
+ */
+std::string_view GetScanLevelName(ScanLevel Level)
+{
+    switch (Level)
+    {
+    case ScanLevel::Sse2:
+        return "sse2";
+    case ScanLevel::Avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+/**
+ * @brief Finds the offsets of every '|', ':' and '\n' in a block of text.
+ *
+ * @param Block Text to scan; under 4 GiB so offsets fit in 32 bits.
+ * @param Positions Array receiving the offsets in ascending order; it must have room for Block.size() entries.
+ * @param Level Scan level to use; it must be supported by the running processor.
+ * @return Number of offsets written.
+ */
+std::size_t u64ScanDelimiters(std::string_view Block, std::uint32_t *Positions, ScanLevel Level)
+{
+    std::uint32_t *End = nullptr;
+    switch (Level)
+    {
+#ifdef TASK_TEXT_SCANNER_X86
+    case ScanLevel::Avx2:
+        End = pScanAvx2(Block, Positions);
+        break;
+    case ScanLevel::Sse2:
+        End = pScanSse2(Block, Positions);
+        break;
+#endif
+    default:
+        End = pScanScalar(Block, 0, Positions);
+        break;
+    }
+    return static_cast<std::size_t>(End - Positions);
+}
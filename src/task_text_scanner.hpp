@@ -0,0 +1,58 @@
+/**
+ * @file task_text_scanner.hpp
+ * @brief Declaration of the vectorized delimiter scanner used by the text task loader.
+ *
+ * The scanner finds every '|', ':' and newline in a block of text in one pass
+ * and records their offsets, so the field splitter walks a short list of
+ * positions instead of searching each line byte by byte. On x86 processors
+ * the block is compared 32 bytes at a time with AVX2 or 16 bytes at a time
+ * with SSE2, whichever the running processor supports; elsewhere a scalar
+ * loop is used.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#ifndef __TASK__TEXT__SCANNER__
+#define __TASK__TEXT__SCANNER__
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @enum ScanLevel
+ * @brief Instruction sets the delimiter scanner can use.
+ */
+enum class ScanLevel : std::uint8_t
+{
+    Scalar,     /**< One byte at a time; available everywhere. */
+    Sse2,       /**< 16 bytes at a time with SSE2. */
+    Avx2        /**< 32 bytes at a time with AVX2. */
+};
+
+/**
+ * @brief Gets the fastest scan level supported by the running processor.
+ *
+ * @return Detected scan level, computed once and cached.
+ */
+ScanLevel GetBestScanLevel(void);
+
+/**
+ * @brief Gets the display name of a scan level.
+ *
+ * @param Level Scan level.
+ * @return "scalar", "sse2" or "avx2".
+ */
+std::string_view GetScanLevelName(ScanLevel Level);
+
+/**
+ * @brief Finds the offsets of every '|', ':' and '\n' in a block of text.
+ *
+ * @param Block Text to scan; under 4 GiB so offsets fit in 32 bits.
+ * @param Positions Array receiving the offsets in ascending order; it must have room for Block.size() entries.
+ * @param Level Scan level to use; it must be supported by the running processor.
+ * @return Number of offsets written.
+ */
+std::size_t u64ScanDelimiters(std::string_view Block, std::uint32_t *Positions, ScanLevel Level);
+
+#endif // __TASK__TEXT__SCANNER__
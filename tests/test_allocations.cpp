@@ -0,0 +1,205 @@
+/**
+ * @file test_allocations.cpp
+ * @brief Checks that the task hot paths make no heap allocation per task.
+ *
+ * The global operator new is replaced by one that counts its calls, so the
+ * test sees every heap allocation of the program. Once the manager is warmed
+ * up, adding, looking up and updating tasks must not allocate at all, and
+ * listing or saving many tasks must allocate a fixed amount however many
+ * tasks there are.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_manager.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <new>
+#include <string>
+
+/**
+ * @brief Number of heap allocations made so far by the program.
+ */
+static std::size_t Allocations = 0;
+
+/**
+ * @brief Allocates memory like the standard operator new, counting the call.
+ *
+ * @param Size Number of bytes.
+ * @return Allocated memory.
+ */
+void *operator new(std::size_t Size)
+{
+    ++Allocations;
+    void *Memory = std::malloc((Size == 0) ? 1 : Size);
+    if (Memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return Memory;
+}
+
+/**
+ * @brief Frees memory allocated by the counting operator new.
+ *
+ * @param Memory Memory to free.
+ */
+void operator delete(void *Memory) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Frees memory allocated by the counting operator new.
+ *
+ * @param Memory Memory to free.
+ */
+void operator delete(void *Memory, std::size_t) noexcept
+{
+    std::free(Memory);
+}
+
+/**
+ * @brief Number of tasks each step works on.
+ */
+static constexpr int TEST_TASKS = 20000;
+
+/**
+ * @brief Most allocations a listing or a save may make, whatever the number of tasks.
+ */
+static constexpr std::size_t TEST_FIXED_ALLOCATIONS = 64;
+
+/**
+ * @class NullBuffer
+ * @brief Stream buffer discarding everything written to it, without allocating.
+ */
+class NullBuffer : public std::streambuf
+{
+protected:
+    int overflow(int Character) override
+    {
+        return Character;
+    }
+
+    std::streamsize xsputn(const char *, std::streamsize Count) override
+    {
+        return Count;
+    }
+};
+
+/**
+ * @brief Number of failed checks.
+ */
+static int Failures = 0;
+
+/**
+ * @brief Reports the allocations made by a step and checks them against a limit.
+ *
+ * @param Step Name of the step.
+ * @param Before Allocation count when the step started.
+ * @param Limit Most allocations the step may make.
+ */
+static void vidCheck(const char *Step, std::size_t Before, std::size_t Limit)
+{
+    std::size_t Made = Allocations - Before;
+    std::cout << Step << ": " << Made << " Allocations" << std::endl;
+    if (Made > Limit)
+    {
+        std::cerr << "FAILED: " << Step << " Made " << Made << " Allocations, At Most " << Limit << " Expected" << std::endl;
+        ++Failures;
+    }
+}
+
+/**
+ * @brief Adds TEST_TASKS tasks whose text does not fit in the small string buffer.
+ *
+ * @param manager Manager to add to.
+ */
+static void vidAddTasks(TaskManager &manager)
+{
+    for (int Index = 0; Index < TEST_TASKS; ++Index)
+    {
+        manager.addTask(std::string_view("Title of a task that is long"),
+                        std::string_view("Description of a task, long enough to need its own storage"), TASK_NO_DUE_DATE,
+                        TaskPriority::Low);
+    }
+}
+
+/**
+ * @brief Runs every step and reports the result.
+ *
+ * @return 0 if every step stayed within its limit, 1 otherwise.
+ */
+int main()
+{
+    std::string Directory = (std::filesystem::temp_directory_path() / "taskmanager_test_allocations").string();
+    std::filesystem::create_directories(Directory);
+    NullBuffer Discard;
+    std::ostream Out(&Discard);
+    std::cout.setstate(std::ios::badbit);   /*Keep The Save Messages Quiet, Without Allocating*/
+
+    TaskManager manager;
+    vidAddTasks(manager);
+    int FirstId = 1;
+    for (int id = FirstId; id < FirstId + TEST_TASKS; ++id)
+    {
+        manager.removeTask(id);
+    }
+    FirstId += TEST_TASKS;
+
+    std::size_t Before = Allocations;
+    vidAddTasks(manager);
+    std::cout.clear();
+    vidCheck("Add", Before, 0);
+
+    Before = Allocations;
+    for (int id = FirstId; id < FirstId + TEST_TASKS; ++id)
+    {
+        if (manager.findTask(id) == nullptr)
+        {
+            std::cerr << "FAILED: Task " << id << " Not Found" << std::endl;
+            ++Failures;
+            break;
+        }
+    }
+    vidCheck("Get", Before, 0);
+
+    Before = Allocations;
+    for (int id = FirstId; id < FirstId + TEST_TASKS; ++id)
+    {
+        manager.setTitle(id, "Other title of the task, long");
+        manager.setDescription(id, "Other description of the task, also long enough");
+        manager.setStatus(id, TaskState::Done);
+        manager.setPriority(id, TaskPriority::High);
+        manager.setDueDate(id, 20000);
+    }
+    vidCheck("Update", Before, 0);
+
+    Before = Allocations;
+    manager.listTasks(Out);
+    vidCheck("List", Before, TEST_FIXED_ALLOCATIONS);
+
+    for (const char *Extension : {".txt", ".bin"})
+    {
+        std::string Path = Directory + "/tasks" + Extension;
+        std::cout.setstate(std::ios::badbit);
+        Before = Allocations;
+        manager.SaveTasksToFile(Path);
+        std::size_t Made = Allocations - Before;
+        std::cout.clear();
+        std::cout << "Save " << Extension << ": " << Made << " Allocations" << std::endl;
+        if (Made > TEST_FIXED_ALLOCATIONS)
+        {
+            std::cerr << "FAILED: Save " << Extension << " Made " << Made << " Allocations, At Most "
+                      << TEST_FIXED_ALLOCATIONS << " Expected" << std::endl;
+            ++Failures;
+        }
+        manager.setStatus(FirstId, TaskState::Pending);
+    }
+
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    return (Failures == 0) ? 0 : 1;
+}
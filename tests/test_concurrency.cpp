@@ -0,0 +1,334 @@
+/**
+ * @file test_concurrency.cpp
+ * @brief Stress test of ConcurrentTaskManager with readers running while writers mutate.
+ *
+ * Writers keep rewriting the text, status, priority and due date of tasks,
+ * and removing tasks and adding new ones. Every title and description is one
+ * character repeated, at one of two lengths, so a task copied while it was
+ * half written shows up as mixed characters or an unexpected length.
+ * Meanwhile readers look tasks up, run queries and list every task, and check
+ * that:
+ *
+ * - no task they get is torn;
+ * - a lookup by ID returns the task with that ID;
+ * - a query returns only tasks matching its filter, each once, in due date and ID order;
+ * - a listing holds each ID once, in ascending order.
+ *
+ * Once the writers are done, the task count, the ID index and the secondary
+ * index must agree.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "concurrent_task_manager.hpp"
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Number of tasks added before the threads start.
+ */
+static constexpr int TEST_TASKS = 2000;
+
+/**
+ * @brief Number of changes each writer makes.
+ */
+static constexpr int TEST_WRITES = 40000;
+
+/**
+ * @brief Number of writer threads, each changing its own share of the tasks.
+ */
+static constexpr int TEST_WRITERS = 2;
+
+/**
+ * @brief Number of reader threads.
+ */
+static constexpr int TEST_READERS = 2;
+
+/**
+ * @brief Short text length, within the small string buffer.
+ */
+static constexpr std::size_t TEST_SHORT_TEXT = 8;
+
+/**
+ * @brief Long text length, stored out of line.
+ */
+static constexpr std::size_t TEST_LONG_TEXT = 200;
+
+/**
+ * @brief First due day used by the test.
+ */
+static constexpr std::int32_t TEST_FIRST_DAY = 20000;
+
+/**
+ * @brief Number of due days used by the test.
+ */
+static constexpr std::int32_t TEST_DAYS = 100;
+
+/**
+ * @brief Number of failed checks.
+ */
+static std::atomic<int> Failures{0};
+
+/**
+ * @brief Guards the failure messages.
+ */
+static std::mutex ReportLock;
+
+/**
+ * @brief Reports a failed check; only the first ones are printed.
+ *
+ * @param Message Description of the failure.
+ */
+static void vidFail(const std::string &Message)
+{
+    if (Failures++ < 10)
+    {
+        std::lock_guard<std::mutex> Guard(ReportLock);
+        std::cerr << "FAILED: " << Message << std::endl;
+    }
+}
+
+/**
+ * @brief Tells whether a text was written whole by the test.
+ *
+ * @param Text Title or description.
+ * @return true if the text is one character repeated, at one of the two test lengths.
+ */
+static bool bIsWhole(std::string_view Text)
+{
+    if (Text.size() != TEST_SHORT_TEXT && Text.size() != TEST_LONG_TEXT)
+    {
+        return false;
+    }
+    return Text.find_first_not_of(Text[0]) == std::string_view::npos;
+}
+
+/**
+ * @brief Checks that a task got from the store is not torn.
+ *
+ * @param task Task copy.
+ * @param Where Operation the task came from, reported on failure.
+ */
+static void vidCheckTask(const Task &task, const char *Where)
+{
+    if (bIsWhole(task.int32GetTaskTitle()) == false || bIsWhole(task.int32GetTaskDescription()) == false)
+    {
+        vidFail(std::string(Where) + ": Task " + std::to_string(task.int32GetTaskID()) + " Is Torn");
+    }
+}
+
+/**
+ * @brief Makes a test text.
+ *
+ * @param Round Number of the change, which picks the character and the length.
+ * @param First First character of the range the character is taken from.
+ * @return One character repeated.
+ */
+static std::string MakeText(int Round, char First)
+{
+    return std::string((Round % 2 == 0) ? TEST_LONG_TEXT : TEST_SHORT_TEXT, static_cast<char>(First + Round % 26));
+}
+
+/**
+ * @brief Runs the changes of one writer.
+ *
+ * Writer w owns the tasks whose slot in Ids is w modulo TEST_WRITERS, and
+ * replaces the ID of a slot when it removes its task and adds another.
+ *
+ * @param Store Store to change.
+ * @param Ids IDs of the tasks, by slot.
+ * @param Writer Number of the writer.
+ */
+static void vidWrite(ConcurrentTaskManager &Store, std::vector<int> &Ids, int Writer)
+{
+    std::mt19937 Random(static_cast<unsigned>(Writer) + 1);
+    for (int Round = 0; Round < TEST_WRITES; ++Round)
+    {
+        std::size_t Slot = (Random() % (Ids.size() / TEST_WRITERS)) * TEST_WRITERS + static_cast<std::size_t>(Writer);
+        int id = Ids[Slot];
+        bool Found = true;
+        switch (Round % 6)
+        {
+        case 0:
+            Found = Store.setTitle(id, MakeText(Round, 'a'));
+            break;
+        case 1:
+            Found = Store.setDescription(id, MakeText(Round, 'A'));
+            break;
+        case 2:
+            Found = Store.setStatus(id, (Random() % 2 == 0) ? TaskState::Done : TaskState::Pending);
+            break;
+        case 3:
+            Found = Store.setPriority(id, static_cast<TaskPriority>(Random() % 4));
+            break;
+        case 4:
+            Found = Store.setDueDate(id, TEST_FIRST_DAY + static_cast<std::int32_t>(Random() % TEST_DAYS));
+            break;
+        default:
+            Found = Store.removeTask(id);
+            Ids[Slot] = Store.addTask(MakeText(Round, 'a'), MakeText(Round + 1, 'A'),
+                                      TEST_FIRST_DAY + static_cast<std::int32_t>(Random() % TEST_DAYS), TaskPriority::Low);
+            break;
+        }
+        if (Found == false)
+        {
+            vidFail("Writer " + std::to_string(Writer) + " Lost Task " + std::to_string(id));
+        }
+    }
+}
+
+/**
+ * @brief Checks a listing: every task whole and each ID once, in ascending order.
+ *
+ * @param Listing Text written by listTasks().
+ */
+static void vidCheckListing(const std::string &Listing)
+{
+    std::istringstream Lines(Listing);
+    std::string Line;
+    long long LastId = 0;
+    while (std::getline(Lines, Line))
+    {
+        if (Line.compare(0, 4, "ID: ") == 0)
+        {
+            long long id = std::stoll(Line.substr(4));
+            if (id <= LastId)
+            {
+                vidFail("Listing: ID " + std::to_string(id) + " After " + std::to_string(LastId));
+            }
+            LastId = id;
+        }
+        else if ((Line.compare(0, 7, "Title: ") == 0 && bIsWhole(std::string_view(Line).substr(7)) == false) ||
+                 (Line.compare(0, 13, "Description: ") == 0 && bIsWhole(std::string_view(Line).substr(13)) == false))
+        {
+            vidFail("Listing: Task After ID " + std::to_string(LastId) + " Is Torn");
+        }
+    }
+}
+
+/**
+ * @brief Runs lookups, queries and listings until the writers are done.
+ *
+ * @param Store Store to read.
+ * @param Done Set once every writer finished.
+ * @param Reader Number of the reader.
+ */
+static void vidRead(const ConcurrentTaskManager &Store, const std::atomic<bool> &Done, int Reader)
+{
+    std::mt19937 Random(static_cast<unsigned>(Reader) + 100);
+    Task Copy;
+    for (int Round = 0; Done.load() == false || Round < 3; ++Round)
+    {
+        int MaxId = TEST_TASKS + TEST_WRITES;
+        for (int Lookup = 0; Lookup < 1000; ++Lookup)
+        {
+            int id = 1 + static_cast<int>(Random() % static_cast<unsigned>(MaxId));
+            if (Store.bGetTask(id, Copy) == true)
+            {
+                if (Copy.int32GetTaskID() != id)
+                {
+                    vidFail("Lookup Of " + std::to_string(id) + " Returned Task " + std::to_string(Copy.int32GetTaskID()));
+                }
+                vidCheckTask(Copy, "Lookup");
+            }
+        }
+
+        TaskFilter Filter;
+        Filter.HasState = (Random() % 2 == 0);
+        Filter.State = (Random() % 2 == 0) ? TaskState::Done : TaskState::Pending;
+        Filter.HasPriority = (Random() % 2 == 0);
+        Filter.Priority = static_cast<TaskPriority>(Random() % 4);
+        Filter.DueFrom = TEST_FIRST_DAY + static_cast<std::int32_t>(Random() % TEST_DAYS);
+        Filter.DueTo = Filter.DueFrom + static_cast<std::int32_t>(Random() % TEST_DAYS);
+        std::vector<Task> Matches = Store.Query(Filter);
+        for (std::size_t Index = 0; Index < Matches.size(); ++Index)
+        {
+            const Task &it = Matches[Index];
+            vidCheckTask(it, "Query");
+            if ((Filter.HasState == true && it.GetTaskState() != Filter.State) ||
+                (Filter.HasPriority == true && it.GetTaskPriority() != Filter.Priority) ||
+                it.int32GetDueDay() < Filter.DueFrom || it.int32GetDueDay() > Filter.DueTo)
+            {
+                vidFail("Query Returned Task " + std::to_string(it.int32GetTaskID()) + ", Which Does Not Match");
+            }
+            if (Index > 0 && std::make_pair(Matches[Index - 1].int32GetDueDay(), Matches[Index - 1].int32GetTaskID()) >=
+                                 std::make_pair(it.int32GetDueDay(), it.int32GetTaskID()))
+            {
+                vidFail("Query Returned Task " + std::to_string(it.int32GetTaskID()) + " Twice Or Out Of Order");
+            }
+        }
+
+        if (Round % 4 == 0)
+        {
+            std::ostringstream Listing;
+            Store.listTasks(Listing);
+            vidCheckListing(Listing.str());
+        }
+    }
+}
+
+/**
+ * @brief Runs the writers and readers, then checks the final state.
+ *
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main()
+{
+    ConcurrentTaskManager Store(8);
+    std::vector<int> Ids;
+    for (int Index = 0; Index < TEST_TASKS; ++Index)
+    {
+        Ids.push_back(Store.addTask(MakeText(Index, 'a'), MakeText(Index, 'A'),
+                                    TEST_FIRST_DAY + Index % TEST_DAYS, TaskPriority::Medium));
+    }
+
+    std::atomic<bool> Done{false};
+    std::vector<std::thread> Readers;
+    for (int Reader = 0; Reader < TEST_READERS; ++Reader)
+    {
+        Readers.emplace_back(vidRead, std::cref(Store), std::cref(Done), Reader);
+    }
+    std::vector<std::thread> Writers;
+    for (int Writer = 0; Writer < TEST_WRITERS; ++Writer)
+    {
+        Writers.emplace_back(vidWrite, std::ref(Store), std::ref(Ids), Writer);
+    }
+    for (auto &Writer : Writers)
+    {
+        Writer.join();
+    }
+    Done = true;
+    for (auto &Reader : Readers)
+    {
+        Reader.join();
+    }
+
+    std::vector<Task> All = Store.Query(TaskFilter());
+    if (All.size() != Store.size() || Store.size() != Ids.size())
+    {
+        vidFail("Store Holds " + std::to_string(Store.size()) + " Tasks, The Index " + std::to_string(All.size()) +
+                ", " + std::to_string(Ids.size()) + " Expected");
+    }
+    Task Copy;
+    for (int id : Ids)
+    {
+        if (Store.bGetTask(id, Copy) == false || Copy.int32GetTaskID() != id)
+        {
+            vidFail("Task " + std::to_string(id) + " Cannot Be Found By ID");
+        }
+    }
+    for (const Task &it : All)
+    {
+        vidCheckTask(it, "Final Query");
+    }
+
+    std::cout << Store.size() << " Tasks, " << Failures.load() << " Failed Checks" << std::endl;
+    return (Failures.load() == 0) ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_legacy_fields.cpp
+ * @brief Checks that due dates and priorities written in free form survive a load and a save.
+ *
+ * Older task files hold due dates and priorities as free text. A task file
+ * with such fields is loaded, one of its tasks is changed through the journal
+ * and the manager is dropped without saving; the file is then loaded again,
+ * its journal replayed, and saved. The free-form text must still be in the
+ * saved file, a binary save must refuse to drop it, and setting a due date or
+ * priority must replace it.
+ *
+ * @author Mohamed Waaer
+ * @date 2025-07-25
+ */
+
+#include "task_manager.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @brief Number of failed checks.
+ */
+static int Failures = 0;
+
+/**
+ * @brief Reads a whole file.
+ *
+ * @param Path Name of the file.
+ * @return Content of the file, empty if it cannot be read.
+ */
+static std::string ReadFile(const std::string &Path)
+{
+    std::ifstream In(Path, std::ios::binary);
+    std::ostringstream Content;
+    Content << In.rdbuf();
+    return Content.str();
+}
+
+/**
+ * @brief Checks that a text holds, or does not hold, a snippet.
+ *
+ * @param Step Name of the step.
+ * @param Text Text to search.
+ * @param Snippet Snippet to look for.
+ * @param Expected true if the snippet must be present, false if it must be absent.
+ */
+static void vidCheck(const char *Step, const std::string &Text, const std::string &Snippet, bool Expected)
+{
+    bool Found = (Text.find(Snippet) != std::string::npos);
+    if (Found != Expected)
+    {
+        std::cerr << "FAILED: " << Step << ": \"" << Snippet << "\" " << ((Expected == true) ? "Missing" : "Still There") << std::endl;
+        ++Failures;
+    }
+}
+
+/**
+ * @brief Runs every step and reports the result.
+ *
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main()
+{
+    std::string Directory = (std::filesystem::temp_directory_path() / "taskmanager_test_legacy_fields").string();
+    std::error_code Error;
+    std::filesystem::remove_all(Directory, Error);
+    std::filesystem::create_directories(Directory);
+    std::string Path = Directory + "/tasks.txt";
+    {
+        std::ofstream Out(Path, std::ios::binary);
+        Out << "ID: 1|Title: Legacy|Description: Old file|Due Date: next friday|Priority: urgent|Status: Pending\n"
+            << "ID: 2|Title: Dated|Description: Parsed|Due Date: 2025-07-25|Priority: someday|Status: Pending\n"
+            << "ID: 3|Title: Plain|Description: Parsed|Due Date: 2025-07-25|Priority: High|Status: Done\n";
+    }
+    std::cout.setstate(std::ios::badbit);   /*Keep The Load And Save Messages Quiet*/
+
+    {
+        TaskManager manager;
+        manager.LoadTasksFrom(Path);
+        manager.OpenJournal(Path);
+        manager.setStatus(1, TaskState::Done);
+        manager.Flush();
+    }
+    {
+        TaskManager manager;
+        manager.LoadTasksFrom(Path);
+        manager.OpenJournal(Path);
+        manager.SaveTasksToFile(Path);
+        std::string Saved = ReadFile(Path);
+        vidCheck("Save", Saved, "ID: 1|Title: Legacy|Description: Old file|Due Date: next friday|Priority: urgent|Status: Done", true);
+        vidCheck("Save", Saved, "Due Date: 2025-07-25|Priority: someday|", true);
+        vidCheck("Save", Saved, "Due Date: 2025-07-25|Priority: High|Status: Done", true);
+
+        std::string BinaryPath = Directory + "/tasks.bin";
+        manager.SaveTasksToFile(BinaryPath);
+        if (std::filesystem::exists(BinaryPath, Error) == true && std::filesystem::file_size(BinaryPath, Error) > 0)
+        {
+            std::cerr << "FAILED: Binary Save: Free-Form Fields Were Dropped Into " << BinaryPath << std::endl;
+            ++Failures;
+        }
+
+        manager.setDueDate(1, 20000);
+        manager.setPriority(2, TaskPriority::Low);
+        manager.SaveTasksToFile(Path);
+        Saved = ReadFile(Path);
+        vidCheck("Update", Saved, "next friday", false);
+        vidCheck("Update", Saved, "Priority: urgent|", true);
+        vidCheck("Update", Saved, "someday", false);
+        manager.CloseJournal();
+    }
+
+    std::cout.clear();
+    std::filesystem::remove_all(Directory, Error);
+    std::cout << ((Failures == 0) ? "Free-Form Fields Kept" : "Free-Form Fields Lost") << std::endl;
+    return (Failures == 0) ? 0 : 1;
+}